@@ -2,6 +2,8 @@
 #include "EquipManager.h"
 #include "Engine.h"
 #include "VRInputHandler.h"
+#include "BodyZones.h"
+#include "WeaponRefPool.h"
 #include "config.h"
 #include "skse64/GameReferences.h"
 #include "skse64/GameRTTI.h"
@@ -9,9 +11,6 @@
 
 namespace FalseEdgeVR
 {
-    // Forward declaration from VRInputHandler.cpp
-    bool IsControllerInShoulderZone(bool isLeftVRController);
-    
     // ============================================
     // Globals
     // ============================================
@@ -24,6 +23,20 @@ namespace FalseEdgeVR
     
     // Bypass flag - our code sets this to true before calling activate
     bool g_bypassActivateBlock = false;
+
+    // Holster zones each VR controller is in ([0] = left), kept from body zone events
+    static int s_holsterZoneCount[2] = { 0, 0 };
+
+    static void OnBodyZoneEvent(const BodyZoneEvent& evt)
+    {
+        if (!evt.holster)
+            return;
+
+        int& count = s_holsterZoneCount[evt.isLeftController ? 0 : 1];
+        count += evt.entered ? 1 : -1;
+        if (count < 0)
+            count = 0;
+    }
   
     // ============================================
     // Helper Functions
@@ -71,6 +84,10 @@ outIsLeftController = true;
         PlayerCharacter* player = *g_thePlayer;
  if (!player || activator != player)
     return false;
+
+        // Parked pool refs are proxies for a weapon the player still carries - picking one up duplicates it
+        if (WeaponRefPool::GetSingleton()->IsParked(activatee))
+            return true;
      
    // Only block if the object is grabbed by HIGGS
         if (!IsObjectGrabbedByHiggs(activatee))
@@ -95,12 +112,12 @@ return false;
             }
 
             // ============================================
-            // CHECK SHOULDER ZONE
-            // If controller is in shoulder zone, allow activation (holstering)
+            // CHECK HOLSTER ZONE
+            // If controller is in a holster body zone (shoulders by default), allow activation (holstering)
             // ============================================
-            if (IsControllerInShoulderZone(isLeftVRController))
+            if (s_holsterZoneCount[isLeftVRController ? 0 : 1] > 0)
             {
-                _MESSAGE("ShouldBlockActivation: %s VR controller is in SHOULDER ZONE - allowing activation (holster)",
+                _MESSAGE("ShouldBlockActivation: %s VR controller is in HOLSTER ZONE - allowing activation (holster)",
                     isLeftVRController ? "LEFT" : "RIGHT");
                 return false;  // Don't block - player is holstering
             }
@@ -190,6 +207,9 @@ return false;
     void SetupActivateHook()
     {
         _MESSAGE("SetupActivateHook: Initializing Activate Hook...");
+
+        // Holster zone state comes from enter/exit events instead of polling distances
+        BodyZoneSystem::GetSingleton()->AddListener(OnBodyZoneEvent);
         
         uintptr_t funcAddr = OriginalActivateFunc.GetUIntPtr();
         _MESSAGE("SetupActivateHook: Activate function address: 0x%llX", funcAddr);
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstdint>
+
+namespace FalseEdgeVR
+{
+    // ============================================
+    // Blade profile database format
+    // ============================================
+    // Written offline by tools/NifProfiler from the weapon meshes, one record per
+    // WEAP form (and shield ARMO form). Measurements are in weapon node space
+    // (game units): the grip is the origin and the blade points along +Y, like
+    // the WEAPON/SHIELD nodes. Shared by the tool and the plugin, so only
+    // fixed-width types here.
+    //
+    // File: BladeProfileHeader, bucketCount uint32 seeds, recordCount records,
+    // then the collision meshes: meshCount BladeProfileMesh entries, vertexCount
+    // float[3] positions and triangleCount uint16[3] triangles (indices relative
+    // to the mesh's firstVertex). Records that share a mesh share its entry.
+    // The triangles are zero-padded to a 4-byte boundary. Last, the signed distance fields: sdfCount BladeProfileSdf entries and
+    // sampleCount int16 samples (resolution^3 per field, x fastest).
+    // The seeds make a minimal perfect hash (hash and displace): a key's bucket
+    // is BladeProfileHash(key, 0) % bucketCount, and its record index is
+    // BladeProfileHash(key, seeds[bucket]) % recordCount. Every key in the file
+    // lands on its own record, so a lookup is two hashes and one key compare
+    // (keys that aren't in the file land on some other record and fail the compare).
+    // ============================================
+
+    static const uint32_t kBladeProfileMagic = 0x50424546;   // "FEBP"
+    static const uint32_t kBladeProfileVersion = 5;
+    static const uint32_t kBladeProfileNoMesh = 0xFFFFFFFF;
+
+    enum BladeProfileFlags : uint8_t
+    {
+        kBladeProfile_HasGuard = 1 << 0,     // A crossguard was found - bladeStart is above it
+        kBladeProfile_HasHead = 1 << 1,      // Mace head / axe bit - headRadius and headCenterY are valid
+        kBladeProfile_LegacyMesh = 1 << 2    // NiTriShape (original Skyrim) mesh rather than BSTriShape
+    };
+
+#pragma pack(push, 4)
+    struct BladeProfileHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t recordCount;
+        uint32_t bucketCount;
+        uint32_t meshCount;
+        uint32_t vertexCount;
+        uint32_t triangleCount;
+        uint32_t sdfCount;
+        uint32_t sampleCount;
+        uint32_t reserved;
+    };
+
+    struct BladeProfileRecord
+    {
+        uint32_t pluginHash;        // BladeProfilePluginHash of the plugin that defines the form
+        uint32_t localFormID;       // FormID without the load order index (0xFFF mask for light plugins)
+        float length;               // Grip to tip along +Y
+        float baseOffset;           // Lowest Y of the mesh (pommel end, usually negative)
+        float bladeStart;           // Y where the blade begins (above the guard)
+        float edgeHalfWidth;        // Median half width along the blade (wider cross-section axis)
+        float halfThickness;        // Median half thickness along the blade (narrower axis)
+        float curvature;            // Largest distance of the blade centreline from the straight base-tip line
+        float headRadius;           // Mace head / axe bit extent from the blade axis, or shield face radius
+        float headCenterY;          // Y of the head's widest slice
+        uint8_t weaponType;         // WeaponType value (Sword = 1 ... Shield = 5)
+        uint8_t flags;              // BladeProfileFlags
+        uint16_t reserved;
+        uint32_t meshIndex;         // Collision mesh, kBladeProfileNoMesh if none
+        uint32_t sdfIndex;          // Signed distance field (shields), kBladeProfileNoMesh if none
+    };
+
+    // Welded mesh geometry in the same node space as the record
+    struct BladeProfileMesh
+    {
+        uint32_t firstVertex;
+        uint32_t vertexCount;
+        uint32_t firstTriangle;
+        uint32_t triangleCount;
+    };
+
+    // Distance to the mesh surface sampled on a cube of resolution^3 grid points:
+    // point (i, j, k) sits at origin + (i, j, k) * voxelSize and stores
+    // distance / distanceScale. The sign comes from the nearest face's normal.
+    struct BladeProfileSdf
+    {
+        float origin[3];
+        float voxelSize;
+        float distanceScale;
+        uint32_t firstSample;
+        uint32_t resolution;
+        uint32_t reserved;
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(BladeProfileHeader) == 40, "BladeProfileHeader layout");
+    static_assert(sizeof(BladeProfileRecord) == 52, "BladeProfileRecord layout");
+    static_assert(sizeof(BladeProfileMesh) == 16, "BladeProfileMesh layout");
+    static_assert(sizeof(BladeProfileSdf) == 32, "BladeProfileSdf layout");
+
+    // Case-insensitive FNV-1a of a plugin file name ("Skyrim.esm")
+    inline uint32_t BladeProfilePluginHash(const char* name)
+    {
+        uint32_t hash = 2166136261u;
+        for (const char* c = name; *c; c++)
+        {
+            char ch = *c;
+            if (ch >= 'A' && ch <= 'Z')
+                ch = (char)(ch - 'A' + 'a');
+            hash ^= (uint8_t)ch;
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    // Section size rounded up so the next section starts 4-byte aligned
+    inline uint64_t BladeProfileAlign4(uint64_t bytes)
+    {
+        return (bytes + 3) & ~(uint64_t)3;
+    }
+
+    inline uint64_t BladeProfileKey(uint32_t pluginHash, uint32_t localFormID)
+    {
+        return ((uint64_t)pluginHash << 32) | localFormID;
+    }
+
+    // 64-bit finalizer (splitmix64) of the key mixed with a seed
+    inline uint32_t BladeProfileHash(uint64_t key, uint32_t seed)
+    {
+        uint64_t h = key ^ ((uint64_t)seed * 0x9E3779B97F4A7C15ull);
+        h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+        h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+        return (uint32_t)(h ^ (h >> 31));
+    }
+}
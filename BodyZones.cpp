@@ -0,0 +1,419 @@
+#include "BodyZones.h"
+#include "config.h"
+#include "common/IDebugLog.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+
+namespace FalseEdgeVR
+{
+    // Node names for VR tracking
+    static const char* kHMDNodeName = "NPC Head [Head]";
+    static const char* kLeftHandNodeName = "NPC L Hand [LHnd]";
+    static const char* kRightHandNodeName = "NPC R Hand [RHnd]";
+
+    // Default shoulder zones (in Skyrim units, ~70 units = 1 meter) - offsets match HIGGS RightShoulderHmdOffsetX/Y/Z
+    static constexpr float kShoulderZoneRadius = 25.0f;
+    static constexpr float kShoulderOffsetX = 17.5f;
+    static constexpr float kShoulderOffsetY = -5.0f;
+    static constexpr float kShoulderOffsetZ = -6.85f;
+
+    BodyZoneSystem* BodyZoneSystem::GetSingleton()
+    {
+        static BodyZoneSystem instance;
+        return &instance;
+    }
+
+    BodyZoneSystem::BodyZoneSystem()
+    {
+        for (int i = 0; i < kMaxListeners; i++)
+        {
+            m_listeners[i] = nullptr;
+        }
+    }
+
+    static bool ParsePoint(const std::string& str, NiPoint3& out)
+    {
+        std::vector<std::string> parts = split(str, ',');
+        if (parts.size() != 3)
+            return false;
+
+        try
+        {
+            out.x = std::stof(parts[0]);
+            out.y = std::stof(parts[1]);
+            out.z = std::stof(parts[2]);
+        }
+        catch (...)
+        {
+            return false;
+        }
+        return true;
+    }
+
+    bool BodyZoneSystem::ParseZone(const std::string& definition, ZoneDef& zone)
+    {
+        std::vector<std::string> fields = split(definition, '|');
+        for (auto& field : fields)
+        {
+            trim(field);
+        }
+
+        if (fields.size() < 6)
+            return false;
+
+        std::string shape = fields[1];
+        std::transform(shape.begin(), shape.end(), shape.begin(), ::tolower);
+
+        size_t radiusField;
+        if (shape == "sphere" && fields.size() == 6)
+        {
+            zone.shape = BodyZoneShape::Sphere;
+            if (!ParsePoint(fields[3], zone.localA))
+                return false;
+            zone.localB = zone.localA;
+            radiusField = 4;
+        }
+        else if (shape == "capsule" && fields.size() == 7)
+        {
+            zone.shape = BodyZoneShape::Capsule;
+            if (!ParsePoint(fields[3], zone.localA) || !ParsePoint(fields[4], zone.localB))
+                return false;
+            radiusField = 5;
+        }
+        else
+        {
+            return false;
+        }
+
+        try
+        {
+            zone.radius = std::stof(fields[radiusField]);
+            zone.holster = (std::stoi(fields[radiusField + 1]) != 0);
+        }
+        catch (...)
+        {
+            return false;
+        }
+
+        if (fields[0].empty() || fields[2].empty() || zone.radius <= 0.0f)
+            return false;
+
+        zone.name = fields[0];
+        zone.anchor = AddAnchor(fields[2]);
+        return zone.anchor >= 0;
+    }
+
+    int BodyZoneSystem::AddAnchor(const std::string& nodeName)
+    {
+        std::string resolved = (_stricmp(nodeName.c_str(), "HMD") == 0) ? kHMDNodeName : nodeName;
+
+        for (int i = 0; i < m_anchorCount; i++)
+        {
+            if (m_anchorNodes[i] == resolved)
+                return i;
+        }
+
+        if (m_anchorCount >= kMaxAnchors)
+        {
+            _MESSAGE("BodyZones: Too many anchor nodes (max %d) - ignoring '%s'", kMaxAnchors, resolved.c_str());
+            return -1;
+        }
+
+        m_anchorNodes[m_anchorCount] = resolved;
+        return m_anchorCount++;
+    }
+
+    void BodyZoneSystem::AddZone(const ZoneDef& zone)
+    {
+        if (m_zoneCount >= kMaxZones)
+        {
+            _MESSAGE("BodyZones: Too many zones (max %d) - ignoring '%s'", kMaxZones, zone.name.c_str());
+            return;
+        }
+
+        int i = m_zoneCount++;
+        m_zones[i] = zone;
+
+        m_anchorOf[i] = zone.anchor;
+        m_localAX[i] = zone.localA.x;
+        m_localAY[i] = zone.localA.y;
+        m_localAZ[i] = zone.localA.z;
+        m_localBX[i] = zone.localB.x;
+        m_localBY[i] = zone.localB.y;
+        m_localBZ[i] = zone.localB.z;
+        m_worldAX[i] = m_worldAY[i] = m_worldAZ[i] = 0.0f;
+        m_segX[i] = m_segY[i] = m_segZ[i] = 0.0f;
+
+        float exitRadius = zone.radius + (bodyZoneExitMargin > 0.0f ? bodyZoneExitMargin : 0.0f);
+        m_enterSq[i] = zone.radius * zone.radius;
+        m_exitSq[i] = exitRadius * exitRadius;
+
+        if (zone.holster)
+            m_holsterMask |= (1u << i);
+    }
+
+    void BodyZoneSystem::LoadZones()
+    {
+        // Leave the old zones first so listeners see matching exits
+        Clear();
+
+        m_zoneCount = 0;
+        m_anchorCount = 0;
+        m_holsterMask = 0;
+
+        for (const std::string& definition : bodyZoneDefinitions)
+        {
+            ZoneDef zone;
+            if (ParseZone(definition, zone))
+            {
+                AddZone(zone);
+            }
+            else
+            {
+                _MESSAGE("BodyZones: Invalid zone definition '%s' - ignored", definition.c_str());
+            }
+        }
+
+        if (m_zoneCount == 0)
+        {
+            // No (valid) Zone lines - the two HIGGS shoulder spheres
+            ZoneDef left;
+            left.name = "LeftShoulder";
+            left.anchor = AddAnchor("HMD");
+            left.localA = NiPoint3(-kShoulderOffsetX, kShoulderOffsetY, kShoulderOffsetZ);
+            left.localB = left.localA;
+            left.radius = kShoulderZoneRadius;
+            left.holster = true;
+            AddZone(left);
+
+            ZoneDef right = left;
+            right.name = "RightShoulder";
+            right.localA = NiPoint3(kShoulderOffsetX, kShoulderOffsetY, kShoulderOffsetZ);
+            right.localB = right.localA;
+            AddZone(right);
+        }
+
+        // Capsule segments are fixed in anchor space
+        for (int i = 0; i < m_zoneCount; i++)
+        {
+            float sx = m_localBX[i] - m_localAX[i];
+            float sy = m_localBY[i] - m_localAY[i];
+            float sz = m_localBZ[i] - m_localAZ[i];
+            float lenSq = sx * sx + sy * sy + sz * sz;
+            m_invSegLenSq[i] = lenSq > 0.0001f ? 1.0f / lenSq : 0.0f;
+        }
+
+        _MESSAGE("BodyZones: %d zone(s) on %d anchor node(s), exit margin %.1f", m_zoneCount, m_anchorCount, bodyZoneExitMargin);
+        for (int i = 0; i < m_zoneCount; i++)
+        {
+            const ZoneDef& zone = m_zones[i];
+            _MESSAGE("BodyZones:   %-14s %s on '%s' radius %.1f%s", zone.name.c_str(),
+                zone.shape == BodyZoneShape::Capsule ? "capsule" : "sphere ",
+                m_anchorNodes[zone.anchor].c_str(), zone.radius, zone.holster ? " (holster)" : "");
+        }
+    }
+
+    void BodyZoneSystem::AddListener(BodyZoneListener listener)
+    {
+        if (!listener || m_listenerCount >= kMaxListeners)
+            return;
+
+        for (int i = 0; i < m_listenerCount; i++)
+        {
+            if (m_listeners[i] == listener)
+                return;
+        }
+        m_listeners[m_listenerCount++] = listener;
+    }
+
+    bool BodyZoneSystem::Update()
+    {
+        PlayerCharacter* player = *g_thePlayer;
+        NiNode* rootNode = player ? player->GetNiNode() : nullptr;
+        if (player && !rootNode)
+            rootNode = player->GetNiRootNode(1);
+
+        NiAVObject* anchors[kMaxAnchors] = {};
+        if (rootNode)
+        {
+            for (int k = 0; k < m_anchorCount; k++)
+            {
+                BSFixedString nodeStr(m_anchorNodes[k].c_str());
+                anchors[k] = rootNode->GetObjectByName(&nodeStr.data);
+            }
+        }
+
+        // Without any anchor node (skeleton not loaded) nothing is tested this step
+        m_valid = false;
+        for (int k = 0; k < m_anchorCount; k++)
+        {
+            if (anchors[k])
+                m_valid = true;
+        }
+        if (!m_valid)
+            return false;
+
+        BSFixedString leftHandStr(kLeftHandNodeName);
+        BSFixedString rightHandStr(kRightHandNodeName);
+        NiAVObject* hands[2] = {
+            rootNode->GetObjectByName(&leftHandStr.data),
+            rootNode->GetObjectByName(&rightHandStr.data)
+        };
+
+        // 1) Zones into world space - one pass, anchor transforms looked up by index
+        UInt32 anchorMissing = 0;
+        for (int i = 0; i < m_zoneCount; i++)
+        {
+            NiAVObject* anchor = anchors[m_anchorOf[i]];
+            if (!anchor)
+            {
+                anchorMissing |= (1u << i);
+                continue;
+            }
+
+            const NiPoint3& pos = anchor->m_worldTransform.pos;
+            const NiMatrix33& rot = anchor->m_worldTransform.rot;
+
+            float ax = pos.x + rot.data[0][0] * m_localAX[i] + rot.data[0][1] * m_localAY[i] + rot.data[0][2] * m_localAZ[i];
+            float ay = pos.y + rot.data[1][0] * m_localAX[i] + rot.data[1][1] * m_localAY[i] + rot.data[1][2] * m_localAZ[i];
+            float az = pos.z + rot.data[2][0] * m_localAX[i] + rot.data[2][1] * m_localAY[i] + rot.data[2][2] * m_localAZ[i];
+            float bx = pos.x + rot.data[0][0] * m_localBX[i] + rot.data[0][1] * m_localBY[i] + rot.data[0][2] * m_localBZ[i];
+            float by = pos.y + rot.data[1][0] * m_localBX[i] + rot.data[1][1] * m_localBY[i] + rot.data[1][2] * m_localBZ[i];
+            float bz = pos.z + rot.data[2][0] * m_localBX[i] + rot.data[2][1] * m_localBY[i] + rot.data[2][2] * m_localBZ[i];
+
+            m_worldAX[i] = ax;
+            m_worldAY[i] = ay;
+            m_worldAZ[i] = az;
+            m_segX[i] = bx - ax;
+            m_segY[i] = by - ay;
+            m_segZ[i] = bz - az;
+        }
+
+        // 2) Both controllers against every zone - spheres are capsules with a zero segment
+        for (int c = 0; c < 2; c++)
+        {
+            float distSq[kMaxZones];
+            UInt32 newMask = 0;
+
+            if (hands[c])
+            {
+                const NiPoint3 p = hands[c]->m_worldTransform.pos;
+                UInt32 wasInside = m_inside[c];
+
+                for (int i = 0; i < m_zoneCount; i++)
+                {
+                    float px = p.x - m_worldAX[i];
+                    float py = p.y - m_worldAY[i];
+                    float pz = p.z - m_worldAZ[i];
+
+                    float t = (px * m_segX[i] + py * m_segY[i] + pz * m_segZ[i]) * m_invSegLenSq[i];
+                    t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+
+                    float dx = px - m_segX[i] * t;
+                    float dy = py - m_segY[i] * t;
+                    float dz = pz - m_segZ[i] * t;
+                    distSq[i] = dx * dx + dy * dy + dz * dz;
+
+                    // Hysteresis: already inside -> stay until the exit radius
+                    float limitSq = (wasInside & (1u << i)) ? m_exitSq[i] : m_enterSq[i];
+                    newMask |= (UInt32)(distSq[i] <= limitSq) << i;
+                }
+
+                newMask &= ~anchorMissing;
+            }
+            else
+            {
+                // No hand node - the controller leaves every zone
+                for (int i = 0; i < m_zoneCount; i++)
+                {
+                    distSq[i] = 0.0f;
+                }
+            }
+
+            if (newMask != m_inside[c])
+                Dispatch(c, newMask, distSq);
+        }
+
+        return true;
+    }
+
+    void BodyZoneSystem::Dispatch(int controller, UInt32 newMask, const float* distSq)
+    {
+        UInt32 changed = newMask ^ m_inside[controller];
+        m_inside[controller] = newMask;
+
+        for (int i = 0; i < m_zoneCount; i++)
+        {
+            if (!(changed & (1u << i)))
+                continue;
+
+            BodyZoneEvent evt;
+            evt.zone = i;
+            evt.name = m_zones[i].name.c_str();
+            evt.isLeftController = (controller == 0);
+            evt.entered = (newMask & (1u << i)) != 0;
+            evt.holster = m_zones[i].holster;
+            evt.distance = distSq ? std::sqrt(distSq[i]) : 0.0f;
+
+            if (evt.entered)
+            {
+                _MESSAGE("BodyZones: %s controller ENTERED %s zone (dist: %.1f)",
+                    evt.isLeftController ? "LEFT" : "RIGHT", evt.name, evt.distance);
+            }
+            else
+            {
+                _MESSAGE("BodyZones: %s controller EXITED %s zone",
+                    evt.isLeftController ? "LEFT" : "RIGHT", evt.name);
+            }
+
+            for (int l = 0; l < m_listenerCount; l++)
+            {
+                m_listeners[l](evt);
+            }
+        }
+    }
+
+    bool BodyZoneSystem::IsInZone(int zone, bool isLeftVRController) const
+    {
+        if (zone < 0 || zone >= m_zoneCount)
+            return false;
+        return (m_inside[isLeftVRController ? 0 : 1] & (1u << zone)) != 0;
+    }
+
+    bool BodyZoneSystem::IsInHolsterZone(bool isLeftVRController) const
+    {
+        return (m_inside[isLeftVRController ? 0 : 1] & m_holsterMask) != 0;
+    }
+
+    const char* BodyZoneSystem::GetHolsterZoneName(bool isLeftVRController) const
+    {
+        UInt32 mask = m_inside[isLeftVRController ? 0 : 1] & m_holsterMask;
+        for (int i = 0; i < m_zoneCount; i++)
+        {
+            if (mask & (1u << i))
+                return m_zones[i].name.c_str();
+        }
+        return "NONE";
+    }
+
+    int BodyZoneSystem::FindZone(const char* name) const
+    {
+        for (int i = 0; i < m_zoneCount; i++)
+        {
+            if (_stricmp(m_zones[i].name.c_str(), name) == 0)
+                return i;
+        }
+        return -1;
+    }
+
+    void BodyZoneSystem::Clear()
+    {
+        for (int c = 0; c < 2; c++)
+        {
+            if (m_inside[c] != 0)
+                Dispatch(c, 0, nullptr);
+        }
+        m_valid = false;
+    }
+}
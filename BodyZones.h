@@ -0,0 +1,129 @@
+#pragma once
+
+#include "skse64/GameReferences.h"
+#include "skse64/NiTypes.h"
+#include <string>
+#include <vector>
+
+namespace FalseEdgeVR
+{
+    // ============================================
+    // BodyZoneSystem
+    // ============================================
+    // Spheres and capsules attached to the HMD or to skeleton nodes (shoulders,
+    // hips, back, chest...) that the VR controllers can reach into. Replaces the
+    // two hard-coded shoulder spheres.
+    // Zones come from [BodyZones] Zone lines in the INI (defaults: the two HIGGS
+    // shoulder spheres). Update() transforms every zone into world space and tests
+    // both controllers against all of them in one pass over structure-of-arrays
+    // data. A controller enters a zone at its radius and leaves at radius +
+    // ExitMargin, so it doesn't flicker on the boundary.
+    // Transitions are logged and sent to the listeners as enter/exit events -
+    // consumers keep their own state from those instead of polling distances.
+    // Game thread only.
+    // ============================================
+
+    enum class BodyZoneShape
+    {
+        Sphere,
+        Capsule
+    };
+
+    struct BodyZoneEvent
+    {
+        int zone;                   // Index into the zone list
+        const char* name;           // Zone name from the INI
+        bool isLeftController;      // VR controller (not game hand)
+        bool entered;               // false = exited
+        bool holster;               // Zone allows holstering a grabbed weapon
+        float distance;             // Distance from the zone centre (capsule axis) at the transition
+    };
+
+    typedef void (*BodyZoneListener)(const BodyZoneEvent& evt);
+
+    class BodyZoneSystem
+    {
+    public:
+        static BodyZoneSystem* GetSingleton();
+
+        // (Re)build the zone list from the [BodyZones] config - call after loadConfig
+        void LoadZones();
+
+        // Transform and test all zones; returns false if the skeleton isn't available
+        bool Update();
+
+        // Last Update found the skeleton
+        bool IsValid() const { return m_valid; }
+
+        // Called for every enter/exit transition, in zone order
+        void AddListener(BodyZoneListener listener);
+
+        bool IsInZone(int zone, bool isLeftVRController) const;
+
+        // Controller is inside any zone flagged as holster
+        bool IsInHolsterZone(bool isLeftVRController) const;
+
+        // Name of the first holster zone the controller is in ("NONE" if none) - for logs
+        const char* GetHolsterZoneName(bool isLeftVRController) const;
+
+        // Zone index by name (-1 if not defined)
+        int FindZone(const char* name) const;
+
+        int GetZoneCount() const { return m_zoneCount; }
+
+        // Leave every zone (sends exit events) - game load
+        void Clear();
+
+    private:
+        BodyZoneSystem();
+        ~BodyZoneSystem() = default;
+        BodyZoneSystem(const BodyZoneSystem&) = delete;
+        BodyZoneSystem& operator=(const BodyZoneSystem&) = delete;
+
+        static const int kMaxZones = 32;          // Fits the per-controller inside mask
+        static const int kMaxAnchors = 8;
+        static const int kMaxListeners = 4;
+
+        struct ZoneDef
+        {
+            std::string name;
+            BodyZoneShape shape = BodyZoneShape::Sphere;
+            int anchor = 0;
+            NiPoint3 localA;
+            NiPoint3 localB;                      // Capsule end (== localA for spheres)
+            float radius = 0.0f;
+            bool holster = false;
+        };
+
+        // Parse "Name | sphere | Anchor | x,y,z | radius | holster" or
+        // "Name | capsule | Anchor | x,y,z | x,y,z | radius | holster"
+        bool ParseZone(const std::string& definition, ZoneDef& zone);
+        int AddAnchor(const std::string& nodeName);
+        void AddZone(const ZoneDef& zone);
+
+        // Send enter/exit events for the controller's changed bits
+        void Dispatch(int controller, UInt32 newMask, const float* distSq);
+
+        ZoneDef m_zones[kMaxZones];
+        int m_zoneCount = 0;
+        std::string m_anchorNodes[kMaxAnchors];   // Skeleton node names ("HMD" = head node)
+        int m_anchorCount = 0;
+
+        // Per-zone data for the batched test - local points set on load, world points each Update
+        int m_anchorOf[kMaxZones];
+        float m_localAX[kMaxZones], m_localAY[kMaxZones], m_localAZ[kMaxZones];
+        float m_localBX[kMaxZones], m_localBY[kMaxZones], m_localBZ[kMaxZones];
+        float m_worldAX[kMaxZones], m_worldAY[kMaxZones], m_worldAZ[kMaxZones];
+        float m_segX[kMaxZones], m_segY[kMaxZones], m_segZ[kMaxZones];
+        float m_invSegLenSq[kMaxZones];           // 0 for spheres
+        float m_enterSq[kMaxZones];
+        float m_exitSq[kMaxZones];
+        UInt32 m_holsterMask = 0;
+
+        UInt32 m_inside[2] = { 0, 0 };             // [0] = left controller, [1] = right
+        bool m_valid = false;
+
+        BodyZoneListener m_listeners[kMaxListeners];
+        int m_listenerCount = 0;
+    };
+}
@@ -0,0 +1,353 @@
+#include "CollisionWorld.h"
+#include "WeaponGeometry.h"
+#include "ShieldCollision.h"
+#include "EquipManager.h"
+#include "Engine.h"
+#include "common/IDebugLog.h"
+#include <chrono>
+
+namespace FalseEdgeVR
+{
+    static const char* ShapeName(ColliderShape shape)
+    {
+        switch (shape)
+        {
+        case ColliderShape::BladeCapsule: return "Blade";
+        case ColliderShape::ShieldDisc: return "Shield";
+        default: return "None";
+        }
+    }
+
+    CollisionWorld* CollisionWorld::GetSingleton()
+    {
+        static CollisionWorld instance;
+        return &instance;
+    }
+
+    CollisionWorld::CollisionWorld()
+    {
+        for (int a = 0; a < kShapeCount; a++)
+        {
+            for (int b = 0; b < kShapeCount; b++)
+                m_dispatch[a][b] = nullptr;
+        }
+
+        // Lower shape first - UpdatePair swaps the slots for the mirrored entry.
+        // Shield vs shield has no entry: nothing reacts to it.
+        m_dispatch[(int)ColliderShape::BladeCapsule][(int)ColliderShape::BladeCapsule] = &CollisionWorld::TestBladeBlade;
+        m_dispatch[(int)ColliderShape::BladeCapsule][(int)ColliderShape::ShieldDisc] = &CollisionWorld::TestBladeShield;
+    }
+
+    void CollisionWorld::Update(float deltaTime)
+    {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        m_time += deltaTime;
+
+        // Hands, then every tracker's geometry, then colliders - pair tests only see this step's positions
+        bool handsChanged = ResolveHands();
+
+        WeaponGeometryTracker* blades = WeaponGeometryTracker::GetSingleton();
+        ShieldCollisionTracker* shields = ShieldCollisionTracker::GetSingleton();
+        blades->UpdateGeometry(deltaTime, m_hands);
+        shields->UpdateGeometry(deltaTime, m_hands, handsChanged);
+
+        BuildColliders();
+
+        for (int a = 0; a < kSlotCount; a++)
+        {
+            for (int b = a + 1; b < kSlotCount; b++)
+                UpdatePair((ColliderSlot)a, (ColliderSlot)b);
+        }
+
+        shields->FinishUpdate();
+
+        m_stepUs += std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - startTime).count();
+
+        // Step cost and event rate every 900 steps (~10s at 90Hz)
+        if (++m_stepCount >= 900)
+        {
+            _MESSAGE("CollisionWorld: avg %.1fus per step over %d steps - %d pair tests, %d events, %d contacts held through a gap",
+                m_stepUs / m_stepCount, m_stepCount, m_pairTests, m_eventCount, m_suppressedEnds);
+            m_stepCount = 0;
+            m_pairTests = 0;
+            m_eventCount = 0;
+            m_suppressedEnds = 0;
+            m_stepUs = 0.0;
+        }
+    }
+
+    bool CollisionWorld::ResolveHands()
+    {
+        EquipManager* equipManager = EquipManager::GetSingleton();
+
+        // Equipped forms only change with an equip event
+        UInt32 equipGeneration = equipManager->GetEquipGeneration();
+        bool handsChanged = (!m_handsResolved || equipGeneration != m_equipGeneration);
+        if (handsChanged)
+        {
+            m_equipGeneration = equipGeneration;
+            m_handsResolved = true;
+
+            for (int slot = 0; slot < kSlotCount; slot++)
+            {
+                CollisionHand& hand = m_hands[slot];
+                hand.equipped = equipManager->GetEquippedObject(slot == kSlotLeftHand);
+                hand.isShield = hand.equipped && EquipManager::IsShield(hand.equipped);
+                hand.isWeapon = hand.equipped && EquipManager::IsWeapon(hand.equipped);
+                hand.weaponFormID = (hand.equipped && !hand.isShield) ? hand.equipped->formID : 0;
+            }
+
+            // If we detect a mismatch between direct check and EquipManager, force update
+            const PlayerEquipState& equipState = equipManager->GetEquipState();
+            bool equipManagerKnowsShield = (equipState.leftHand.type == WeaponType::Shield) ||
+                (equipState.rightHand.type == WeaponType::Shield);
+            if ((m_hands[kSlotLeftHand].isShield || m_hands[kSlotRightHand].isShield) && !equipManagerKnowsShield)
+            {
+                _MESSAGE("CollisionWorld: EquipManager mismatch - forcing UpdateEquipmentState");
+                equipManager->UpdateEquipmentState();
+            }
+        }
+
+        // Our dropped weapon counts once HIGGS actually holds it - that can change any step
+        for (int slot = 0; slot < kSlotCount; slot++)
+        {
+            bool isLeft = (slot == kSlotLeftHand);
+            CollisionHand& hand = m_hands[slot];
+            hand.grabbedRef = nullptr;
+
+            if (!equipManager->HasPendingReequip(isLeft))
+                continue;
+
+            TESObjectREFR* droppedRef = equipManager->GetDroppedWeaponRef(isLeft);
+            if (droppedRef && higgsInterface && higgsInterface->GetGrabbedObject(GameHandToVRController(isLeft)) == droppedRef)
+                hand.grabbedRef = droppedRef;
+        }
+
+        return handsChanged;
+    }
+
+    void CollisionWorld::BuildColliders()
+    {
+        const WeaponGeometryTracker* blades = WeaponGeometryTracker::GetSingleton();
+        const ShieldCollisionTracker* shields = ShieldCollisionTracker::GetSingleton();
+
+        for (int slot = 0; slot < kSlotCount; slot++)
+        {
+            bool isLeft = (slot == kSlotLeftHand);
+            const CollisionHand& hand = m_hands[slot];
+            Collider& collider = m_colliders[slot];
+            collider = Collider();
+            collider.slot = (ColliderSlot)slot;
+
+            if (shields->HasShieldEquipped() && shields->IsShieldInLeftHand() == isLeft)
+            {
+                const ShieldGeometry& shield = shields->GetShieldGeometry(isLeft);
+                if (shield.isValid)
+                {
+                    collider.shape = ColliderShape::ShieldDisc;
+                    collider.shield = &shield;
+                    collider.formID = hand.equipped ? hand.equipped->formID : 0;
+                }
+                continue;
+            }
+
+            const BladeGeometry& blade = blades->GetBladeGeometry(isLeft);
+            if (blade.isValid)
+            {
+                collider.shape = ColliderShape::BladeCapsule;
+                collider.blade = &blade;
+                collider.formID = blade.formID;
+                collider.grabbed = (hand.grabbedRef != nullptr);
+            }
+        }
+    }
+
+    void CollisionWorld::UpdatePair(ColliderSlot slotA, ColliderSlot slotB)
+    {
+        const Collider& colliderA = m_colliders[slotA];
+        const Collider& colliderB = m_colliders[slotB];
+
+        // Matrix entries take their shapes in order - try the mirrored entry with the slots swapped
+        ColliderSlot first = slotA;
+        ColliderSlot second = slotB;
+        PairTest test = m_dispatch[(int)colliderA.shape][(int)colliderB.shape];
+        if (!test)
+        {
+            test = m_dispatch[(int)colliderB.shape][(int)colliderA.shape];
+            first = slotB;
+            second = slotA;
+        }
+        if (!test)
+        {
+            EndPair(slotA, slotB);
+            return;
+        }
+
+        PairContact contact;
+        (this->*test)(first, second, contact);
+        m_pairTests++;
+        if (!contact.tested)
+        {
+            EndPair(slotA, slotB);
+            return;
+        }
+
+        PairState& state = m_pairs[slotA][slotB];
+        state.first = first;
+        state.second = second;
+        state.shapeFirst = m_colliders[first].shape;
+        state.shapeSecond = m_colliders[second].shape;
+        state.lastPoint = contact.point;
+        state.lastDistance = contact.distance;
+
+        if (contact.colliding)
+        {
+            if (!state.touching)
+            {
+                state.touching = true;
+                state.contactStart = m_time;
+                Emit(CollisionEventType::ContactBegin, state, contact.distance, contact.relativeSpeed);
+            }
+            else if (state.checksApart > 0)
+            {
+                // Touching again inside the release window - same contact
+                m_suppressedEnds++;
+            }
+            state.checksApart = 0;
+        }
+        else if (state.touching && ++state.checksApart >= kContactReleaseChecks)
+        {
+            Emit(CollisionEventType::ContactEnd, state, contact.distance, contact.relativeSpeed);
+            state.touching = false;
+            state.checksApart = 0;
+        }
+
+        // Imminence only means something while the pair isn't already in contact
+        bool imminent = contact.imminent && !state.touching;
+        if (imminent && !state.imminent)
+            Emit(CollisionEventType::ImminentBegin, state, contact.distance, contact.relativeSpeed);
+        state.imminent = imminent;
+    }
+
+    void CollisionWorld::EndPair(ColliderSlot slotA, ColliderSlot slotB)
+    {
+        // The pair stopped existing (unequipped, shield swapped in, geometry lost) - close an open contact
+        PairState& state = m_pairs[slotA][slotB];
+        if (state.touching)
+            Emit(CollisionEventType::ContactEnd, state, state.lastDistance, 0.0f);
+        state = PairState();
+    }
+
+    void CollisionWorld::Emit(CollisionEventType type, const PairState& state, float distance, float relativeSpeed)
+    {
+        CollisionEvent event;
+        event.type = type;
+        event.shapeA = state.shapeFirst;
+        event.shapeB = state.shapeSecond;
+        event.slotA = state.first;
+        event.slotB = state.second;
+        event.distance = distance;
+        event.relativeSpeed = relativeSpeed;
+        event.contactDuration = (type == CollisionEventType::ContactEnd) ? m_time - state.contactStart : 0.0f;
+        event.point = state.lastPoint;
+        m_eventCount++;
+
+        if (type != CollisionEventType::ImminentBegin)
+        {
+            LOG("CollisionWorld: %s %s/%s (%s hand vs %s hand, dist %.2f, %.2fs)",
+                type == CollisionEventType::ContactBegin ? "Contact begin" : "Contact end",
+                ShapeName(event.shapeA), ShapeName(event.shapeB),
+                event.slotA == kSlotLeftHand ? "left" : "right", event.slotB == kSlotLeftHand ? "left" : "right",
+                distance, event.contactDuration);
+        }
+
+        for (CollisionEventCallback listener : m_listeners)
+        {
+            if (listener)
+                listener(event);
+        }
+    }
+
+    void CollisionWorld::TestBladeBlade(ColliderSlot slotA, ColliderSlot slotB, PairContact& outContact)
+    {
+        // Not tested if the colliders aren't a left/right blade pair the tracker has usable geometry for
+        BladeCollisionResult result;
+        if (!WeaponGeometryTracker::GetSingleton()->ProcessBladePair(m_colliders[slotA], m_colliders[slotB], result))
+            return;
+
+        outContact.tested = true;
+        outContact.colliding = result.isColliding;
+        outContact.imminent = result.isImminent;
+        outContact.distance = result.closestDistance;
+        outContact.relativeSpeed = result.relativeVelocity;
+        outContact.point = result.collisionPoint;
+    }
+
+    void CollisionWorld::TestBladeShield(ColliderSlot bladeSlot, ColliderSlot shieldSlot, PairContact& outContact)
+    {
+        // Not tested if the blade isn't in the shield's weapon hand or that hand holds no weapon
+        ShieldCollisionResult result;
+        if (!ShieldCollisionTracker::GetSingleton()->ProcessWeaponPair(m_colliders[bladeSlot], m_colliders[shieldSlot], result))
+            return;
+
+        outContact.tested = true;
+        outContact.colliding = result.isColliding;
+        outContact.imminent = result.isImminent;
+        outContact.distance = result.closestDistance;
+        outContact.relativeSpeed = result.relativeVelocity;
+        outContact.point = result.collisionPoint;
+    }
+
+    void CollisionWorld::ResetGeometry()
+    {
+        WeaponGeometryTracker::GetSingleton()->ResetGeometry();
+        ShieldCollisionTracker::GetSingleton()->ResetGeometry();
+
+        // Re-resolve the hands on wake - equip events can be missed while dormant
+        m_handsResolved = false;
+
+        // Contacts end silently - nothing was touching while tracking was dormant
+        for (int a = 0; a < kSlotCount; a++)
+        {
+            m_colliders[a] = Collider();
+            for (int b = 0; b < kSlotCount; b++)
+                m_pairs[a][b] = PairState();
+        }
+    }
+
+    bool CollisionWorld::AddListener(CollisionEventCallback callback)
+    {
+        for (CollisionEventCallback& listener : m_listeners)
+        {
+            if (listener == callback)
+                return true;
+        }
+        for (CollisionEventCallback& listener : m_listeners)
+        {
+            if (!listener)
+            {
+                listener = callback;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void CollisionWorld::RemoveListener(CollisionEventCallback callback)
+    {
+        for (CollisionEventCallback& listener : m_listeners)
+        {
+            if (listener == callback)
+                listener = nullptr;
+        }
+    }
+
+    // ============================================
+    // Convenience Functions
+    // ============================================
+
+    void UpdateCollisionWorld(float deltaTime)
+    {
+        CollisionWorld::GetSingleton()->Update(deltaTime);
+    }
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "skse64/GameForms.h"
+#include "skse64/GameReferences.h"
+#include "skse64/NiTypes.h"
+
+namespace FalseEdgeVR
+{
+    struct BladeGeometry;
+    struct ShieldGeometry;
+
+    enum ColliderSlot
+    {
+        kSlotLeftHand = 0,
+        kSlotRightHand,
+        kSlotCount
+    };
+
+    // What a hand holds, resolved once per step for every tracker
+    struct CollisionHand
+    {
+        TESForm* equipped = nullptr;
+        bool isShield = false;
+        bool isWeapon = false;
+        UInt32 weaponFormID = 0;                // Equipped non-shield form, 0 if none
+        TESObjectREFR* grabbedRef = nullptr;    // Our dropped weapon while HIGGS holds it in this hand
+    };
+
+    enum class ColliderShape : UInt8
+    {
+        None = 0,
+        BladeCapsule,           // Blade segment (+ convex head / mesh inside the blade kernel)
+        ShieldDisc,             // Shield face disc, or its distance field when the profile has one
+        Count
+    };
+
+    struct Collider
+    {
+        ColliderShape shape = ColliderShape::None;
+        ColliderSlot slot = kSlotLeftHand;
+        bool grabbed = false;                   // HIGGS holds our dropped weapon in this hand
+        UInt32 formID = 0;
+        const BladeGeometry* blade = nullptr;   // BladeCapsule
+        const ShieldGeometry* shield = nullptr; // ShieldDisc
+    };
+
+    enum class CollisionEventType : UInt8
+    {
+        ContactBegin,
+        ContactEnd,
+        ImminentBegin
+    };
+
+    struct CollisionEvent
+    {
+        CollisionEventType type;
+        ColliderShape shapeA;
+        ColliderShape shapeB;
+        ColliderSlot slotA;
+        ColliderSlot slotB;
+        float distance;
+        float relativeSpeed;
+        float contactDuration;                  // ContactEnd: seconds the contact lasted
+        NiPoint3 point;
+    };
+
+    typedef void (*CollisionEventCallback)(const CollisionEvent& event);
+
+    // ============================================
+    // CollisionWorld
+    // ============================================
+    // One collision pass per physics step for everything the player holds.
+    // The step runs in phases so no test depends on which tracker updated first:
+    //   1. Hands - equipped forms (on an EquipManager generation change) and
+    //      HIGGS-held dropped weapons, resolved once and handed to the trackers
+    //   2. Geometry - WeaponGeometryTracker blades, ShieldCollisionTracker shields
+    //   3. Colliders - one per slot from that geometry
+    //   4. Pairs - every slot pair through the shape dispatch matrix; the
+    //      trackers keep their pair tests and reactions (avoidance, blocking)
+    // Each pair keeps its own hysteresis: contact starts on the first touching
+    // check and only ends after kContactReleaseChecks checks apart, so one
+    // noisy frame doesn't split a contact into two events. Listeners get typed
+    // events from that state. Game thread only.
+    // ============================================
+
+    class CollisionWorld
+    {
+    public:
+        static CollisionWorld* GetSingleton();
+
+        // Run one step (the Collision rate group)
+        void Update(float deltaTime);
+
+        // Forget all positions and pair state (tracking went dormant)
+        void ResetGeometry();
+
+        const CollisionHand& GetHand(bool isLeftHand) const { return m_hands[isLeftHand ? kSlotLeftHand : kSlotRightHand]; }
+        const Collider& GetCollider(ColliderSlot slot) const { return m_colliders[slot]; }
+
+        // Typed contact events - false if every listener slot is taken
+        bool AddListener(CollisionEventCallback callback);
+        void RemoveListener(CollisionEventCallback callback);
+
+    private:
+        CollisionWorld();
+        ~CollisionWorld() = default;
+        CollisionWorld(const CollisionWorld&) = delete;
+        CollisionWorld& operator=(const CollisionWorld&) = delete;
+
+        static const int kMaxListeners = 4;
+        static const int kContactReleaseChecks = 3;
+        static const int kShapeCount = (int)ColliderShape::Count;
+
+        // What a pair test reports back for the pair's hysteresis and events
+        struct PairContact
+        {
+            bool tested = false;                // False if the test couldn't run (geometry not usable)
+            bool colliding = false;
+            bool imminent = false;
+            float distance = 0.0f;
+            float relativeSpeed = 0.0f;
+            NiPoint3 point;
+        };
+
+        struct PairState
+        {
+            ColliderSlot first = kSlotLeftHand;         // Slots and shapes in dispatch order, for events
+            ColliderSlot second = kSlotRightHand;
+            ColliderShape shapeFirst = ColliderShape::None;
+            ColliderShape shapeSecond = ColliderShape::None;
+            bool touching = false;
+            bool imminent = false;
+            int checksApart = 0;
+            float contactStart = 0.0f;
+            NiPoint3 lastPoint;
+            float lastDistance = 0.0f;
+        };
+
+        typedef void (CollisionWorld::*PairTest)(ColliderSlot slotA, ColliderSlot slotB, PairContact& outContact);
+
+        // True if the equipped forms were re-read this step - every tracker keys its equip-time work off this
+        bool ResolveHands();
+        void BuildColliders();
+        void UpdatePair(ColliderSlot slotA, ColliderSlot slotB);
+        void EndPair(ColliderSlot slotA, ColliderSlot slotB);
+        void Emit(CollisionEventType type, const PairState& state, float distance, float relativeSpeed);
+
+        // Pair tests (dispatch matrix entries) - slotA holds the first shape of the entry, both slots' colliders go to the tracker
+        void TestBladeBlade(ColliderSlot slotA, ColliderSlot slotB, PairContact& outContact);
+        void TestBladeShield(ColliderSlot slotA, ColliderSlot slotB, PairContact& outContact);
+
+        PairTest m_dispatch[kShapeCount][kShapeCount];
+
+        CollisionHand m_hands[kSlotCount];
+        Collider m_colliders[kSlotCount];
+        PairState m_pairs[kSlotCount][kSlotCount];      // [lower slot][higher slot]
+        CollisionEventCallback m_listeners[kMaxListeners] = {};
+        UInt32 m_equipGeneration = 0;
+        bool m_handsResolved = false;
+        float m_time = 0.0f;
+
+        // Stats
+        int m_stepCount = 0;
+        int m_pairTests = 0;
+        int m_eventCount = 0;
+        int m_suppressedEnds = 0;               // Contact ends held back by the hysteresis
+        double m_stepUs = 0.0;
+    };
+
+    // Convenience function to run the collision step (call each frame)
+    void UpdateCollisionWorld(float deltaTime);
+}
@@ -0,0 +1,538 @@
+#include "ConvexShapes.h"
+#include <cmath>
+#include <cfloat>
+
+namespace FalseEdgeVR
+{
+    static const int kGjkMaxIterations = 32;
+    static const float kGjkOverlapEpsilonSq = 1.0e-8f;
+    static const float kGjkRelativeTolerance = 1.0e-4f;
+
+    // Weapon part proportions (fractions of blade length unless noted)
+    static const float kMaceHeadFraction = 0.09f;        // Head radius, ~6 units on a 70 unit mace
+    static const float kMaceHeadMinRadius = 3.0f;
+    static const float kMaceHeadMaxRadius = 9.0f;
+    static const float kAxeBitWidthFraction = 0.18f;     // Handle to cutting edge, either side
+    static const float kAxeBitEdgeStart = 0.72f;         // Cutting edge span along the blade
+    static const float kAxeBitEdgeEnd = 0.97f;
+    static const float kAxeBitHandleStart = 0.78f;       // Where the bit meets the handle
+    static const float kAxeBitHandleEnd = 0.92f;
+    static const float kAxeBitThickness = 2.0f;          // Units, half thickness at the handle
+    static const float kAxeBitEdgeRadius = 0.5f;         // Units
+
+    static inline NiPoint3 Add(const NiPoint3& a, const NiPoint3& b) { return NiPoint3(a.x + b.x, a.y + b.y, a.z + b.z); }
+    static inline NiPoint3 Sub(const NiPoint3& a, const NiPoint3& b) { return NiPoint3(a.x - b.x, a.y - b.y, a.z - b.z); }
+    static inline NiPoint3 Scale(const NiPoint3& a, float s) { return NiPoint3(a.x * s, a.y * s, a.z * s); }
+    static inline NiPoint3 Negate(const NiPoint3& a) { return NiPoint3(-a.x, -a.y, -a.z); }
+    static inline float Dot(const NiPoint3& a, const NiPoint3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    static inline NiPoint3 Cross(const NiPoint3& a, const NiPoint3& b)
+    {
+        return NiPoint3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+    }
+
+    // ============================================
+    // Support functions
+    // ============================================
+
+    NiPoint3 ConvexShape::Support(const NiPoint3& dir) const
+    {
+        switch (type)
+        {
+        case ConvexShapeType::Capsule:
+            return Dot(Sub(end, center), dir) > 0.0f ? end : center;
+
+        case ConvexShapeType::Box:
+        {
+            NiPoint3 result = center;
+            for (int i = 0; i < 3; i++)
+            {
+                float extent = (&halfExtents.x)[i];
+                result = Add(result, Scale(axes[i], Dot(axes[i], dir) >= 0.0f ? extent : -extent));
+            }
+            return result;
+        }
+
+        case ConvexShapeType::Hull:
+        {
+            int best = 0;
+            float bestDot = -FLT_MAX;
+            for (int i = 0; i < pointCount; i++)
+            {
+                float d = Dot(points[i], dir);
+                if (d > bestDot)
+                {
+                    bestDot = d;
+                    best = i;
+                }
+            }
+            return pointCount > 0 ? points[best] : center;
+        }
+
+        case ConvexShapeType::Sphere:
+        default:
+            return center;
+        }
+    }
+
+    // ============================================
+    // GJK
+    // ============================================
+
+    struct SimplexVertex
+    {
+        NiPoint3 w;         // Minkowski difference point (a - b)
+        NiPoint3 a;         // Support point on A
+        NiPoint3 b;         // Support point on B
+        NiPoint3 dir;       // Direction it was found with (kept for the warm start)
+    };
+
+    struct Simplex
+    {
+        SimplexVertex v[4];
+        float lambda[4];    // Barycentric weights of the closest point
+        int count = 0;
+    };
+
+    static SimplexVertex MakeVertex(const ConvexShape& a, const ConvexShape& b, const NiPoint3& dir)
+    {
+        SimplexVertex vertex;
+        vertex.dir = dir;
+        vertex.a = a.Support(dir);
+        vertex.b = b.Support(Negate(dir));
+        vertex.w = Sub(vertex.a, vertex.b);
+        return vertex;
+    }
+
+    static NiPoint3 ClosestPoint(const Simplex& s)
+    {
+        NiPoint3 p(0, 0, 0);
+        for (int i = 0; i < s.count; i++)
+        {
+            p = Add(p, Scale(s.v[i].w, s.lambda[i]));
+        }
+        return p;
+    }
+
+    static void SetSimplex1(Simplex& out, const SimplexVertex& a)
+    {
+        out.v[0] = a;
+        out.lambda[0] = 1.0f;
+        out.count = 1;
+    }
+
+    static void SetSimplex2(Simplex& out, const SimplexVertex& a, const SimplexVertex& b, float t)
+    {
+        out.v[0] = a;
+        out.v[1] = b;
+        out.lambda[0] = 1.0f - t;
+        out.lambda[1] = t;
+        out.count = 2;
+    }
+
+    // Closest point to the origin on segment AB, reduced to the vertices that support it
+    static void SolveSegment(const SimplexVertex& A, const SimplexVertex& B, Simplex& out)
+    {
+        NiPoint3 ab = Sub(B.w, A.w);
+        float denom = Dot(ab, ab);
+        float t = denom > 1.0e-12f ? -Dot(A.w, ab) / denom : 0.0f;
+
+        if (t <= 0.0f)
+            SetSimplex1(out, A);
+        else if (t >= 1.0f)
+            SetSimplex1(out, B);
+        else
+            SetSimplex2(out, A, B, t);
+    }
+
+    // Closest point to the origin on triangle ABC (Voronoi region walk)
+    static void SolveTriangle(const SimplexVertex& A, const SimplexVertex& B, const SimplexVertex& C, Simplex& out)
+    {
+        NiPoint3 ab = Sub(B.w, A.w);
+        NiPoint3 ac = Sub(C.w, A.w);
+
+        NiPoint3 ap = Negate(A.w);
+        float d1 = Dot(ab, ap);
+        float d2 = Dot(ac, ap);
+        if (d1 <= 0.0f && d2 <= 0.0f)
+        {
+            SetSimplex1(out, A);
+            return;
+        }
+
+        NiPoint3 bp = Negate(B.w);
+        float d3 = Dot(ab, bp);
+        float d4 = Dot(ac, bp);
+        if (d3 >= 0.0f && d4 <= d3)
+        {
+            SetSimplex1(out, B);
+            return;
+        }
+
+        float vc = d1 * d4 - d3 * d2;
+        if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+        {
+            // d1 - d3 = |ab|^2 - zero for coincident vertices
+            if (d1 - d3 > 1.0e-12f)
+                SetSimplex2(out, A, B, d1 / (d1 - d3));
+            else
+                SetSimplex1(out, A);
+            return;
+        }
+
+        NiPoint3 cp = Negate(C.w);
+        float d5 = Dot(ab, cp);
+        float d6 = Dot(ac, cp);
+        if (d6 >= 0.0f && d5 <= d6)
+        {
+            SetSimplex1(out, C);
+            return;
+        }
+
+        float vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+        {
+            if (d2 - d6 > 1.0e-12f)
+                SetSimplex2(out, A, C, d2 / (d2 - d6));
+            else
+                SetSimplex1(out, A);
+            return;
+        }
+
+        float va = d3 * d6 - d5 * d4;
+        if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+        {
+            if ((d4 - d3) + (d5 - d6) > 1.0e-12f)
+                SetSimplex2(out, B, C, (d4 - d3) / ((d4 - d3) + (d5 - d6)));
+            else
+                SetSimplex1(out, B);
+            return;
+        }
+
+        float denom = va + vb + vc;
+        if (denom <= 1.0e-12f)
+        {
+            // Degenerate (collinear) triangle - closest of its three edges
+            Simplex edges[3];
+            SolveSegment(A, B, edges[0]);
+            SolveSegment(B, C, edges[1]);
+            SolveSegment(A, C, edges[2]);
+            int best = 0;
+            float bestSq = FLT_MAX;
+            for (int i = 0; i < 3; i++)
+            {
+                NiPoint3 p = ClosestPoint(edges[i]);
+                float distSq = Dot(p, p);
+                if (distSq < bestSq)
+                {
+                    bestSq = distSq;
+                    best = i;
+                }
+            }
+            out = edges[best];
+            return;
+        }
+
+        float v = vb / denom;
+        float w = vc / denom;
+        out.v[0] = A;
+        out.v[1] = B;
+        out.v[2] = C;
+        out.lambda[0] = 1.0f - v - w;
+        out.lambda[1] = v;
+        out.lambda[2] = w;
+        out.count = 3;
+    }
+
+    // Origin and D on opposite sides of plane ABC. A (nearly) flat tetrahedron has no
+    // reliable sides, so every face counts as outside and the closest one wins
+    static bool OriginOutsideFace(const NiPoint3& a, const NiPoint3& b, const NiPoint3& c, const NiPoint3& d)
+    {
+        NiPoint3 n = Cross(Sub(b, a), Sub(c, a));
+        float nLengthSq = Dot(n, n);
+        float signOrigin = Dot(Negate(a), n);
+        float signD = Dot(Sub(d, a), n);
+
+        // D's height over the plane against the face size (|n| ~ edge length squared)
+        if (signD * signD <= 1.0e-8f * nLengthSq * std::sqrt(nLengthSq))
+            return true;
+        return signOrigin * signD < 0.0f;
+    }
+
+    // Closest point to the origin on tetrahedron ABCD; false if the origin is inside
+    static bool SolveTetrahedron(const Simplex& s, Simplex& out)
+    {
+        const SimplexVertex& A = s.v[0];
+        const SimplexVertex& B = s.v[1];
+        const SimplexVertex& C = s.v[2];
+        const SimplexVertex& D = s.v[3];
+
+        float bestSq = FLT_MAX;
+        bool outside = false;
+        Simplex candidate;
+
+        const SimplexVertex* faces[4][4] = {
+            { &A, &B, &C, &D },
+            { &A, &C, &D, &B },
+            { &A, &D, &B, &C },
+            { &B, &D, &C, &A }
+        };
+
+        for (int f = 0; f < 4; f++)
+        {
+            if (!OriginOutsideFace(faces[f][0]->w, faces[f][1]->w, faces[f][2]->w, faces[f][3]->w))
+                continue;
+
+            outside = true;
+            SolveTriangle(*faces[f][0], *faces[f][1], *faces[f][2], candidate);
+            NiPoint3 p = ClosestPoint(candidate);
+            float distSq = Dot(p, p);
+            if (distSq < bestSq)
+            {
+                bestSq = distSq;
+                out = candidate;
+            }
+        }
+
+        return outside;
+    }
+
+    // Reduce the simplex to the smallest face holding the closest point; false if it encloses the origin
+    static bool SolveSimplex(Simplex& s)
+    {
+        Simplex reduced;
+        switch (s.count)
+        {
+        case 1:
+            s.lambda[0] = 1.0f;
+            return true;
+        case 2:
+            SolveSegment(s.v[0], s.v[1], reduced);
+            break;
+        case 3:
+            SolveTriangle(s.v[0], s.v[1], s.v[2], reduced);
+            break;
+        case 4:
+            if (!SolveTetrahedron(s, reduced))
+                return false;
+            break;
+        default:
+            return false;
+        }
+        s = reduced;
+        return true;
+    }
+
+    GjkResult GjkDistance(const ConvexShape& a, const ConvexShape& b, GjkCache* cache)
+    {
+        GjkResult result;
+        Simplex s;
+
+        // Warm start: the last frame's simplex, re-supported at the current poses
+        if (cache && cache->count > 0)
+        {
+            for (int i = 0; i < cache->count; i++)
+            {
+                SimplexVertex vertex = MakeVertex(a, b, cache->dirs[i]);
+
+                // Hull and capsule supports are discrete - two directions can land on the same point
+                bool duplicate = false;
+                for (int j = 0; j < s.count; j++)
+                {
+                    NiPoint3 diff = Sub(s.v[j].w, vertex.w);
+                    if (Dot(diff, diff) < 1.0e-10f)
+                        duplicate = true;
+                }
+                if (!duplicate)
+                    s.v[s.count++] = vertex;
+            }
+        }
+        else
+        {
+            NiPoint3 dir = Sub(b.center, a.center);
+            if (Dot(dir, dir) < 1.0e-12f)
+                dir = NiPoint3(1.0f, 0.0f, 0.0f);
+            s.v[s.count++] = MakeVertex(a, b, dir);
+        }
+
+        bool overlapping = !SolveSimplex(s);
+        NiPoint3 v = ClosestPoint(s);
+
+        while (!overlapping && result.iterations < kGjkMaxIterations)
+        {
+            float vv = Dot(v, v);
+            if (vv < kGjkOverlapEpsilonSq)
+            {
+                overlapping = true;
+                break;
+            }
+
+            SimplexVertex nv = MakeVertex(a, b, Negate(v));
+            result.iterations++;
+
+            // No support point meaningfully closer than v - converged
+            if (vv - Dot(v, nv.w) <= kGjkRelativeTolerance * vv)
+                break;
+
+            bool duplicate = false;
+            for (int i = 0; i < s.count; i++)
+            {
+                NiPoint3 diff = Sub(s.v[i].w, nv.w);
+                if (Dot(diff, diff) < 1.0e-10f)
+                {
+                    duplicate = true;
+                    break;
+                }
+            }
+            if (duplicate)
+                break;
+
+            Simplex previous = s;
+            s.v[s.count++] = nv;
+            if (!SolveSimplex(s))
+            {
+                overlapping = true;
+                break;
+            }
+
+            // Rounding can make a near-degenerate simplex step backwards - keep the best one and stop
+            NiPoint3 next = ClosestPoint(s);
+            if (Dot(next, next) >= vv)
+            {
+                s = previous;
+                break;
+            }
+            v = next;
+        }
+
+        if (cache)
+        {
+            cache->count = s.count;
+            for (int i = 0; i < s.count; i++)
+            {
+                cache->dirs[i] = s.v[i].dir;
+            }
+        }
+
+        NiPoint3 pa(0, 0, 0);
+        NiPoint3 pb(0, 0, 0);
+        for (int i = 0; i < s.count; i++)
+        {
+            pa = Add(pa, Scale(s.v[i].a, s.lambda[i]));
+            pb = Add(pb, Scale(s.v[i].b, s.lambda[i]));
+        }
+
+        result.overlapping = overlapping;
+        if (overlapping)
+        {
+            result.distance = 0.0f;
+            result.pointA = pa;
+            result.pointB = pa;
+            return result;
+        }
+
+        float coreDistance = std::sqrt(Dot(v, v));
+        float surfaceDistance = coreDistance - a.radius - b.radius;
+
+        // Push the core witnesses out to the surfaces along the separating axis
+        NiPoint3 n = coreDistance > 1.0e-6f ? Scale(Sub(pb, pa), 1.0f / coreDistance) : NiPoint3(0, 0, 0);
+        result.pointA = Add(pa, Scale(n, a.radius));
+        result.pointB = Sub(pb, Scale(n, b.radius));
+        result.distance = surfaceDistance > 0.0f ? surfaceDistance : 0.0f;
+        return result;
+    }
+
+    GjkResult CompoundDistance(const CompoundShape& a, const CompoundShape& b, GjkCache* caches)
+    {
+        GjkResult best;
+        best.distance = FLT_MAX;
+        int totalIterations = 0;
+
+        for (int i = 0; i < a.partCount; i++)
+        {
+            for (int j = 0; j < b.partCount; j++)
+            {
+                GjkCache* cache = caches ? &caches[i * CompoundShape::kMaxParts + j] : nullptr;
+                GjkResult r = GjkDistance(a.parts[i], b.parts[j], cache);
+                totalIterations += r.iterations;
+                if (r.distance < best.distance)
+                {
+                    best = r;
+                    best.partA = i;
+                    best.partB = j;
+                }
+            }
+        }
+
+        best.iterations = totalIterations;
+        return best;
+    }
+
+    // ============================================
+    // Weapon shapes
+    // ============================================
+
+    void BuildWeaponShape(WeaponType type, const NiPoint3& base, const NiPoint3& tip, const NiPoint3& edgeAxis, CompoundShape& outShape)
+    {
+        outShape.partCount = 0;
+
+        NiPoint3 blade = Sub(tip, base);
+        float length = std::sqrt(Dot(blade, blade));
+
+        // The blade itself - a bare segment, as the thresholds are tuned for
+        ConvexShape& core = outShape.parts[outShape.partCount++];
+        core.type = ConvexShapeType::Capsule;
+        core.center = base;
+        core.end = tip;
+        core.radius = 0.0f;
+
+        if (length < 0.001f)
+            return;
+
+        // Blade frame: Y along the blade, X the node's X axis made perpendicular, Z completes it
+        NiPoint3 axisY = Scale(blade, 1.0f / length);
+        NiPoint3 axisX = Sub(edgeAxis, Scale(axisY, Dot(edgeAxis, axisY)));
+        float xLength = std::sqrt(Dot(axisX, axisX));
+        if (xLength < 0.001f)
+        {
+            axisX = std::fabs(axisY.z) < 0.9f ? Cross(axisY, NiPoint3(0, 0, 1)) : Cross(axisY, NiPoint3(1, 0, 0));
+            xLength = std::sqrt(Dot(axisX, axisX));
+        }
+        axisX = Scale(axisX, 1.0f / xLength);
+        NiPoint3 axisZ = Cross(axisX, axisY);
+
+        auto toWorld = [&](float x, float y, float z) {
+            return Add(base, Add(Scale(axisX, x), Add(Scale(axisY, y), Scale(axisZ, z))));
+        };
+
+        if (type == WeaponType::Mace)
+        {
+            float headRadius = length * kMaceHeadFraction;
+            if (headRadius < kMaceHeadMinRadius) headRadius = kMaceHeadMinRadius;
+            if (headRadius > kMaceHeadMaxRadius) headRadius = kMaceHeadMaxRadius;
+
+            ConvexShape& head = outShape.parts[outShape.partCount++];
+            head.type = ConvexShapeType::Sphere;
+            head.center = toWorld(0.0f, length - headRadius, 0.0f);
+            head.radius = headRadius;
+        }
+        else if (type == WeaponType::Axe)
+        {
+            // Wedge on both sides of the handle - which side carries the edge differs per mesh
+            float width = length * kAxeBitWidthFraction;
+
+            ConvexShape& bit = outShape.parts[outShape.partCount++];
+            bit.type = ConvexShapeType::Hull;
+            bit.radius = kAxeBitEdgeRadius;
+            bit.pointCount = 0;
+            bit.points[bit.pointCount++] = toWorld(0.0f, length * kAxeBitHandleStart, kAxeBitThickness);
+            bit.points[bit.pointCount++] = toWorld(0.0f, length * kAxeBitHandleStart, -kAxeBitThickness);
+            bit.points[bit.pointCount++] = toWorld(0.0f, length * kAxeBitHandleEnd, kAxeBitThickness);
+            bit.points[bit.pointCount++] = toWorld(0.0f, length * kAxeBitHandleEnd, -kAxeBitThickness);
+            bit.points[bit.pointCount++] = toWorld(width, length * kAxeBitEdgeStart, 0.0f);
+            bit.points[bit.pointCount++] = toWorld(width, length * kAxeBitEdgeEnd, 0.0f);
+            bit.points[bit.pointCount++] = toWorld(-width, length * kAxeBitEdgeStart, 0.0f);
+            bit.points[bit.pointCount++] = toWorld(-width, length * kAxeBitEdgeEnd, 0.0f);
+            bit.center = toWorld(0.0f, length * 0.5f * (kAxeBitHandleStart + kAxeBitHandleEnd), 0.0f);
+        }
+    }
+}
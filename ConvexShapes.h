@@ -0,0 +1,84 @@
+#pragma once
+
+#include "skse64/NiTypes.h"
+#include "EquipManager.h"
+
+namespace FalseEdgeVR
+{
+    // ============================================
+    // Convex shapes + GJK distance
+    // ============================================
+    // Small convex shape library for weapon-vs-weapon distance. Every shape is a
+    // core (point, segment, oriented box or point hull) plus a radius, so the
+    // GJK solver only has to deal with the cores and subtracts the radii at the end.
+    // Each WeaponType gets a compound shape built in the blade frame (Y = base to
+    // tip, X = weapon node X axis): a segment along the blade like before, plus a
+    // sphere for a mace head or a hull for an axe bit. Blade segments keep a zero
+    // radius so the [BladeCollision] thresholds still measure the same thing.
+    // GjkCache holds the support directions of the last frame's simplex for each
+    // shape pair; rebuilding the simplex from them usually leaves one or two
+    // iterations of work while the weapons move smoothly.
+    // ============================================
+
+    enum class ConvexShapeType : UInt8
+    {
+        Sphere,         // center + radius
+        Capsule,        // center..end + radius
+        Box,            // center, axes[3] (unit), halfExtents
+        Hull            // points[0..pointCount) + radius
+    };
+
+    struct ConvexShape
+    {
+        static const int kMaxHullPoints = 8;
+
+        ConvexShapeType type = ConvexShapeType::Sphere;
+        NiPoint3 center;
+        NiPoint3 end;
+        NiPoint3 axes[3];
+        NiPoint3 halfExtents;
+        NiPoint3 points[kMaxHullPoints];
+        int pointCount = 0;
+        float radius = 0.0f;
+
+        // Farthest core point along dir (radius not included)
+        NiPoint3 Support(const NiPoint3& dir) const;
+    };
+
+    struct CompoundShape
+    {
+        static const int kMaxParts = 3;
+
+        ConvexShape parts[kMaxParts];
+        int partCount = 0;
+    };
+
+    // Last simplex of one shape pair, as the directions its vertices were found with
+    struct GjkCache
+    {
+        NiPoint3 dirs[4];
+        int count = 0;
+
+        void Clear() { count = 0; }
+    };
+
+    struct GjkResult
+    {
+        float distance = 0.0f;          // Surface distance (0 if the shapes touch or overlap)
+        NiPoint3 pointA;                // Closest point on A's surface
+        NiPoint3 pointB;                // Closest point on B's surface
+        int iterations = 0;             // Support queries after the warm start
+        bool overlapping = false;       // Cores intersect - witness points are not meaningful
+        int partA = 0;                  // Compound parts that produced the result
+        int partB = 0;
+    };
+
+    // Distance between two convex shapes; cache may be null (cold start)
+    GjkResult GjkDistance(const ConvexShape& a, const ConvexShape& b, GjkCache* cache);
+
+    // Minimum over all part pairs; caches is [kMaxParts * kMaxParts], indexed partA * kMaxParts + partB
+    GjkResult CompoundDistance(const CompoundShape& a, const CompoundShape& b, GjkCache* caches);
+
+    // Weapon shape for a type from the tracked blade pose
+    void BuildWeaponShape(WeaponType type, const NiPoint3& base, const NiPoint3& tip, const NiPoint3& edgeAxis, CompoundShape& outShape);
+}
@@ -0,0 +1,137 @@
+#include "DistanceField.h"
+#include <cmath>
+#include <algorithm>
+
+namespace FalseEdgeVR
+{
+    float SampleDistanceField(const BladeProfileFieldView& field, const NiPoint3& point, NiPoint3* outGradient)
+    {
+        const int res = (int)field.resolution;
+        const float inv = 1.0f / field.voxelSize;
+        const float maxCoord = (float)(res - 1);
+
+        // Grid coordinates, clamped onto the grid - the clamped-off part is added back at the end
+        float g[3] = {
+            (point.x - field.origin[0]) * inv,
+            (point.y - field.origin[1]) * inv,
+            (point.z - field.origin[2]) * inv
+        };
+        float outside[3];
+        int cell[3];
+        float f[3];
+        for (int a = 0; a < 3; a++)
+        {
+            float clamped = std::max(0.0f, std::min(maxCoord, g[a]));
+            outside[a] = (g[a] - clamped) * field.voxelSize;
+            cell[a] = std::min(res - 2, (int)clamped);
+            f[a] = clamped - cell[a];
+        }
+
+        const SInt16* s = field.samples + ((size_t)cell[2] * res + cell[1]) * res + cell[0];
+        const size_t dy = res, dz = (size_t)res * res;
+        float c000 = s[0], c100 = s[1], c010 = s[dy], c110 = s[dy + 1];
+        float c001 = s[dz], c101 = s[dz + 1], c011 = s[dz + dy], c111 = s[dz + dy + 1];
+
+        // Blend along x, then y, then z
+        float c00 = c000 + (c100 - c000) * f[0];
+        float c10 = c010 + (c110 - c010) * f[0];
+        float c01 = c001 + (c101 - c001) * f[0];
+        float c11 = c011 + (c111 - c011) * f[0];
+        float c0 = c00 + (c10 - c00) * f[1];
+        float c1 = c01 + (c11 - c01) * f[1];
+        float distance = (c0 + (c1 - c0) * f[2]) * field.distanceScale;
+
+        // Derivative of the trilinear blend inside the cell
+        float x0 = (c100 - c000) + ((c110 - c010) - (c100 - c000)) * f[1];
+        float x1 = (c101 - c001) + ((c111 - c011) - (c101 - c001)) * f[1];
+        NiPoint3 gradient(x0 + (x1 - x0) * f[2], (c10 - c00) + ((c11 - c01) - (c10 - c00)) * f[2], c1 - c0);
+        float gradientLength = std::sqrt(gradient.x * gradient.x + gradient.y * gradient.y + gradient.z * gradient.z);
+        if (gradientLength > 0.0001f)
+            gradient = NiPoint3(gradient.x / gradientLength, gradient.y / gradientLength, gradient.z / gradientLength);
+        else
+            gradient = NiPoint3(0, 0, 0);
+
+        // Off the grid: surface -> clamped point plus clamped point -> point
+        if (outside[0] != 0.0f || outside[1] != 0.0f || outside[2] != 0.0f)
+        {
+            float surfaceDistance = std::max(distance, 0.0f);
+            gradient = NiPoint3(gradient.x * surfaceDistance + outside[0], gradient.y * surfaceDistance + outside[1], gradient.z * surfaceDistance + outside[2]);
+            distance = std::sqrt(gradient.x * gradient.x + gradient.y * gradient.y + gradient.z * gradient.z);
+            if (distance > 0.0001f)
+                gradient = NiPoint3(gradient.x / distance, gradient.y / distance, gradient.z / distance);
+        }
+
+        if (outGradient)
+            *outGradient = gradient;
+        return distance;
+    }
+
+    void SegmentDistanceField(const BladeProfileFieldView& field, const NiPoint3& start, const NiPoint3& end, FieldContact& outContact)
+    {
+        static const int kMinSamples = 4;
+        static const int kMaxSamples = 32;
+        static const int kRefineSteps = 8;
+
+        NiPoint3 dir(end.x - start.x, end.y - start.y, end.z - start.z);
+        float length = std::sqrt(dir.x * dir.x + dir.y * dir.y + dir.z * dir.z);
+
+        auto pointAt = [&](float t) { return NiPoint3(start.x + dir.x * t, start.y + dir.y * t, start.z + dir.z * t); };
+        int samples = 0;
+        auto distanceAt = [&](float t) { samples++; return SampleDistanceField(field, pointAt(t), nullptr); };
+
+        // Coarse pass about one sample per voxel, then a golden-section search
+        // around the best sample - the field is smooth at voxel scale
+        int steps = std::max(kMinSamples, std::min(kMaxSamples, (int)std::ceil(length / field.voxelSize)));
+        float bestT = 0.0f;
+        float best = distanceAt(0.0f);
+        for (int i = 1; i <= steps; i++)
+        {
+            float t = (float)i / steps;
+            float d = distanceAt(t);
+            if (d < best)
+            {
+                best = d;
+                bestT = t;
+            }
+        }
+
+        const float kGolden = 0.618034f;
+        float lo = std::max(0.0f, bestT - 1.0f / steps);
+        float hi = std::min(1.0f, bestT + 1.0f / steps);
+        float t1 = hi - kGolden * (hi - lo), t2 = lo + kGolden * (hi - lo);
+        float d1 = distanceAt(t1), d2 = distanceAt(t2);
+        for (int i = 0; i < kRefineSteps; i++)
+        {
+            if (d1 < d2)
+            {
+                hi = t2;
+                t2 = t1;
+                d2 = d1;
+                t1 = hi - kGolden * (hi - lo);
+                d1 = distanceAt(t1);
+            }
+            else
+            {
+                lo = t1;
+                t1 = t2;
+                d1 = d2;
+                t2 = lo + kGolden * (hi - lo);
+                d2 = distanceAt(t2);
+            }
+        }
+        if (std::min(d1, d2) < best)
+        {
+            bestT = d1 < d2 ? t1 : t2;
+        }
+
+        NiPoint3 normal;
+        outContact.segmentParam = bestT;
+        outContact.segmentPoint = pointAt(bestT);
+        outContact.distance = SampleDistanceField(field, outContact.segmentPoint, &normal);
+        outContact.surfacePoint = NiPoint3(
+            outContact.segmentPoint.x - normal.x * outContact.distance,
+            outContact.segmentPoint.y - normal.y * outContact.distance,
+            outContact.segmentPoint.z - normal.z * outContact.distance);
+        outContact.samples = samples + 1;
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "skse64/NiTypes.h"
+#include "WeaponProfileDB.h"
+
+namespace FalseEdgeVR
+{
+    // ============================================
+    // Distance field queries
+    // ============================================
+    // Reads the precomputed signed distance fields of the profile database
+    // (NifProfiler samples shield meshes on a 32^3 grid). Everything works in
+    // the mesh's node space - callers transform into it and scale the results
+    // back out. Inside the grid a lookup is one trilinear blend of 8 samples;
+    // outside it the point is clamped onto the grid and the offset from there
+    // added to the clamped point's surface vector. The grid is padded around
+    // the mesh, so that stays close for points near the shield.
+    // ============================================
+
+    struct FieldContact
+    {
+        float distance = 0.0f;          // Signed - negative when the segment is inside the mesh
+        float segmentParam = 0.0f;      // 0 = start, 1 = end
+        NiPoint3 segmentPoint;          // Closest point on the segment
+        NiPoint3 surfacePoint;          // Nearest surface point to it
+        int samples = 0;                // Field lookups this query made
+    };
+
+    // Signed distance at a node-space point; outGradient (optional) gets the unit surface normal direction
+    float SampleDistanceField(const BladeProfileFieldView& field, const NiPoint3& point, NiPoint3* outGradient);
+
+    // Closest approach of segment start..end to the field's surface
+    void SegmentDistanceField(const BladeProfileFieldView& field, const NiPoint3& start, const NiPoint3& end, FieldContact& outContact);
+}
@@ -1,5 +1,6 @@
 #include "Engine.h"
 #include "EquipManager.h"
+#include "EquipCommandBuffer.h"
 #include "VRInputHandler.h"
 #include "WeaponGeometry.h"
 #include "ShieldCollision.h"
@@ -252,62 +253,20 @@ namespace FalseEdgeVR
 			_MESSAGE("[ReequipCheck] After removal processed - Left equipped: %s, Right equipped: %s",
 				leftStillHasWeapon ? "YES" : "NO", rightStillHasWeapon ? "YES" : "NO");
 			
-			::EquipManager* equipMan = ::EquipManager::GetSingleton();
-			if (equipMan)
+			// Check LEFT hand
+			if (m_leftHadWeapon && !leftStillHasWeapon)
 			{
-				// Check LEFT hand
-				if (m_leftHadWeapon && !leftStillHasWeapon)
-				{
-					_MESSAGE("[ReequipCheck] LEFT hand weapon was unequipped - re-equipping!");
-					BGSEquipSlot* leftSlot = GetLeftHandSlot();
-					FalseEdgeVR::EquipManager::s_suppressDrawSound = true;
-					
-					// Temporarily strip enchantment to prevent enchant VFX/sound
-					TESObjectWEAP* weap = DYNAMIC_CAST(itemForm, TESForm, TESObjectWEAP);
-					EnchantmentItem* cachedEnchant = nullptr;
-					if (weap && weap->enchantable.enchantment)
-					{
-						cachedEnchant = weap->enchantable.enchantment;
-						weap->enchantable.enchantment = nullptr;
-					}
-
-					CALL_MEMBER_FN(equipMan, EquipItem)(player, itemForm, nullptr, 1, leftSlot, false, true, false, nullptr);
-
-					// Restore enchantment immediately
-					if (weap && cachedEnchant)
-					{
-						weap->enchantable.enchantment = cachedEnchant;
-					}
-					
-					FalseEdgeVR::EquipManager::s_suppressDrawSound = false;
-					_MESSAGE("[ReequipCheck] Re-equipped weapon to LEFT hand (silent)");
-				}
-				
-				// Check RIGHT hand
-				if (m_rightHadWeapon && !rightStillHasWeapon)
-				{
-					_MESSAGE("[ReequipCheck] RIGHT hand weapon was unequipped - re-equipping!");
-					BGSEquipSlot* rightSlot = GetRightHandSlot();
-					FalseEdgeVR::EquipManager::s_suppressDrawSound = true;
-					// Temporarily strip enchantment to prevent enchant VFX/sound
-					TESObjectWEAP* weap2 = DYNAMIC_CAST(itemForm, TESForm, TESObjectWEAP);
-					EnchantmentItem* cachedEnchant2 = nullptr;
-					if (weap2 && weap2->enchantable.enchantment)
-					{
-						cachedEnchant2 = weap2->enchantable.enchantment;
-						weap2->enchantable.enchantment = nullptr;
-					}
-
-					CALL_MEMBER_FN(equipMan, EquipItem)(player, itemForm, nullptr, 1, rightSlot, false, true, false, nullptr);
-
-					// Restore enchantment immediately
-					if (weap2 && cachedEnchant2)
-					{
-						weap2->enchantable.enchantment = cachedEnchant2;
-					}
-					FalseEdgeVR::EquipManager::s_suppressDrawSound = false;
-					_MESSAGE("[ReequipCheck] Re-equipped weapon to RIGHT hand (silent)");
-				}
+				_MESSAGE("[ReequipCheck] LEFT hand weapon was unequipped - re-equipping!");
+				EquipCommandBuffer::GetSingleton()->QueueEquip(itemForm, true, true);
+				_MESSAGE("[ReequipCheck] Queued re-equip to LEFT hand (silent)");
+			}
+			
+			// Check RIGHT hand
+			if (m_rightHadWeapon && !rightStillHasWeapon)
+			{
+				_MESSAGE("[ReequipCheck] RIGHT hand weapon was unequipped - re-equipping!");
+				EquipCommandBuffer::GetSingleton()->QueueEquip(itemForm, false, true);
+				_MESSAGE("[ReequipCheck] Queued re-equip to RIGHT hand (silent)");
 			}
 		}
 
@@ -0,0 +1,263 @@
+#include "EquipCommandBuffer.h"
+#include "EquipManager.h"
+#include "Engine.h"
+#include "skse64/GameData.h"
+#include "skse64/GameExtraData.h"
+#include "skse64/GameObjects.h"
+#include "skse64/GameRTTI.h"
+#include "common/IDebugLog.h"
+
+namespace FalseEdgeVR
+{
+    EquipCommandBuffer* EquipCommandBuffer::GetSingleton()
+    {
+        static EquipCommandBuffer instance;
+        return &instance;
+    }
+
+    void EquipCommandBuffer::QueueEquip(TESForm* item, bool isLeftHand, bool stripEnchantment, EquipFollowUp followUp)
+    {
+        if (!item)
+            return;
+
+        EquipCommand cmd;
+        cmd.equip = true;
+        cmd.formID = item->formID;
+        cmd.isLeftHand = isLeftHand;
+        cmd.stripEnchantment = stripEnchantment;
+        cmd.followUp = followUp;
+        Queue(cmd);
+    }
+
+    void EquipCommandBuffer::QueueUnequip(TESForm* item, bool isLeftHand, EquipFollowUp followUp)
+    {
+        if (!item)
+            return;
+
+        EquipCommand cmd;
+        cmd.equip = false;
+        cmd.formID = item->formID;
+        cmd.isLeftHand = isLeftHand;
+        cmd.followUp = followUp;
+        Queue(cmd);
+    }
+
+    void EquipCommandBuffer::Queue(const EquipCommand& cmd)
+    {
+        m_requestedCount++;
+
+        if (!m_frameOpen)
+        {
+            Apply(cmd);
+            return;
+        }
+
+        // Coalesce against the latest command for the same hand
+        for (int i = (int)m_pending.size() - 1; i >= 0; i--)
+        {
+            EquipCommand& prev = m_pending[i];
+            if (prev.isLeftHand != cmd.isLeftHand)
+                continue;
+
+            if (prev.formID == cmd.formID)
+            {
+                if (prev.equip != cmd.equip)
+                {
+                    // Equip + unequip of the same form this frame. The pair is a no-op only if nothing else is
+                    // queued for the hand, the hand already is in the pair's final state (empty after equip ->
+                    // unequip, holding the form after unequip -> equip) and there is no follow-up to lose.
+                    // Otherwise both run in order
+                    bool firstForHand = true;
+                    for (int j = 0; j < i && firstForHand; j++)
+                        firstForHand = (m_pending[j].isLeftHand != cmd.isLeftHand);
+
+                    bool noFollowUp = (prev.followUp == EquipFollowUp::None && cmd.followUp == EquipFollowUp::None);
+                    if (firstForHand && noFollowUp && HandHolds(cmd.isLeftHand, cmd.equip ? cmd.formID : 0))
+                    {
+                        _MESSAGE("EquipCommandBuffer: %s of %08X cancels queued %s (%s hand)",
+                            cmd.equip ? "Equip" : "Unequip", cmd.formID, prev.equip ? "equip" : "unequip",
+                            cmd.isLeftHand ? "LEFT" : "RIGHT");
+                        m_pending.erase(m_pending.begin() + i);
+                        m_cancelledCount += 2;
+                        return;
+                    }
+                    break;
+                }
+
+                // Same command again - keep the first, but don't lose a follow-up
+                if (prev.followUp == EquipFollowUp::None)
+                    prev.followUp = cmd.followUp;
+                prev.stripEnchantment = prev.stripEnchantment || cmd.stripEnchantment;
+                m_mergedCount++;
+                return;
+            }
+
+            if (prev.equip && cmd.equip && prev.followUp == EquipFollowUp::None)
+            {
+                // A later equip to the same hand replaces the earlier one (whose follow-up, if any, must still run)
+                m_pending.erase(m_pending.begin() + i);
+                m_mergedCount++;
+            }
+            break;
+        }
+
+        m_pending.push_back(cmd);
+    }
+
+    bool EquipCommandBuffer::HandHolds(bool isLeftHand, UInt32 formID)
+    {
+        PlayerCharacter* player = *g_thePlayer;
+        if (!player)
+            return false;
+
+        TESForm* equipped = player->GetEquippedObject(isLeftHand);
+        return (equipped ? equipped->formID : 0) == formID;
+    }
+
+    void EquipCommandBuffer::Apply(const EquipCommand& cmd)
+    {
+        PlayerCharacter* player = *g_thePlayer;
+        if (!player)
+            return;
+
+        TESForm* item = LookupFormByID(cmd.formID);
+        if (!item)
+        {
+            _MESSAGE("EquipCommandBuffer: Form %08X not found - dropping %s", cmd.formID, cmd.equip ? "equip" : "unequip");
+            return;
+        }
+
+        ::EquipManager* equipMan = ::EquipManager::GetSingleton();
+        if (!equipMan)
+        {
+            _MESSAGE("EquipCommandBuffer: Game EquipManager not available!");
+            return;
+        }
+
+        BGSEquipSlot* slot = cmd.isLeftHand ? GetLeftHandSlot() : GetRightHandSlot();
+
+        if (cmd.equip)
+        {
+            BaseExtraList* extraList = nullptr;
+            if (cmd.followUp == EquipFollowUp::Reequip)
+                extraList = EquipManager::GetSingleton()->FindReequipExtraList(item, cmd.isLeftHand);
+
+            // Temporarily strip enchantment to prevent enchant VFX/sound
+            TESObjectWEAP* weap = cmd.stripEnchantment ? DYNAMIC_CAST(item, TESForm, TESObjectWEAP) : nullptr;
+            EnchantmentItem* cachedEnchant = nullptr;
+            if (weap && weap->enchantable.enchantment)
+            {
+                cachedEnchant = weap->enchantable.enchantment;
+                weap->enchantable.enchantment = nullptr;
+            }
+
+            EquipManager::s_suppressDrawSound = true;
+            CALL_MEMBER_FN(equipMan, EquipItem)(player, item, extraList, 1, slot, false, true, false, nullptr);
+            EquipManager::s_suppressDrawSound = false;
+            m_gameCallCount++;
+
+            // Restore enchantment immediately
+            if (weap && cachedEnchant)
+            {
+                weap->enchantable.enchantment = cachedEnchant;
+            }
+
+            if (cmd.followUp == EquipFollowUp::Reequip)
+                EquipManager::GetSingleton()->FinishReequip(item, cmd.isLeftHand, extraList);
+            return;
+        }
+
+        // Unequip - find the worn extra list for this hand now, the inventory may have changed since queueing
+        ExtraContainerChanges* containerChanges = static_cast<ExtraContainerChanges*>(
+            player->extraData.GetByType(kExtraData_ContainerChanges));
+        if (!containerChanges || !containerChanges->data)
+        {
+            _MESSAGE("EquipCommandBuffer: No container changes data - dropping unequip of %08X", cmd.formID);
+            return;
+        }
+
+        InventoryEntryData* entryData = containerChanges->data->FindItemEntry(item);
+        if (!entryData)
+        {
+            _MESSAGE("EquipCommandBuffer: %08X not in inventory - dropping unequip", cmd.formID);
+            return;
+        }
+
+        BaseExtraList* rightEquipList = NULL;
+        BaseExtraList* leftEquipList = NULL;
+        entryData->GetExtraWornBaseLists(&rightEquipList, &leftEquipList);
+
+        BaseExtraList* equipList = cmd.isLeftHand ? leftEquipList : rightEquipList;
+        if (!equipList)
+        {
+            _MESSAGE("EquipCommandBuffer: %08X no longer worn in %s hand - dropping unequip",
+                cmd.formID, cmd.isLeftHand ? "LEFT" : "RIGHT");
+            return;
+        }
+
+        // Remove CannotWear flag if present
+        BSExtraData* xCannotWear = equipList->GetByType(kExtraData_CannotWear);
+        if (xCannotWear)
+        {
+            equipList->Remove(kExtraData_CannotWear, xCannotWear);
+        }
+
+        EquipManager::s_suppressSheathSound = true;
+        CALL_MEMBER_FN(equipMan, UnequipItem)(player, item, equipList, 1, slot, false, true, true, false, NULL);
+        EquipManager::s_suppressSheathSound = false;
+        m_gameCallCount++;
+
+        if (cmd.followUp == EquipFollowUp::SpawnAndGrab)
+            EquipManager::GetSingleton()->SpawnAndGrabUnequipped(item, cmd.isLeftHand);
+    }
+
+    void EquipCommandBuffer::BeginFrame()
+    {
+        if (m_pending.capacity() < kInitialCapacity)
+        {
+            m_pending.reserve(kInitialCapacity);
+            m_applying.reserve(kInitialCapacity);
+        }
+        m_frameOpen = true;
+    }
+
+    void EquipCommandBuffer::Flush(float deltaTime)
+    {
+        m_frameOpen = false;
+
+        if (!m_pending.empty())
+        {
+            // Follow-ups may queue again - those apply immediately now the frame is closed
+            m_applying.swap(m_pending);
+            for (const EquipCommand& cmd : m_applying)
+            {
+                Apply(cmd);
+            }
+            m_applying.clear();
+        }
+
+        // Stats every 10 seconds while equips are happening
+        m_statsTimer += deltaTime;
+        if (m_statsTimer >= 10.0f)
+        {
+            int equipEvents = m_equipEventCount.exchange(0, std::memory_order_relaxed);
+            if (m_requestedCount > 0 || equipEvents > 0)
+            {
+                _MESSAGE("EquipCommandBuffer: Stats - requested %.2f/s, game calls %.2f/s (cancelled %d, merged %d), player equip events %.2f/s",
+                    m_requestedCount / m_statsTimer, m_gameCallCount / m_statsTimer,
+                    m_cancelledCount, m_mergedCount, equipEvents / m_statsTimer);
+            }
+            m_statsTimer = 0.0f;
+            m_requestedCount = 0;
+            m_gameCallCount = 0;
+            m_cancelledCount = 0;
+            m_mergedCount = 0;
+        }
+    }
+
+    void EquipCommandBuffer::Clear()
+    {
+        m_pending.clear();
+        m_frameOpen = false;
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "skse64/GameReferences.h"
+#include "skse64/GameForms.h"
+#include <vector>
+#include <atomic>
+
+namespace FalseEdgeVR
+{
+    // What EquipManager does once a buffered command has reached the game
+    enum class EquipFollowUp
+    {
+        None = 0,
+        SpawnAndGrab,   // Unequip: spawn the world copy and hand it to HIGGS (ForceUnequipAndGrab)
+        Reequip         // Equip: use the cached tempered/enchanted entry, restore favorite, clear caches (ForceReequipHand)
+    };
+
+    // ============================================
+    // EquipCommandBuffer
+    // ============================================
+    // Every internal EquipItem / UnequipItem goes through here.
+    // During the pre-physics step (BeginFrame .. Flush) commands are collected per
+    // game hand and coalesced only where the hand provably ends the same: an equip and
+    // unequip of the same form cancel out when the hand already is in the final state,
+    // a repeated command is dropped, and a later equip replaces an earlier one for the
+    // same hand. A command carrying a follow-up is never dropped for another form's.
+    // Flush applies what is left once, after all trackers have run.
+    // Outside the frame (tasks, event sinks, HIGGS callbacks) commands apply immediately.
+    // All internal equips/unequips are silent (draw/sheath sounds suppressed).
+    // Game thread only.
+    // ============================================
+
+    class EquipCommandBuffer
+    {
+    public:
+        static EquipCommandBuffer* GetSingleton();
+
+        // Equip item to a game hand. stripEnchantment hides the enchant VFX/sound for the call.
+        void QueueEquip(TESForm* item, bool isLeftHand, bool stripEnchantment, EquipFollowUp followUp = EquipFollowUp::None);
+
+        // Unequip item from a game hand (worn extra list is resolved when the command is applied)
+        void QueueUnequip(TESForm* item, bool isLeftHand, EquipFollowUp followUp = EquipFollowUp::None);
+
+        // Start collecting commands for this frame
+        void BeginFrame();
+
+        // Apply the coalesced commands (end of the pre-physics step)
+        void Flush(float deltaTime);
+
+        // Drop queued commands (game load)
+        void Clear();
+
+        // Count player TESEquipEvents (from EquipEventHandler, possibly off the game thread) for the stats
+        void NoteEquipEvent() { m_equipEventCount.fetch_add(1, std::memory_order_relaxed); }
+
+    private:
+        EquipCommandBuffer() = default;
+        ~EquipCommandBuffer() = default;
+        EquipCommandBuffer(const EquipCommandBuffer&) = delete;
+        EquipCommandBuffer& operator=(const EquipCommandBuffer&) = delete;
+
+        struct EquipCommand
+        {
+            bool equip = false;
+            UInt32 formID = 0;
+            bool isLeftHand = false;
+            bool stripEnchantment = false;
+            EquipFollowUp followUp = EquipFollowUp::None;
+        };
+
+        void Queue(const EquipCommand& cmd);
+
+        // Whether the hand holds exactly this form right now (0 = empty) - the state before any queued command
+        static bool HandHolds(bool isLeftHand, UInt32 formID);
+
+        // Make the game call for one command and run its follow-up
+        void Apply(const EquipCommand& cmd);
+
+        static const size_t kInitialCapacity = 8;
+
+        std::vector<EquipCommand> m_pending;
+        std::vector<EquipCommand> m_applying;   // Flush swaps the pending commands in here - no per-frame allocation
+        bool m_frameOpen = false;
+
+        // Stats (per 10 second window)
+        float m_statsTimer = 0.0f;
+        int m_requestedCount = 0;     // Commands requested - game calls without the buffer
+        int m_gameCallCount = 0;      // EquipItem/UnequipItem calls actually made
+        int m_cancelledCount = 0;     // Commands dropped by equip/unequip cancellation
+        int m_mergedCount = 0;        // Commands dropped as duplicates or superseded
+        std::atomic<int> m_equipEventCount{ 0 };  // Player TESEquipEvents received
+    };
+}
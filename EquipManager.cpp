@@ -4,6 +4,11 @@
 #include "ShieldCollision.h"
 #include "SkyrimVRESLAPI.h"
 #include "ActivateHook.h"
+#include "WeaponRefPool.h"
+#include "EquipCommandBuffer.h"
+#include "RefHandleTable.h"
+#include "SoundCooldownTable.h"
+#include "TrackingDormancy.h"
 #include "skse64/GameData.h"
 #include "skse64/GameForms.h"
 #include "skse64/GameExtraData.h"
@@ -13,7 +18,6 @@
 #include <thread>
 #include <chrono>
 #include <unordered_map>
-#include <mutex>
 
 namespace FalseEdgeVR
 {
@@ -25,15 +29,13 @@ namespace FalseEdgeVR
     bool EquipManager::s_suppressSheathSound = false;
 
     // Per-weapon draw cooldowns (prevent same weapon draw sound within cooldown after unequip)
-    // Key: weapon FormID, Value: time when weapon was UNEQUIPPED
-    static std::unordered_map<UInt32, std::chrono::steady_clock::time_point> s_lastUnequipTimes;
+    // Records the time when the weapon was UNEQUIPPED
+    static SoundCooldownTable s_drawCooldowns("Draw");
     
     // Per-weapon sheath cooldowns (prevent same weapon sheath sound within cooldown after equip)
-    // Key: weapon FormID, Value: time when weapon was EQUIPPED
-    static std::unordered_map<UInt32, std::chrono::steady_clock::time_point> s_lastEquipTimes;
+    // Records the time when the weapon was EQUIPPED
+    static SoundCooldownTable s_sheathCooldowns("Sheath");
     
-    static std::mutex s_drawMutex;
-    static std::mutex s_sheathMutex;
     static const int DRAW_SOUND_COOLDOWN_SECONDS = 5;
     static const int SHEATH_SOUND_COOLDOWN_SECONDS = 5;
 
@@ -65,23 +67,8 @@ namespace FalseEdgeVR
                 return;
             }
 
-            ::EquipManager* equipMan = ::EquipManager::GetSingleton();
-            if (!equipMan)
-            {
-                _MESSAGE("[DelayedEquipWeapon] EquipManager not available");
-                return;
-            }
-
-            // Get the appropriate slot for left or right hand
-            BGSEquipSlot* slot = m_equipToLeftHand ? GetLeftHandSlot() : GetRightHandSlot();
-
-            // Suppress draw sound during delayed equip
-            EquipManager::s_suppressDrawSound = true;
-        
- // EquipItem params: actor, item, extraData, count, slot, withEquipSound, preventUnequip, showMsg, unk
-            CALL_MEMBER_FN(equipMan, EquipItem)(player, weaponForm, nullptr, 1, slot, false, true, false, nullptr);
-          
-  EquipManager::s_suppressDrawSound = false;
+            // Silent equip through the command buffer (applied immediately - tasks run outside the frame)
+            EquipCommandBuffer::GetSingleton()->QueueEquip(weaponForm, m_equipToLeftHand, false);
             _MESSAGE("[DelayedEquipWeapon] Equipped weapon %08X to %s hand (silent)", m_weaponFormId, m_equipToLeftHand ? "LEFT" : "RIGHT");
         }
 
@@ -150,6 +137,13 @@ namespace FalseEdgeVR
     Actor* actor = DYNAMIC_CAST(evn->actor, TESObjectREFR, Actor);
         if (!actor)
      return kEvent_Continue;
+        
+        // Any player equip/unequip invalidates the cached equipment for all trackers
+        if (actor == *g_thePlayer)
+        {
+            EquipManager::GetSingleton()->BumpEquipGeneration();
+            EquipCommandBuffer::GetSingleton()->NoteEquipEvent();
+        }
 
         TESForm* item = LookupFormByID(evn->baseObject);
         if (!item)
@@ -467,6 +461,59 @@ EquipManager::GetSingleton()->OnEquip(item, actor, isLeftHand);
      LogEquipmentState();
     }
 
+    // ============================================
+    // Equipment Generation
+    // ============================================
+
+    void EquipManager::BumpEquipGeneration()
+    {
+        m_equipGeneration.fetch_add(1, std::memory_order_acq_rel);
+        TrackingDormancy::GetSingleton()->Wake("equip");
+    }
+
+    TESForm* EquipManager::GetEquippedObject(bool isLeftHand)
+    {
+        // Snapshot before querying - a bump during the query leaves the cache stale, so the next call re-resolves
+        UInt32 generation = GetEquipGeneration();
+        if (m_resolvedGeneration != generation)
+        {
+            PlayerCharacter* player = *g_thePlayer;
+            m_resolvedEquippedLeft = player ? player->GetEquippedObject(true) : nullptr;
+            m_resolvedEquippedRight = player ? player->GetEquippedObject(false) : nullptr;
+            m_resolvedGeneration = generation;
+        }
+
+        return isLeftHand ? m_resolvedEquippedLeft : m_resolvedEquippedRight;
+    }
+
+    void EquipManager::CheckEquipConsistency(float deltaTime)
+    {
+        m_consistencyCheckTimer += deltaTime;
+        if (m_consistencyCheckTimer < 1.0f)
+            return;
+        m_consistencyCheckTimer = 0.0f;
+
+        // Nothing cached yet - the next GetEquippedObject call resolves fresh anyway
+        if (m_resolvedGeneration != GetEquipGeneration())
+            return;
+
+        PlayerCharacter* player = *g_thePlayer;
+        if (!player)
+            return;
+
+        TESForm* leftItem = player->GetEquippedObject(true);
+        TESForm* rightItem = player->GetEquippedObject(false);
+        if (leftItem != m_resolvedEquippedLeft || rightItem != m_resolvedEquippedRight)
+        {
+            m_consistencyMismatchCount++;
+            _MESSAGE("EquipManager: Equipment changed without event (Left: %08X->%08X, Right: %08X->%08X) - bumping generation (mismatches: %d)",
+                m_resolvedEquippedLeft ? m_resolvedEquippedLeft->formID : 0, leftItem ? leftItem->formID : 0,
+                m_resolvedEquippedRight ? m_resolvedEquippedRight->formID : 0, rightItem ? rightItem->formID : 0,
+                m_consistencyMismatchCount);
+            BumpEquipGeneration();
+        }
+    }
+
   // Check if a weapon is from Interactive Pipe Smoking VR mod and should be excluded from draw sounds
     // Returns true if the weapon should NOT play a draw sound
     static bool IsPipeSmokingWeapon(UInt32 weaponFormID)
@@ -762,8 +809,7 @@ modIndex = modInfo->GetPartialIndex();
         // Only track weapons (not shields)
  if (type != WeaponType::Shield && type != WeaponType::None)
         {
-    std::lock_guard<std::mutex> lock(s_sheathMutex);
-      s_lastEquipTimes[item->formID] = std::chrono::steady_clock::now();
+      s_sheathCooldowns.Record(item->formID);
    _MESSAGE("EquipManager: Recorded equip time for weapon %08X (5s sheath sound cooldown started)", item->formID);
         }
      
@@ -838,22 +884,13 @@ modIndex = modInfo->GetPartialIndex();
     bool shouldExclude = IsExcludedItem(item->formID);
         
       // Check draw sound cooldown (5 seconds from last unequip of same weapon)
-     bool onDrawCooldown = false;
-        {
-    std::lock_guard<std::mutex> lock(s_drawMutex);
-       auto it = s_lastUnequipTimes.find(item->formID);
-    if (it != s_lastUnequipTimes.end())
+     UInt32 drawElapsedMs = 0;
+     bool onDrawCooldown = s_drawCooldowns.IsCoolingDown(item->formID, DRAW_SOUND_COOLDOWN_SECONDS * 1000, drawElapsedMs);
+     if (onDrawCooldown)
      {
-     auto now = std::chrono::steady_clock::now();
-          auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - it->second).count();
-       if (elapsed < DRAW_SOUND_COOLDOWN_SECONDS)
-       {
-            onDrawCooldown = true;
-    _MESSAGE("EquipManager: Draw sound on cooldown for %08X (%lld/%d seconds since unequip)", 
-     item->formID, elapsed, DRAW_SOUND_COOLDOWN_SECONDS);
-         }
-}
-        }
+    _MESSAGE("EquipManager: Draw sound on cooldown for %08X (%u/%d seconds since unequip)", 
+     item->formID, drawElapsedMs / 1000, DRAW_SOUND_COOLDOWN_SECONDS);
+     }
       
         switch (type)
         {
@@ -913,8 +950,7 @@ modIndex = modInfo->GetPartialIndex();
       // Only track weapons (not shields)
    if (type != WeaponType::Shield && type != WeaponType::None)
         {
-    std::lock_guard<std::mutex> lock(s_drawMutex);
-      s_lastUnequipTimes[item->formID] = std::chrono::steady_clock::now();
+      s_drawCooldowns.Record(item->formID);
    _MESSAGE("EquipManager: Recorded unequip time for weapon %08X (5s draw sound cooldown started)", item->formID);
         }
         
@@ -944,21 +980,12 @@ modIndex = modInfo->GetPartialIndex();
         bool shouldExclude = IsExcludedItem(item->formID);
         
   // Check sheath sound cooldown (5 seconds from last equip of same weapon)
- bool onSheathCooldown = false;
-  {
-std::lock_guard<std::mutex> lock(s_sheathMutex);
-        auto it = s_lastEquipTimes.find(item->formID);
-   if (it != s_lastEquipTimes.end())
+ UInt32 sheathElapsedMs = 0;
+ bool onSheathCooldown = s_sheathCooldowns.IsCoolingDown(item->formID, SHEATH_SOUND_COOLDOWN_SECONDS * 1000, sheathElapsedMs);
+ if (onSheathCooldown)
         {
-    auto now = std::chrono::steady_clock::now();
-                auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - it->second).count();
-                if (elapsed < SHEATH_SOUND_COOLDOWN_SECONDS)
-      {
-      onSheathCooldown = true;
-          _MESSAGE("EquipManager: Sheath sound on cooldown for %08X (%lld/%d seconds since equip)", 
-            item->formID, elapsed, SHEATH_SOUND_COOLDOWN_SECONDS);
-                }
-            }
+          _MESSAGE("EquipManager: Sheath sound on cooldown for %08X (%u/%d seconds since equip)", 
+            item->formID, sheathElapsedMs / 1000, SHEATH_SOUND_COOLDOWN_SECONDS);
         }
         
         switch (type)
@@ -1234,61 +1261,10 @@ return true;
         isLeftHand ? "Left" : "Right", 
      item->formID);
 
- // Get the EquipManager singleton from the game
-    ::EquipManager* equipManager = ::EquipManager::GetSingleton();
-        if (!equipManager)
-        {
-   _MESSAGE("EquipManager::ForceUnequipHand - Failed to get game EquipManager!");
-  return;
-        }
-
-        // Get container changes to find the equipped item's extra data
-        ExtraContainerChanges* containerChanges = static_cast<ExtraContainerChanges*>(
-   player->extraData.GetByType(kExtraData_ContainerChanges));
-      
-        if (!containerChanges || !containerChanges->data)
-    {
-      _MESSAGE("EquipManager::ForceUnequipHand - No container changes data!");
-   return;
-   }
-
-     // Find the inventory entry for this item
- InventoryEntryData* entryData = containerChanges->data->FindItemEntry(item);
-     if (!entryData)
-   {
-        _MESSAGE("EquipManager::ForceUnequipHand - Item not found in inventory!");
- return;
-        }
-
-      // Get the extra data lists for worn items
-        BaseExtraList* rightEquipList = NULL;
-      BaseExtraList* leftEquipList = NULL;
-        entryData->GetExtraWornBaseLists(&rightEquipList, &leftEquipList);
+ // Unequip the item (silent - applied by EquipCommandBuffer)
+        EquipCommandBuffer::GetSingleton()->QueueUnequip(item, isLeftHand);
 
-    // Get the correct equip list and slot based on hand
-        BaseExtraList* equipList = isLeftHand ? leftEquipList : rightEquipList;
-     BGSEquipSlot* equipSlot = isLeftHand ? GetLeftHandSlot() : GetRightHandSlot();
-
-        if (!equipList)
-        {
- _MESSAGE("EquipManager::ForceUnequipHand - No equip list found for %s hand!", 
-     isLeftHand ? "Left" : "Right");
-            return;
-        }
-
- // Remove CannotWear flag if present
-        BSExtraData* xCannotWear = equipList->GetByType(kExtraData_CannotWear);
-  if (xCannotWear)
-        {
-    equipList->Remove(kExtraData_CannotWear, xCannotWear);
-        }
-
-      // Unequip the item (silent - no sound, no message)
-        s_suppressSheathSound = true;
-  CALL_MEMBER_FN(equipManager, UnequipItem)(player, item, equipList, 1, equipSlot, false, true, true, false, NULL);
-        s_suppressSheathSound = false;
-
-    _MESSAGE("EquipManager: Force unequip command sent for %s hand (silent)", isLeftHand ? "Left" : "Right");
+    _MESSAGE("EquipManager: Force unequip command queued for %s hand (silent)", isLeftHand ? "Left" : "Right");
 }
 
     void EquipManager::ForceUnequipLeftHand()
@@ -1327,16 +1303,20 @@ return true;
          return;
      }
 
-     ::EquipManager* equipMan = ::EquipManager::GetSingleton();
-     if (!equipMan)
-     {
-         _MESSAGE("EquipManager::ForceReequipHand - EquipManager not available!");
-         return;
-     }
-    
-      // Get the appropriate slot for left or right hand
-        BGSEquipSlot* slot = isLeftHand ? GetLeftHandSlot() : GetRightHandSlot();
- 
+     // Clear the pending re-equip now - the equip itself is applied by EquipCommandBuffer
+     ClearPendingReequip(isLeftHand);
+     EquipCommandBuffer::GetSingleton()->QueueEquip(weaponForm, isLeftHand, false, EquipFollowUp::Reequip);
+
+     _MESSAGE("EquipManager: FORCE RE-EQUIP queued for %s hand (FormID: %08X)",
+         isLeftHand ? "Left" : "Right", cachedFormID);
+}
+
+    BaseExtraList* EquipManager::FindReequipExtraList(TESForm* weaponForm, bool isLeftHand)
+    {
+        PlayerCharacter* player = *g_thePlayer;
+        if (!player)
+            return nullptr;
+
     // ============================================
 // FIND THE CORRECT INVENTORY ITEM WITH TEMPERING/ENCHANTMENT
       // We need to find the item with matching health value (tempering) AND enchantment
@@ -1440,12 +1420,18 @@ else
   {
   _MESSAGE("EquipManager::ForceReequipHand - Weapon is base (not tempered/enchanted), using standard equip");
         }
-      
-        // Equip with the found extra data (or nullptr for base weapon)
-   CALL_MEMBER_FN(equipMan, EquipItem)(player, weaponForm, extraDataToUse, 1, slot, false, true, false, nullptr);
-     
-        _MESSAGE("EquipManager: FORCE RE-EQUIPPED to %s hand (FormID: %08X, ExtraData: %p) - direct call", 
-            isLeftHand ? "Left" : "Right", cachedFormID, extraDataToUse);
+
+        return extraDataToUse;
+    }
+
+    void EquipManager::FinishReequip(TESForm* weaponForm, bool isLeftHand, BaseExtraList* extraDataUsed)
+    {
+        PlayerCharacter* player = *g_thePlayer;
+        if (!player)
+            return;
+
+        _MESSAGE("EquipManager: FORCE RE-EQUIPPED to %s hand (FormID: %08X, ExtraData: %p)", 
+            isLeftHand ? "Left" : "Right", weaponForm->formID, extraDataUsed);
   
      // ============================================
         // RESTORE FAVORITE STATE IF NEEDED
@@ -1501,8 +1487,7 @@ xHotkey->hotkey = -1;
         }
   }
 
-    // Clear the pending re-equip and cached data for this hand
-    ClearPendingReequip(isLeftHand);
+    // Clear the cached data for this hand
   if (isLeftHand)
   {
         m_cachedWeaponFormIDLeft = 0;
@@ -1782,16 +1767,17 @@ isLeftGameHand ? "Left" : "Right");
             }
         }
 
-BSExtraData* xCannotWear = equipList->GetByType(kExtraData_CannotWear);
-   if (xCannotWear)
-        {
- equipList->Remove(kExtraData_CannotWear, xCannotWear);
+   // Unequip the item (silent) - the world copy is spawned and grabbed once the buffer applies it
+   EquipCommandBuffer::GetSingleton()->QueueUnequip(item, isLeftGameHand, EquipFollowUp::SpawnAndGrab);
     }
 
-   // Unequip the item (silent - no sound, no message)
-   s_suppressSheathSound = true;
-   CALL_MEMBER_FN(equipManager, UnequipItem)(player, item, equipList, 1, equipSlot, false, true, true, false, NULL);
-   s_suppressSheathSound = false;
+    void EquipManager::SpawnAndGrabUnequipped(TESForm* item, bool isLeftGameHand)
+    {
+        PlayerCharacter* player = *g_thePlayer;
+        if (!player)
+            return;
+
+        bool bothHandsSameWeapon = isLeftGameHand ? m_wasDualWieldingSameWeaponLeft : m_wasDualWieldingSameWeaponRight;
 
    _MESSAGE("EquipManager: Item unequipped (silent), now creating world object for HIGGS grab...");
 
@@ -1812,7 +1798,7 @@ BSExtraData* xCannotWear = equipList->GetByType(kExtraData_CannotWear);
             rootNode = player->GetNiRootNode(1);
         }
         
-        NiPoint3 spawnPos = player->pos;
+        NiPoint3 spawnPos = GetWeaponSpawnPosition(player);
         
         // Check if player is mounted
       NiPointer<Actor> mountActor;
@@ -1823,11 +1809,6 @@ BSExtraData* xCannotWear = equipList->GetByType(kExtraData_CannotWear);
           // MOUNTED: Spawn at player position with configurable mounted offsets
           _MESSAGE("EquipManager: Player is MOUNTED - spawning weapon with mounted offsets from player");
 
-          // Simple offset from player world position (mounted settings)
-          spawnPos.x = player->pos.x + spawnOffsetMountedX;
-          spawnPos.y = player->pos.y + spawnOffsetMountedY;
-          spawnPos.z = player->pos.z + spawnOffsetMountedZ;
-
           _MESSAGE("EquipManager: Spawning weapon at player + mounted offset (%.2f, %.2f, %.2f)",
               spawnPos.x, spawnPos.y, spawnPos.z);
       }
@@ -1836,17 +1817,13 @@ BSExtraData* xCannotWear = equipList->GetByType(kExtraData_CannotWear);
           // NOT MOUNTED: Spawn at player position with configurable offsets
           _MESSAGE("EquipManager: Player is NOT mounted - spawning weapon with offsets from player");
 
-          // Simple offset from player world position
-          spawnPos.x = player->pos.x + spawnOffsetX;
-          spawnPos.y = player->pos.y + spawnOffsetY;
-          spawnPos.z = player->pos.z + spawnOffsetZ;
-
           _MESSAGE("EquipManager: Spawning weapon at player + offset (%.2f, %.2f, %.2f)",
               spawnPos.x, spawnPos.y, spawnPos.z);
         }
 
-      // Step 3: Create a world object using PlaceAtMe
-      TESObjectREFR* droppedWeapon = PlaceAtMe_Native(nullptr, 0, player, item, 1, false, false);
+      // Step 3: Get a world object - a parked ref from WeaponRefPool, or a new PlaceAtMe copy
+      bool usePool = WeaponRefPool::GetSingleton()->IsEnabled();
+      TESObjectREFR* droppedWeapon = WeaponRefPool::GetSingleton()->Acquire(item, spawnPos);
 
       if (droppedWeapon)
       {
@@ -1862,24 +1839,32 @@ BSExtraData* xCannotWear = equipList->GetByType(kExtraData_CannotWear);
   // Step 3.5: Remove the item from inventory to prevent duplication
   // PlaceAtMe creates a COPY, so we need to remove the original from inventory
         // EXCEPTION: If both hands have the same weapon, don't remove - we need it for the other hand!
-        if (!bothHandsSameWeapon)
+        // EXCEPTION: Pooled refs are proxies - the inventory item stays and the ref goes back to the pool on re-equip
+        if (!bothHandsSameWeapon && !usePool)
         {
     RemoveItemFromInventory(player, item, 1, true);
   _MESSAGE("EquipManager: Removed 1x item from inventory to prevent duplication");
         }
+     else if (usePool)
+        {
+            _MESSAGE("EquipManager: SKIPPING inventory removal - pooled proxy ref, inventory item kept");
+        }
      else
    {
             _MESSAGE("EquipManager: SKIPPING inventory removal - same weapon in both hands, need it for other hand");
         }
 
  // Store the reference (by GAME hand)
+ RefTableHandle& droppedHandle = isLeftGameHand ? m_droppedWeaponHandleLeft : m_droppedWeaponHandleRight;
+ RefHandleTable::GetSingleton()->Release(droppedHandle);
+ droppedHandle = RefHandleTable::GetSingleton()->Acquire(droppedWeapon);
  if (isLeftGameHand)
    {
-      m_droppedWeaponLeft = droppedWeapon;
+      m_droppedWeaponPooledLeft = usePool;
  }
      else
           {
-   m_droppedWeaponRight = droppedWeapon;
+      m_droppedWeaponPooledRight = usePool;
        }
 
             // Step 4: Use HIGGS to grab the object
@@ -1922,7 +1907,7 @@ BSExtraData* xCannotWear = equipList->GetByType(kExtraData_CannotWear);
         if (!higgsInterface)
             return false;
             
-        TESObjectREFR* droppedRef = isLeftHand ? m_droppedWeaponLeft : m_droppedWeaponRight;
+        TESObjectREFR* droppedRef = GetDroppedWeaponRef(isLeftHand);
         if (!droppedRef)
       return false;
       
@@ -1932,18 +1917,20 @@ BSExtraData* xCannotWear = equipList->GetByType(kExtraData_CannotWear);
 
     TESObjectREFR* EquipManager::GetDroppedWeaponRef(bool isLeftHand) const
     {
-      return isLeftHand ? m_droppedWeaponLeft : m_droppedWeaponRight;
+      return RefHandleTable::GetSingleton()->Resolve(isLeftHand ? m_droppedWeaponHandleLeft : m_droppedWeaponHandleRight);
     }
 
     void EquipManager::ClearDroppedWeaponRef(bool isLeftHand)
     {
         if (isLeftHand)
     {
-          m_droppedWeaponLeft = nullptr;
+          RefHandleTable::GetSingleton()->Release(m_droppedWeaponHandleLeft);
+          m_droppedWeaponPooledLeft = false;
      }
         else
    {
- m_droppedWeaponRight = nullptr;
+ RefHandleTable::GetSingleton()->Release(m_droppedWeaponHandleRight);
+          m_droppedWeaponPooledRight = false;
     }
     }
 
@@ -1966,6 +1953,36 @@ BSExtraData* xCannotWear = equipList->GetByType(kExtraData_CannotWear);
         return isLeftHand ? m_wasDualWieldingSameWeaponLeft : m_wasDualWieldingSameWeaponRight;
     }
 
+    bool EquipManager::IsDroppedWeaponProxy(bool isLeftHand) const
+    {
+        return WasDualWieldingSameWeapon(isLeftHand) || IsDroppedWeaponPooled(isLeftHand);
+    }
+
+    NiPoint3 EquipManager::GetWeaponSpawnPosition(PlayerCharacter* player)
+    {
+        NiPoint3 spawnPos = player->pos;
+
+        NiPointer<Actor> mountActor;
+        bool isMounted = CALL_MEMBER_FN(player, GetMount)(mountActor) && mountActor;
+
+        if (isMounted)
+        {
+            // Mounted: elevated to avoid horse collision
+            spawnPos.x += spawnOffsetMountedX;
+            spawnPos.y += spawnOffsetMountedY;
+            spawnPos.z += spawnOffsetMountedZ;
+        }
+        else
+        {
+            // Not mounted: offset so the player can't see it
+            spawnPos.x += spawnOffsetX;
+            spawnPos.y += spawnOffsetY;
+            spawnPos.z += spawnOffsetZ;
+        }
+
+        return spawnPos;
+    }
+
     void EquipManager::CheckPendingAutoUnequip()
     {
         if (!m_pendingAutoUnequipForm)
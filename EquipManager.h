@@ -5,6 +5,8 @@
 #include "skse64/GameEvents.h"
 #include "skse64/GameRTTI.h"
 #include "config.h"
+#include "RefHandleTable.h"
+#include <atomic>
 
 namespace FalseEdgeVR
 {
@@ -110,6 +112,19 @@ namespace FalseEdgeVR
         
    // Get current equipment state
         const PlayerEquipState& GetEquipState() const { return m_equipState; }
+        
+        // Generation counter - bumped by EquipEventHandler on every player equip/unequip
+        // Trackers compare this once per frame and only re-resolve equipment when it changes
+        // Atomic - the equip event sinks may bump it off the game thread
+        UInt32 GetEquipGeneration() const { return m_equipGeneration.load(std::memory_order_acquire); }
+        void BumpEquipGeneration();
+        
+        // Player's equipped object per hand, re-resolved only when the generation changes
+        TESForm* GetEquippedObject(bool isLeftHand);
+        
+        // Background consistency check (once per second) - bumps the generation if the game changed
+        // equipment without an equip event reaching us
+        void CheckEquipConsistency(float deltaTime);
  
         // Check if player has only one weapon equipped
    bool HasSingleWeaponEquipped() const { return m_equipState.HasOneWeaponEquipped(); }
@@ -178,6 +193,29 @@ namespace FalseEdgeVR
         // Track if we're in dual-wield same weapon mode (for cleanup after re-equip)
         bool WasDualWieldingSameWeapon(bool isLeftHand) const;
         
+        // Whether the dropped weapon ref is a proxy (inventory item kept) - same weapon in both hands or pooled ref
+        // Proxies are returned to WeaponRefPool on re-equip instead of being activated
+        bool IsDroppedWeaponProxy(bool isLeftHand) const;
+        
+        // Whether the dropped weapon ref came from WeaponRefPool (inventory item kept)
+        bool IsDroppedWeaponPooled(bool isLeftHand) const { return isLeftHand ? m_droppedWeaponPooledLeft : m_droppedWeaponPooledRight; }
+        
+        // World position where avoidance spawns weapons for HIGGS (behind/below player, or mounted offsets)
+        static NiPoint3 GetWeaponSpawnPosition(PlayerCharacter* player);
+        
+        // ============================================
+        // EquipCommandBuffer follow-ups (run once the buffered game call has been applied)
+        // ============================================
+        
+        // Spawn the world copy of a weapon unequipped by ForceUnequipAndGrab and hand it to HIGGS
+        void SpawnAndGrabUnequipped(TESForm* item, bool isLeftGameHand);
+        
+        // Inventory entry matching the cached tempering/enchantment for ForceReequipHand (nullptr = base weapon)
+        BaseExtraList* FindReequipExtraList(TESForm* weaponForm, bool isLeftHand);
+        
+        // Restore favorite state and clear the re-equip caches after ForceReequipHand's equip
+        void FinishReequip(TESForm* weaponForm, bool isLeftHand, BaseExtraList* extraDataUsed);
+        
    // Check and process pending auto-unequip (for trigger-based weapon hold)
         void CheckPendingAutoUnequip();
         
@@ -194,6 +232,14 @@ namespace FalseEdgeVR
 
   PlayerEquipState m_equipState;
         
+        // Equipment generation tracking
+        std::atomic<UInt32> m_equipGeneration{ 1 };
+        UInt32 m_resolvedGeneration = 0;
+        TESForm* m_resolvedEquippedLeft = nullptr;
+        TESForm* m_resolvedEquippedRight = nullptr;
+        float m_consistencyCheckTimer = 0.0f;
+        int m_consistencyMismatchCount = 0;
+        
    // Pending re-equip tracking - store FormID instead of pointer
         TESForm* m_pendingReequipLeft = nullptr;
         TESForm* m_pendingReequipRight = nullptr;
@@ -217,9 +263,11 @@ namespace FalseEdgeVR
    bool m_wasFavoritedLeft = false;
         bool m_wasFavoritedRight = false;
         
-        // Dropped weapon world references
-      TESObjectREFR* m_droppedWeaponLeft = nullptr;
-        TESObjectREFR* m_droppedWeaponRight = nullptr;
+        // Dropped weapon world references (RefHandleTable - resolve through GetDroppedWeaponRef)
+        RefTableHandle m_droppedWeaponHandleLeft = 0;
+        RefTableHandle m_droppedWeaponHandleRight = 0;
+        bool m_droppedWeaponPooledLeft = false;    // Dropped ref came from WeaponRefPool (inventory item kept)
+        bool m_droppedWeaponPooledRight = false;
         
         // Track if we were dual-wielding same weapon when collision was triggered
         // This is needed to know if we should clean up the duplicate after re-equip
@@ -118,34 +118,8 @@ namespace FalseEdgeVR
 
 	UInt32 GetFullFormIdMine(const char* espName, UInt32 baseFormId)
 	{
-		UInt32 fullFormID = 0;
-
-		std::string espNameStr = espName;
-		std::transform(espNameStr.begin(), espNameStr.end(), espNameStr.begin(), ::tolower);
-
-		if (espNameStr == "skyrim.esm")
-		{
-			fullFormID = baseFormId;
-		}
-		else
-		{
-			DataHandler* dataHandler = DataHandler::GetSingleton();
-
-			if (dataHandler)
-			{
-				std::pair<const char*, UInt32> formIdPair = { espName, baseFormId };
-				
-				const ModInfo* modInfo = NEWLookupAllLoadedModByName(formIdPair.first);
-				if (modInfo)
-				{
-					if (IsValidModIndex(modInfo->modIndex)) //If plugin is in the load order.
-					{
-						fullFormID = GetFullFormID(modInfo, GetBaseFormID(formIdPair.second));
-					}
-				}
-			}
-		}
-		return fullFormID;
+		// Hashed plugin lookup + memoized result (SkyrimVRESLAPI)
+		return GetFullFormIdMemoized(espName, baseFormId);
 	}
 
 	void RemoveItemFromInventory(TESObjectREFR* target, TESForm* item, SInt32 count, bool silent)
@@ -0,0 +1,448 @@
+#include "HostileIndex.h"
+#include "config.h"
+#include "skse64/GameForms.h"
+#include "skse64/GameRTTI.h"
+#include "common/IDebugLog.h"
+#include <cmath>
+
+namespace FalseEdgeVR
+{
+    HostileIndex* HostileIndex::GetSingleton()
+    {
+        static HostileIndex instance;
+        return &instance;
+    }
+
+    HostileIndex::HostileIndex()
+    {
+        for (int i = 0; i < kBucketCount; i++)
+        {
+            m_buckets[i] = kNone;
+        }
+        for (int i = 0; i < kFormSlotCount; i++)
+        {
+            m_formSlots[i] = kNone;
+        }
+    }
+
+    UInt64 HostileIndex::CellKeyFor(const NiPoint3& pos) const
+    {
+        SInt32 cx = (SInt32)std::floor(pos.x / m_cellSize);
+        SInt32 cy = (SInt32)std::floor(pos.y / m_cellSize);
+        return ((UInt64)(UInt32)cx << 32) | (UInt32)cy;
+    }
+
+    UInt32 HostileIndex::BucketFor(UInt64 cellKey)
+    {
+        return (UInt32)((cellKey * 0x9E3779B97F4A7C15ULL) >> 58) & (kBucketCount - 1);
+    }
+
+    void HostileIndex::LinkIntoBucket(UInt16 index)
+    {
+        UInt32 bucket = BucketFor(m_entries[index].cellKey);
+        m_entries[index].next = m_buckets[bucket];
+        m_buckets[bucket] = index;
+    }
+
+    void HostileIndex::UnlinkFromBucket(UInt16 index)
+    {
+        UInt16* link = &m_buckets[BucketFor(m_entries[index].cellKey)];
+        while (*link != kNone)
+        {
+            if (*link == index)
+            {
+                *link = m_entries[index].next;
+                break;
+            }
+            link = &m_entries[*link].next;
+        }
+        m_entries[index].next = kNone;
+    }
+
+    UInt32 HostileIndex::FormSlotFor(UInt32 formID)
+    {
+        return (formID * 0x9E3779B1u) >> (32 - kFormSlotBits);
+    }
+
+    UInt16 HostileIndex::FindEntry(UInt32 formID) const
+    {
+        UInt32 slot = FormSlotFor(formID);
+        for (int probe = 0; probe < kFormSlotCount; probe++)
+        {
+            UInt16 index = m_formSlots[slot];
+            if (index == kNone)
+                return kNone;
+            if (m_entries[index].formID == formID)
+                return index;
+            slot = (slot + 1) & (kFormSlotCount - 1);
+        }
+        return kNone;
+    }
+
+    void HostileIndex::InsertFormSlot(UInt16 index)
+    {
+        // Twice as many slots as entries - there is always a free one
+        UInt32 slot = FormSlotFor(m_entries[index].formID);
+        while (m_formSlots[slot] != kNone)
+        {
+            slot = (slot + 1) & (kFormSlotCount - 1);
+        }
+        m_formSlots[slot] = index;
+    }
+
+    void HostileIndex::EraseFormSlot(UInt32 formID)
+    {
+        const UInt32 mask = kFormSlotCount - 1;
+
+        UInt32 hole = FormSlotFor(formID);
+        while (m_formSlots[hole] != kNone && m_entries[m_formSlots[hole]].formID != formID)
+        {
+            hole = (hole + 1) & mask;
+        }
+        if (m_formSlots[hole] == kNone)
+            return;
+
+        // Pull later entries of the run back into the hole unless that would put them before their home slot
+        UInt32 slot = hole;
+        while (true)
+        {
+            slot = (slot + 1) & mask;
+            UInt16 index = m_formSlots[slot];
+            if (index == kNone)
+                break;
+
+            UInt32 home = FormSlotFor(m_entries[index].formID);
+            if (((slot - home) & mask) < ((slot - hole) & mask))
+                continue;
+
+            m_formSlots[hole] = index;
+            hole = slot;
+        }
+        m_formSlots[hole] = kNone;
+    }
+
+    void HostileIndex::NoteCell(TESObjectCELL* cell)
+    {
+        if (!cell)
+            return;
+
+        // Empty slot first, else the cell no actor has stood in for longest
+        int target = -1;
+        for (int i = 0; i < kMaxScanCells; i++)
+        {
+            const ScanCell& slot = m_scanCells[i];
+            if (slot.formID == cell->formID)
+            {
+                m_scanCells[i].lastSeenUpdate = m_updateCount;
+                return;
+            }
+            if (target < 0)
+            {
+                target = i;
+            }
+            else if (m_scanCells[target].formID != 0 &&
+                (slot.formID == 0 || slot.lastSeenUpdate < m_scanCells[target].lastSeenUpdate))
+            {
+                target = i;
+            }
+        }
+
+        // Replacing the cell being walked - restart the cursor on the new one
+        if (target == m_scanCellIndex)
+            m_scanCursor = 0;
+        m_scanCells[target].formID = cell->formID;
+        m_scanCells[target].lastSeenUpdate = m_updateCount;
+    }
+
+    bool HostileIndex::Upsert(UInt32 formID, const NiPoint3& pos)
+    {
+        UInt16 existing = FindEntry(formID);
+        if (existing != kNone)
+        {
+            Entry& entry = m_entries[existing];
+            UInt64 cellKey = CellKeyFor(pos);
+            entry.pos = pos;
+            if (cellKey != entry.cellKey)
+            {
+                // Moved to another grid cell
+                UnlinkFromBucket(existing);
+                entry.cellKey = cellKey;
+                LinkIntoBucket(existing);
+            }
+            return true;
+        }
+
+        for (UInt16 i = 0; i < kMaxEntries; i++)
+        {
+            Entry& entry = m_entries[i];
+            if (entry.inUse)
+                continue;
+
+            entry.formID = formID;
+            entry.pos = pos;
+            entry.cellKey = CellKeyFor(pos);
+            entry.inUse = true;
+            LinkIntoBucket(i);
+            InsertFormSlot(i);
+            m_trackedCount++;
+            return true;
+        }
+
+        m_fullCount++;
+        return false;
+    }
+
+    void HostileIndex::Remove(UInt16 index)
+    {
+        Entry& entry = m_entries[index];
+        if (!entry.inUse)
+            return;
+
+        UnlinkFromBucket(index);
+        EraseFormSlot(entry.formID);
+        entry.inUse = false;
+        entry.formID = 0;
+        m_trackedCount--;
+    }
+
+    bool HostileIndex::IsHostile(Actor* actor, PlayerCharacter* player, TESObjectREFR* playerTarget)
+    {
+        if (!actor || actor == player || actor->IsDead(1) || !actor->IsInCombat())
+            return false;
+
+        if (actor == playerTarget)
+            return true;
+
+        UInt32 targetHandle = actor->currentCombatTarget;
+        if (targetHandle == 0 || targetHandle == *g_invalidRefHandle)
+            return false;
+
+        NiPointer<TESObjectREFR> target;
+        return LookupREFRByHandle(targetHandle, target) && target == player;
+    }
+
+    void HostileIndex::Update(PlayerCharacter* player)
+    {
+        if (!player)
+            return;
+
+        // Grid cells are as wide as the exit distance, so the 3x3 query covers the whole hysteresis band
+        float cellSize = closeCombatExitDistance > 1.0f ? closeCombatExitDistance : 1.0f;
+        if (cellSize != m_cellSize)
+        {
+            m_cellSize = cellSize;
+            for (UInt16 i = 0; i < kMaxEntries; i++)
+            {
+                if (m_entries[i].inUse)
+                    UnlinkFromBucket(i);
+            }
+            for (UInt16 i = 0; i < kMaxEntries; i++)
+            {
+                if (m_entries[i].inUse)
+                {
+                    m_entries[i].cellKey = CellKeyFor(m_entries[i].pos);
+                    LinkIntoBucket(i);
+                }
+            }
+        }
+
+        NiPoint3 playerPos = player->pos;
+        float radiusSq = closeCombatHostileScanRadius * closeCombatHostileScanRadius;
+        int budget = closeCombatHostileScanBudget > 0 ? closeCombatHostileScanBudget : 1;
+
+        TESObjectREFR* playerTarget = nullptr;
+        NiPointer<TESObjectREFR> playerTargetRef;
+        if (player->currentCombatTarget != 0 && player->currentCombatTarget != *g_invalidRefHandle &&
+            LookupREFRByHandle(player->currentCombatTarget, playerTargetRef))
+        {
+            playerTarget = playerTargetRef;
+        }
+
+        // Cells worth walking: the player's, and wherever the fight is
+        NoteCell(player->parentCell);
+        if (playerTarget)
+            NoteCell(playerTarget->parentCell);
+
+        // 1) Refresh tracked hostiles (round robin) - they move every frame
+        int refreshCount = m_trackedCount < budget ? m_trackedCount : budget;
+        for (int n = 0; n < refreshCount; n++)
+        {
+            int index = -1;
+            for (int step = 0; step < kMaxEntries; step++)
+            {
+                int candidate = (m_refreshCursor + step) % kMaxEntries;
+                if (m_entries[candidate].inUse)
+                {
+                    index = candidate;
+                    break;
+                }
+            }
+            if (index < 0)
+                break;
+            m_refreshCursor = (index + 1) % kMaxEntries;
+
+            TESForm* form = LookupFormByID(m_entries[index].formID);
+            Actor* actor = form ? DYNAMIC_CAST(form, TESForm, Actor) : nullptr;
+            budget--;
+            m_refsVisited++;
+
+            if (!actor || (actor->flags & TESForm::kFlagIsDeleted) || !IsHostile(actor, player, playerTarget))
+            {
+                Remove((UInt16)index);
+                continue;
+            }
+
+            NiPoint3 pos = actor->pos;
+            float dx = pos.x - playerPos.x;
+            float dy = pos.y - playerPos.y;
+            float dz = pos.z - playerPos.z;
+            if (dx * dx + dy * dy + dz * dz > radiusSq)
+            {
+                Remove((UInt16)index);
+                continue;
+            }
+
+            Upsert(m_entries[index].formID, pos);
+            NoteCell(actor->parentCell);
+        }
+
+        // 2) Spend what's left walking the loaded cells for hostiles we don't track yet - every ref costs budget
+        int cellsFinished = 0;
+        while (budget > 0 && cellsFinished < kMaxScanCells)
+        {
+            ScanCell& scanCell = m_scanCells[m_scanCellIndex];
+
+            TESObjectCELL* cell = nullptr;
+            if (scanCell.formID != 0)
+            {
+                if (m_updateCount - scanCell.lastSeenUpdate > kScanCellExpiry)
+                {
+                    scanCell = ScanCell();
+                }
+                else
+                {
+                    TESForm* form = LookupFormByID(scanCell.formID);
+                    cell = form ? DYNAMIC_CAST(form, TESForm, TESObjectCELL) : nullptr;
+                }
+            }
+
+            if (!cell || m_scanCursor >= cell->objectList.count)
+            {
+                // Next cell - back at the first one means every loaded cell has been walked
+                m_scanCellIndex = (m_scanCellIndex + 1) % kMaxScanCells;
+                m_scanCursor = 0;
+                if (m_scanCellIndex == 0)
+                    m_sweepsCompleted++;
+                cellsFinished++;
+                continue;
+            }
+
+            TESObjectREFR* ref = nullptr;
+            cell->objectList.GetNthItem(m_scanCursor++, ref);
+            budget--;
+            m_refsVisited++;
+
+            if (!ref || ref->formType != kFormType_Character)
+                continue;
+
+            if (FindEntry(ref->formID) != kNone)
+                continue;
+
+            Actor* actor = DYNAMIC_CAST(ref, TESObjectREFR, Actor);
+            if (!IsHostile(actor, player, playerTarget))
+                continue;
+
+            NiPoint3 pos = actor->pos;
+            float dx = pos.x - playerPos.x;
+            float dy = pos.y - playerPos.y;
+            float dz = pos.z - playerPos.z;
+            if (dx * dx + dy * dy + dz * dz <= radiusSq)
+            {
+                if (Upsert(actor->formID, pos))
+                {
+                    _MESSAGE("HostileIndex: Tracking hostile %08X at %.0f units (%d tracked)",
+                        actor->formID, std::sqrt(dx * dx + dy * dy + dz * dz), m_trackedCount);
+                }
+            }
+        }
+
+        QueryNearest(playerPos);
+
+        // Stats every 100 updates while in combat
+        m_updateCount++;
+        if (m_updateCount % 100 == 0)
+        {
+            int scanCells = 0;
+            for (int i = 0; i < kMaxScanCells; i++)
+            {
+                if (m_scanCells[i].formID != 0)
+                    scanCells++;
+            }
+            _MESSAGE("HostileIndex: Stats - %d tracked, %.1f refs/update over %d cells, %d sweeps, %d full, nearest %.1f (%08X)",
+                m_trackedCount, (float)m_refsVisited / 100.0f, scanCells, m_sweepsCompleted, m_fullCount, m_nearestDistance, m_nearestFormID);
+            m_refsVisited = 0;
+        }
+    }
+
+    void HostileIndex::QueryNearest(const NiPoint3& playerPos)
+    {
+        m_nearestDistance = 9999.0f;
+        m_nearestFormID = 0;
+
+        UInt64 playerKey = CellKeyFor(playerPos);
+        SInt32 px = (SInt32)(UInt32)(playerKey >> 32);
+        SInt32 py = (SInt32)(UInt32)(playerKey & 0xFFFFFFFF);
+
+        for (SInt32 ox = -1; ox <= 1; ox++)
+        {
+            for (SInt32 oy = -1; oy <= 1; oy++)
+            {
+                UInt64 cellKey = ((UInt64)(UInt32)(px + ox) << 32) | (UInt32)(py + oy);
+                for (UInt16 i = m_buckets[BucketFor(cellKey)]; i != kNone; i = m_entries[i].next)
+                {
+                    const Entry& entry = m_entries[i];
+                    if (entry.cellKey != cellKey)
+                        continue;
+
+                    float dx = entry.pos.x - playerPos.x;
+                    float dy = entry.pos.y - playerPos.y;
+                    float dz = entry.pos.z - playerPos.z;
+                    float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+                    if (dist < m_nearestDistance)
+                    {
+                        m_nearestDistance = dist;
+                        m_nearestFormID = entry.formID;
+                    }
+                }
+            }
+        }
+    }
+
+    void HostileIndex::Clear()
+    {
+        for (UInt16 i = 0; i < kMaxEntries; i++)
+        {
+            m_entries[i].inUse = false;
+            m_entries[i].formID = 0;
+            m_entries[i].next = kNone;
+        }
+        for (int i = 0; i < kBucketCount; i++)
+        {
+            m_buckets[i] = kNone;
+        }
+        for (int i = 0; i < kFormSlotCount; i++)
+        {
+            m_formSlots[i] = kNone;
+        }
+        for (int i = 0; i < kMaxScanCells; i++)
+        {
+            m_scanCells[i] = ScanCell();
+        }
+        m_trackedCount = 0;
+        m_scanCellIndex = 0;
+        m_scanCursor = 0;
+        m_refreshCursor = 0;
+        m_nearestDistance = 9999.0f;
+        m_nearestFormID = 0;
+    }
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "skse64/GameReferences.h"
+#include "skse64/NiTypes.h"
+
+namespace FalseEdgeVR
+{
+    // ============================================
+    // HostileIndex
+    // ============================================
+    // Hostile actors near the player, for close combat mode. Replaces measuring
+    // only player->currentCombatTarget, which missed flanking enemies.
+    // Entries live in a uniform XY grid (cell size = [CloseCombat] ExitDistance)
+    // so the nearest-hostile query only looks at the player's cell and its 8
+    // neighbours - everything the enter/exit hysteresis cares about.
+    // Update is time-sliced: each call touches at most [CloseCombat] HostileScanBudget
+    // refs, refreshing tracked hostiles first and spending the rest walking loaded
+    // cells for new ones. The walk covers the player's cell plus every cell a tracked
+    // hostile or the player's combat target stood in recently, so enemies across an
+    // exterior cell border are found too. Hostiles beyond HostileScanRadius are dropped.
+    // FormID lookup is a fixed open-addressing table - nothing allocates while scanning.
+    // Game thread only.
+    // ============================================
+
+    class HostileIndex
+    {
+    public:
+        static HostileIndex* GetSingleton();
+
+        // Refresh up to the scan budget of actors and recompute the nearest hostile
+        void Update(PlayerCharacter* player);
+
+        // Distance to the nearest tracked hostile within ExitDistance (9999 if none) - O(1)
+        float GetNearestDistance() const { return m_nearestDistance; }
+
+        // FormID of that hostile (0 if none)
+        UInt32 GetNearestFormID() const { return m_nearestFormID; }
+
+        int GetTrackedCount() const { return m_trackedCount; }
+
+        // Forget everything (left combat, game load)
+        void Clear();
+
+    private:
+        HostileIndex();
+        ~HostileIndex() = default;
+        HostileIndex(const HostileIndex&) = delete;
+        HostileIndex& operator=(const HostileIndex&) = delete;
+
+        static const int kMaxEntries = 128;
+        static const int kBucketCount = 64;      // Power of two
+        static const int kFormSlotBits = 8;
+        static const int kFormSlotCount = 1 << kFormSlotBits;     // 2x kMaxEntries - probes stay short
+        static const int kMaxScanCells = 8;
+        static const int kScanCellExpiry = 300;  // Updates without an actor seen in a cell before it's dropped
+        static const UInt16 kNone = 0xFFFF;
+
+        struct Entry
+        {
+            UInt32 formID = 0;
+            NiPoint3 pos;
+            UInt64 cellKey = 0;
+            UInt16 next = kNone;                  // Next entry in the same bucket
+            bool inUse = false;
+        };
+
+        // Loaded cell the scan walks, kept while actors we care about stand in it
+        struct ScanCell
+        {
+            UInt32 formID = 0;
+            int lastSeenUpdate = 0;
+        };
+
+        UInt64 CellKeyFor(const NiPoint3& pos) const;
+        static UInt32 BucketFor(UInt64 cellKey);
+
+        // Insert or move an actor; returns false if the index is full
+        bool Upsert(UInt32 formID, const NiPoint3& pos);
+        void Remove(UInt16 index);
+        void LinkIntoBucket(UInt16 index);
+        void UnlinkFromBucket(UInt16 index);
+
+        // FormID -> entry index (linear probing, backward-shift deletion)
+        static UInt32 FormSlotFor(UInt32 formID);
+        UInt16 FindEntry(UInt32 formID) const;
+        void InsertFormSlot(UInt16 index);
+        void EraseFormSlot(UInt32 formID);
+
+        // Keep a cell in the walk (refreshes it, or takes the stalest slot)
+        void NoteCell(TESObjectCELL* cell);
+
+        // Hostile to the player: alive, in combat, and fighting the player (or targeted by the player)
+        static bool IsHostile(Actor* actor, PlayerCharacter* player, TESObjectREFR* playerTarget);
+
+        // Nearest hostile in the player's cell and its neighbours
+        void QueryNearest(const NiPoint3& playerPos);
+
+        Entry m_entries[kMaxEntries];
+        UInt16 m_buckets[kBucketCount];
+        UInt16 m_formSlots[kFormSlotCount];
+        int m_trackedCount = 0;
+
+        float m_cellSize = 90.0f;
+        ScanCell m_scanCells[kMaxScanCells];
+        int m_scanCellIndex = 0;                  // Cell being walked for new hostiles
+        UInt32 m_scanCursor = 0;
+        int m_refreshCursor = 0;
+
+        float m_nearestDistance = 9999.0f;
+        UInt32 m_nearestFormID = 0;
+
+        // Stats
+        int m_updateCount = 0;
+        int m_refsVisited = 0;
+        int m_sweepsCompleted = 0;
+        int m_fullCount = 0;
+    };
+}
@@ -0,0 +1,680 @@
+#include "MeshNarrowphase.h"
+#include "WeaponProfileDB.h"
+#include "config.h"
+#include "common/IDebugLog.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace FalseEdgeVR
+{
+    // ============================================
+    // Vector helpers
+    // ============================================
+
+    static inline NiPoint3 Add(const NiPoint3& a, const NiPoint3& b) { return NiPoint3(a.x + b.x, a.y + b.y, a.z + b.z); }
+    static inline NiPoint3 Sub(const NiPoint3& a, const NiPoint3& b) { return NiPoint3(a.x - b.x, a.y - b.y, a.z - b.z); }
+    static inline NiPoint3 Scale(const NiPoint3& a, float s) { return NiPoint3(a.x * s, a.y * s, a.z * s); }
+    static inline float Dot(const NiPoint3& a, const NiPoint3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    static inline NiPoint3 Cross(const NiPoint3& a, const NiPoint3& b)
+    {
+        return NiPoint3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+    }
+    static inline float Clamp01(float v) { return v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v); }
+
+    static inline float Component(const NiPoint3& p, int axis) { return axis == 0 ? p.x : (axis == 1 ? p.y : p.z); }
+
+    // B's node space -> A's node space: p' = rot * p * scale + offset
+    struct RelativeTransform
+    {
+        float rot[3][3];
+        NiPoint3 offset;
+        float scale;
+
+        NiPoint3 Apply(const NiPoint3& p) const
+        {
+            return NiPoint3(
+                (rot[0][0] * p.x + rot[0][1] * p.y + rot[0][2] * p.z) * scale + offset.x,
+                (rot[1][0] * p.x + rot[1][1] * p.y + rot[1][2] * p.z) * scale + offset.y,
+                (rot[2][0] * p.x + rot[2][1] * p.y + rot[2][2] * p.z) * scale + offset.z);
+        }
+    };
+
+    static NiPoint3 ToWorld(const NiTransform& transform, const NiPoint3& p)
+    {
+        const NiMatrix33& rot = transform.rot;
+        return NiPoint3(
+            (rot.data[0][0] * p.x + rot.data[0][1] * p.y + rot.data[0][2] * p.z) * transform.scale + transform.pos.x,
+            (rot.data[1][0] * p.x + rot.data[1][1] * p.y + rot.data[1][2] * p.z) * transform.scale + transform.pos.y,
+            (rot.data[2][0] * p.x + rot.data[2][1] * p.y + rot.data[2][2] * p.z) * transform.scale + transform.pos.z);
+    }
+
+    // ============================================
+    // Triangle distance
+    // ============================================
+
+    static NiPoint3 ClosestPointOnTriangle(const NiPoint3& p, const NiPoint3& a, const NiPoint3& b, const NiPoint3& c)
+    {
+        NiPoint3 ab = Sub(b, a), ac = Sub(c, a), ap = Sub(p, a);
+        float d1 = Dot(ab, ap), d2 = Dot(ac, ap);
+        if (d1 <= 0.0f && d2 <= 0.0f)
+            return a;
+
+        NiPoint3 bp = Sub(p, b);
+        float d3 = Dot(ab, bp), d4 = Dot(ac, bp);
+        if (d3 >= 0.0f && d4 <= d3)
+            return b;
+
+        float vc = d1 * d4 - d3 * d2;
+        if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+            return Add(a, Scale(ab, d1 / (d1 - d3)));
+
+        NiPoint3 cp = Sub(p, c);
+        float d5 = Dot(ab, cp), d6 = Dot(ac, cp);
+        if (d6 >= 0.0f && d5 <= d6)
+            return c;
+
+        float vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+            return Add(a, Scale(ac, d2 / (d2 - d6)));
+
+        float va = d3 * d6 - d5 * d4;
+        if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+            return Add(b, Scale(Sub(c, b), (d4 - d3) / ((d4 - d3) + (d5 - d6))));
+
+        float denom = va + vb + vc;
+        if (std::fabs(denom) < 1e-12f)
+            return a;
+        float v = vb / denom, w = vc / denom;
+        return Add(a, Add(Scale(ab, v), Scale(ac, w)));
+    }
+
+    static float SegmentSegmentDistanceSq(const NiPoint3& p1, const NiPoint3& q1, const NiPoint3& p2, const NiPoint3& q2,
+        NiPoint3& outA, NiPoint3& outB)
+    {
+        NiPoint3 d1 = Sub(q1, p1), d2 = Sub(q2, p2), r = Sub(p1, p2);
+        float a = Dot(d1, d1), e = Dot(d2, d2), f = Dot(d2, r);
+        float s = 0.0f, t = 0.0f;
+
+        if (a <= 1e-12f && e <= 1e-12f)
+        {
+            s = t = 0.0f;
+        }
+        else if (a <= 1e-12f)
+        {
+            t = Clamp01(f / e);
+        }
+        else
+        {
+            float c = Dot(d1, r);
+            if (e <= 1e-12f)
+            {
+                s = Clamp01(-c / a);
+            }
+            else
+            {
+                float b = Dot(d1, d2);
+                float denom = a * e - b * b;
+                s = denom > 1e-12f ? Clamp01((b * f - c * e) / denom) : 0.0f;
+                t = (b * s + f) / e;
+                if (t < 0.0f)
+                {
+                    t = 0.0f;
+                    s = Clamp01(-c / a);
+                }
+                else if (t > 1.0f)
+                {
+                    t = 1.0f;
+                    s = Clamp01((b - c) / a);
+                }
+            }
+        }
+
+        outA = Add(p1, Scale(d1, s));
+        outB = Add(p2, Scale(d2, t));
+        NiPoint3 diff = Sub(outA, outB);
+        return Dot(diff, diff);
+    }
+
+    // Segment p..q crossing triangle abc (Moller-Trumbore)
+    static bool SegmentHitsTriangle(const NiPoint3& p, const NiPoint3& q, const NiPoint3& a, const NiPoint3& b, const NiPoint3& c, NiPoint3& outHit)
+    {
+        NiPoint3 dir = Sub(q, p);
+        NiPoint3 e1 = Sub(b, a), e2 = Sub(c, a);
+        NiPoint3 h = Cross(dir, e2);
+        float det = Dot(e1, h);
+        if (std::fabs(det) < 1e-10f)
+            return false;
+
+        float inv = 1.0f / det;
+        NiPoint3 s = Sub(p, a);
+        float u = Dot(s, h) * inv;
+        if (u < 0.0f || u > 1.0f)
+            return false;
+        NiPoint3 qv = Cross(s, e1);
+        float v = Dot(dir, qv) * inv;
+        if (v < 0.0f || u + v > 1.0f)
+            return false;
+        float t = Dot(e2, qv) * inv;
+        if (t < 0.0f || t > 1.0f)
+            return false;
+
+        outHit = Add(p, Scale(dir, t));
+        return true;
+    }
+
+    // Squared distance between triangles a[0..2] and b[0..2] with the closest points
+    static float TriangleDistanceSq(const NiPoint3* a, const NiPoint3* b, NiPoint3& outA, NiPoint3& outB)
+    {
+        // Crossing triangles - an edge of one passes through the other
+        for (int i = 0; i < 3; i++)
+        {
+            NiPoint3 hit;
+            if (SegmentHitsTriangle(a[i], a[(i + 1) % 3], b[0], b[1], b[2], hit) ||
+                SegmentHitsTriangle(b[i], b[(i + 1) % 3], a[0], a[1], a[2], hit))
+            {
+                outA = outB = hit;
+                return 0.0f;
+            }
+        }
+
+        // Otherwise the closest pair is edge-edge or vertex-face
+        float best = FLT_MAX;
+        NiPoint3 pa, pb;
+        for (int i = 0; i < 3; i++)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                float d = SegmentSegmentDistanceSq(a[i], a[(i + 1) % 3], b[j], b[(j + 1) % 3], pa, pb);
+                if (d < best)
+                {
+                    best = d;
+                    outA = pa;
+                    outB = pb;
+                }
+            }
+        }
+        for (int i = 0; i < 3; i++)
+        {
+            pb = ClosestPointOnTriangle(a[i], b[0], b[1], b[2]);
+            NiPoint3 diff = Sub(a[i], pb);
+            float d = Dot(diff, diff);
+            if (d < best)
+            {
+                best = d;
+                outA = a[i];
+                outB = pb;
+            }
+
+            pa = ClosestPointOnTriangle(b[i], a[0], a[1], a[2]);
+            diff = Sub(b[i], pa);
+            d = Dot(diff, diff);
+            if (d < best)
+            {
+                best = d;
+                outA = pa;
+                outB = b[i];
+            }
+        }
+        return best;
+    }
+
+    static float BoxDistanceSq(const NiPoint3& minA, const NiPoint3& maxA, const NiPoint3& minB, const NiPoint3& maxB)
+    {
+        float sum = 0.0f;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            float gap = std::max(Component(minB, axis) - Component(maxA, axis), Component(minA, axis) - Component(maxB, axis));
+            if (gap > 0.0f)
+                sum += gap * gap;
+        }
+        return sum;
+    }
+
+    static void TriangleBounds(const NiPoint3* corners, NiPoint3& outMin, NiPoint3& outMax)
+    {
+        outMin = NiPoint3(std::min(std::min(corners[0].x, corners[1].x), corners[2].x),
+            std::min(std::min(corners[0].y, corners[1].y), corners[2].y),
+            std::min(std::min(corners[0].z, corners[1].z), corners[2].z));
+        outMax = NiPoint3(std::max(std::max(corners[0].x, corners[1].x), corners[2].x),
+            std::max(std::max(corners[0].y, corners[1].y), corners[2].y),
+            std::max(std::max(corners[0].z, corners[1].z), corners[2].z));
+    }
+
+    // ============================================
+    // MeshNarrowphase
+    // ============================================
+
+    MeshNarrowphase* MeshNarrowphase::GetSingleton()
+    {
+        static MeshNarrowphase instance;
+        return &instance;
+    }
+
+    void MeshNarrowphase::BeginFrame()
+    {
+        m_frame++;
+        m_budgetLeft = bladeMeshBudget;
+    }
+
+    void MeshNarrowphase::Clear()
+    {
+        for (MeshBvh& bvh : m_cache)
+        {
+            bvh.formID = 0;
+            bvh.nodes.clear();
+            bvh.triangles.clear();
+        }
+        for (WarmStart& warm : m_warmStarts)
+            warm.formA = warm.formB = 0;
+    }
+
+    MeshNarrowphase::WarmStart* MeshNarrowphase::GetWarmStart(UInt32 formA, UInt32 formB)
+    {
+        WarmStart* slot = &m_warmStarts[0];
+        for (WarmStart& warm : m_warmStarts)
+        {
+            if (warm.formA == formA && warm.formB == formB)
+                return &warm;
+            if (slot->formA != 0 && (warm.formA == 0 || warm.lastUsedFrame < slot->lastUsedFrame))
+                slot = &warm;
+        }
+        slot->formA = 0;
+        slot->formB = 0;
+        return slot;
+    }
+
+    const MeshNarrowphase::MeshBvh* MeshNarrowphase::GetBvh(UInt32 formID)
+    {
+        MeshBvh* slot = &m_cache[0];
+        for (MeshBvh& bvh : m_cache)
+        {
+            if (bvh.formID == formID)
+            {
+                bvh.lastUsedFrame = m_frame;
+                return &bvh;
+            }
+            // Empty slot first, then least recently used
+            if (slot->formID != 0 && (bvh.formID == 0 || bvh.lastUsedFrame < slot->lastUsedFrame))
+                slot = &bvh;
+        }
+
+        auto buildStart = std::chrono::high_resolution_clock::now();
+        if (!BuildBvh(formID, *slot))
+        {
+            slot->formID = 0;
+            return nullptr;
+        }
+        m_buildCount++;
+        m_buildUs += std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - buildStart).count();
+
+        slot->formID = formID;
+        slot->lastUsedFrame = m_frame;
+        return slot;
+    }
+
+    bool MeshNarrowphase::BuildBvh(UInt32 formID, MeshBvh& outBvh)
+    {
+        outBvh.nodes.clear();
+        outBvh.triangles.clear();
+
+        WeaponProfileDB* db = WeaponProfileDB::GetSingleton();
+        BladeProfileMeshView mesh;
+        if (!db->GetMesh(db->Find(formID), mesh))
+            return false;
+
+        struct BuildTriangle
+        {
+            NiPoint3 corners[3];
+            NiPoint3 centroid;
+        };
+        std::vector<BuildTriangle> triangles;
+        triangles.reserve(mesh.triangleCount);
+        for (UInt32 i = 0; i < mesh.triangleCount; i++)
+        {
+            BuildTriangle triangle;
+            bool valid = true;
+            for (int c = 0; c < 3; c++)
+            {
+                UInt32 index = mesh.triangles[i * 3 + c];
+                if (index >= mesh.vertexCount)
+                {
+                    valid = false;
+                    break;
+                }
+                const float* v = mesh.vertices + index * 3;
+                triangle.corners[c] = NiPoint3(v[0], v[1], v[2]);
+            }
+            if (!valid)
+                continue;
+            triangle.centroid = Scale(Add(Add(triangle.corners[0], triangle.corners[1]), triangle.corners[2]), 1.0f / 3.0f);
+            triangles.push_back(triangle);
+        }
+        if (triangles.empty())
+            return false;
+
+        // Top-down build: split each node at the median centroid of its longest axis.
+        // Children are allocated as a pair so the right child is always left + 1.
+        struct BuildTask
+        {
+            UInt32 node;
+            UInt32 begin;
+            UInt32 end;
+        };
+        std::vector<BuildTask> tasks;
+        outBvh.nodes.reserve(2 * triangles.size() / kLeafTriangles + 1);
+        outBvh.nodes.emplace_back();
+        tasks.push_back({ 0, 0, (UInt32)triangles.size() });
+
+        while (!tasks.empty())
+        {
+            BuildTask task = tasks.back();
+            tasks.pop_back();
+
+            NiPoint3 boundsMin(FLT_MAX, FLT_MAX, FLT_MAX), boundsMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+            NiPoint3 centroidMin = boundsMin, centroidMax = boundsMax;
+            for (UInt32 i = task.begin; i < task.end; i++)
+            {
+                for (const NiPoint3& p : triangles[i].corners)
+                {
+                    boundsMin = NiPoint3(std::min(boundsMin.x, p.x), std::min(boundsMin.y, p.y), std::min(boundsMin.z, p.z));
+                    boundsMax = NiPoint3(std::max(boundsMax.x, p.x), std::max(boundsMax.y, p.y), std::max(boundsMax.z, p.z));
+                }
+                const NiPoint3& c = triangles[i].centroid;
+                centroidMin = NiPoint3(std::min(centroidMin.x, c.x), std::min(centroidMin.y, c.y), std::min(centroidMin.z, c.z));
+                centroidMax = NiPoint3(std::max(centroidMax.x, c.x), std::max(centroidMax.y, c.y), std::max(centroidMax.z, c.z));
+            }
+
+            BvhNode& node = outBvh.nodes[task.node];
+            node.boundsMin = boundsMin;
+            node.boundsMax = boundsMax;
+
+            UInt32 count = task.end - task.begin;
+            if (count <= (UInt32)kLeafTriangles)
+            {
+                node.first = task.begin;
+                node.count = count;
+                continue;
+            }
+
+            NiPoint3 extent = Sub(centroidMax, centroidMin);
+            int axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : (extent.y >= extent.z ? 1 : 2);
+            UInt32 mid = task.begin + count / 2;
+            std::nth_element(triangles.begin() + task.begin, triangles.begin() + mid, triangles.begin() + task.end,
+                [axis](const BuildTriangle& a, const BuildTriangle& b) { return Component(a.centroid, axis) < Component(b.centroid, axis); });
+
+            UInt32 left = (UInt32)outBvh.nodes.size();
+            node.first = left;
+            node.count = 0;
+            outBvh.nodes.emplace_back();
+            outBvh.nodes.emplace_back();
+            tasks.push_back({ left, task.begin, mid });
+            tasks.push_back({ left + 1, mid, task.end });
+        }
+
+        outBvh.triangles.reserve(triangles.size() * 3);
+        for (const BuildTriangle& triangle : triangles)
+        {
+            outBvh.triangles.push_back(triangle.corners[0]);
+            outBvh.triangles.push_back(triangle.corners[1]);
+            outBvh.triangles.push_back(triangle.corners[2]);
+        }
+        return true;
+    }
+
+    bool MeshNarrowphase::Query(UInt32 formA, const NiTransform& transformA, UInt32 formB, const NiTransform& transformB,
+        float maxDistance, MeshContact& outContact)
+    {
+        outContact = MeshContact();
+        outContact.distance = maxDistance;
+
+        if (m_budgetLeft <= 0 || transformA.scale <= 0.0001f)
+            return false;
+
+        const MeshBvh* bvhA = GetBvh(formA);
+        const MeshBvh* bvhB = GetBvh(formB);
+        if (!bvhA || !bvhB || bvhA->nodes.empty() || bvhB->nodes.empty())
+            return false;
+        // Building B may have evicted A when both are new and the cache is full
+        if (bvhA->formID != formA)
+            return false;
+
+        auto queryStart = std::chrono::high_resolution_clock::now();
+
+        // Work in A's node space: B' = (RA^T RB) (sB / sA) p + RA^T (tB - tA) / sA
+        RelativeTransform relative;
+        const NiMatrix33& rotA = transformA.rot;
+        const NiMatrix33& rotB = transformB.rot;
+        for (int i = 0; i < 3; i++)
+            for (int j = 0; j < 3; j++)
+                relative.rot[i][j] = rotA.data[0][i] * rotB.data[0][j] + rotA.data[1][i] * rotB.data[1][j] + rotA.data[2][i] * rotB.data[2][j];
+        relative.scale = transformB.scale / transformA.scale;
+        NiPoint3 delta = Sub(transformB.pos, transformA.pos);
+        relative.offset = Scale(NiPoint3(
+            rotA.data[0][0] * delta.x + rotA.data[1][0] * delta.y + rotA.data[2][0] * delta.z,
+            rotA.data[0][1] * delta.x + rotA.data[1][1] * delta.y + rotA.data[2][1] * delta.z,
+            rotA.data[0][2] * delta.x + rotA.data[1][2] * delta.y + rotA.data[2][2] * delta.z), 1.0f / transformA.scale);
+
+        // B's node boxes, moved into A's space as enclosing boxes
+        auto boundsOfB = [&relative](const BvhNode& node, NiPoint3& outMin, NiPoint3& outMax) {
+            NiPoint3 center = Scale(Add(node.boundsMin, node.boundsMax), 0.5f);
+            NiPoint3 half = Scale(Sub(node.boundsMax, node.boundsMin), 0.5f);
+            NiPoint3 c = relative.Apply(center);
+            NiPoint3 e(
+                (std::fabs(relative.rot[0][0]) * half.x + std::fabs(relative.rot[0][1]) * half.y + std::fabs(relative.rot[0][2]) * half.z) * relative.scale,
+                (std::fabs(relative.rot[1][0]) * half.x + std::fabs(relative.rot[1][1]) * half.y + std::fabs(relative.rot[1][2]) * half.z) * relative.scale,
+                (std::fabs(relative.rot[2][0]) * half.x + std::fabs(relative.rot[2][1]) * half.y + std::fabs(relative.rot[2][2]) * half.z) * relative.scale);
+            outMin = Sub(c, e);
+            outMax = Add(c, e);
+        };
+
+        float limit = maxDistance / transformA.scale;
+        float bestSq = limit * limit;
+        NiPoint3 bestA, bestB;
+        UInt32 bestLeafA = 0, bestLeafB = 0;
+        bool found = false;
+        bool exhausted = false;
+
+        NiPoint3 cornersB[kLeafTriangles * 3];
+        NiPoint3 minB[kLeafTriangles], maxB[kLeafTriangles];
+        auto testLeafPair = [&](UInt32 leafA, UInt32 leafB) {
+            const BvhNode& nodeA = bvhA->nodes[leafA];
+            const BvhNode& nodeB = bvhB->nodes[leafB];
+            for (UInt32 j = 0; j < nodeB.count * 3; j++)
+                cornersB[j] = relative.Apply(bvhB->triangles[(nodeB.first * 3) + j]);
+            for (UInt32 j = 0; j < nodeB.count; j++)
+                TriangleBounds(&cornersB[j * 3], minB[j], maxB[j]);
+
+            for (UInt32 i = 0; i < nodeA.count && !exhausted; i++)
+            {
+                const NiPoint3* triangleA = &bvhA->triangles[(nodeA.first + i) * 3];
+                NiPoint3 minA, maxA;
+                TriangleBounds(triangleA, minA, maxA);
+                for (UInt32 j = 0; j < nodeB.count; j++)
+                {
+                    // Triangle boxes already farther than the best pair - skip the full test
+                    if (BoxDistanceSq(minA, maxA, minB[j], maxB[j]) >= bestSq)
+                        continue;
+                    if (--m_budgetLeft < 0)
+                    {
+                        exhausted = true;
+                        break;
+                    }
+                    outContact.trianglePairs++;
+
+                    NiPoint3 pa, pb;
+                    float d = TriangleDistanceSq(triangleA, &cornersB[j * 3], pa, pb);
+                    if (d < bestSq)
+                    {
+                        bestSq = d;
+                        bestA = pa;
+                        bestB = pb;
+                        bestLeafA = leafA;
+                        bestLeafB = leafB;
+                        found = true;
+                    }
+                }
+            }
+        };
+
+        // ============================================
+        // WARM START
+        // Last frame's closest leaf pair gives a tight upper bound before the walk,
+        // as long as B has moved little relative to A since it was found
+        // ============================================
+        static const float kWarmMaxOffset = 4.0f;       // Node units of relative movement
+        static const float kWarmMaxRotation = 0.15f;    // Largest change of a relative rotation entry
+        WarmStart* warm = GetWarmStart(formA, formB);
+        bool warmStarted = false;
+        if (warm->formA == formA && warm->formB == formB &&
+            warm->leafA < bvhA->nodes.size() && warm->leafB < bvhB->nodes.size() &&
+            bvhA->nodes[warm->leafA].count > 0 && bvhB->nodes[warm->leafB].count > 0)
+        {
+            NiPoint3 moved = Sub(relative.offset, warm->offset);
+            float rotationDelta = std::fabs(relative.scale - warm->scale);
+            for (int i = 0; i < 3; i++)
+                for (int j = 0; j < 3; j++)
+                    rotationDelta = std::max(rotationDelta, std::fabs(relative.rot[i][j] - warm->rot[i][j]));
+            if (Dot(moved, moved) < kWarmMaxOffset * kWarmMaxOffset && rotationDelta < kWarmMaxRotation)
+            {
+                warmStarted = true;
+                testLeafPair(warm->leafA, warm->leafB);
+            }
+        }
+        bool warmFound = found;
+
+        struct NodePair
+        {
+            UInt32 a;
+            UInt32 b;
+            float distanceSq;
+        };
+        static const int kStackSize = 256;
+        NodePair stack[kStackSize];
+        int stackSize = 0;
+
+        NiPoint3 rootMinB, rootMaxB;
+        boundsOfB(bvhB->nodes[0], rootMinB, rootMaxB);
+        stack[stackSize++] = { 0, 0, BoxDistanceSq(bvhA->nodes[0].boundsMin, bvhA->nodes[0].boundsMax, rootMinB, rootMaxB) };
+
+        while (stackSize > 0 && !exhausted)
+        {
+            NodePair pair = stack[--stackSize];
+            if (pair.distanceSq >= bestSq)
+                continue;
+
+            const BvhNode& nodeA = bvhA->nodes[pair.a];
+            const BvhNode& nodeB = bvhB->nodes[pair.b];
+
+            if (nodeA.count > 0 && nodeB.count > 0)
+            {
+                // The warm pair was already tested (and is the best so far if it's still in range)
+                if (!(warmStarted && pair.a == warm->leafA && pair.b == warm->leafB))
+                    testLeafPair(pair.a, pair.b);
+                continue;
+            }
+
+            // Descend into the larger inner node; nearer child pair is popped first
+            bool splitA = nodeB.count > 0 || (nodeA.count == 0 &&
+                Dot(Sub(nodeA.boundsMax, nodeA.boundsMin), Sub(nodeA.boundsMax, nodeA.boundsMin)) >=
+                Dot(Sub(nodeB.boundsMax, nodeB.boundsMin), Sub(nodeB.boundsMax, nodeB.boundsMin)) * relative.scale * relative.scale);
+
+            NodePair children[2];
+            for (int c = 0; c < 2; c++)
+            {
+                UInt32 childA = splitA ? nodeA.first + c : pair.a;
+                UInt32 childB = splitA ? pair.b : nodeB.first + c;
+                NiPoint3 minB, maxB;
+                boundsOfB(bvhB->nodes[childB], minB, maxB);
+                children[c] = { childA, childB, BoxDistanceSq(bvhA->nodes[childA].boundsMin, bvhA->nodes[childA].boundsMax, minB, maxB) };
+            }
+            if (children[0].distanceSq < children[1].distanceSq)
+                std::swap(children[0], children[1]);
+
+            for (const NodePair& child : children)
+            {
+                if (child.distanceSq >= bestSq)
+                    continue;
+                if (stackSize >= kStackSize)
+                {
+                    exhausted = true;
+                    break;
+                }
+                stack[stackSize++] = child;
+            }
+        }
+
+        bool warmKept = warmStarted && warmFound && found && bestLeafA == warm->leafA && bestLeafB == warm->leafB;
+
+        // Remember where the closest pair was for next frame
+        if (found && !exhausted)
+        {
+            warm->formA = formA;
+            warm->formB = formB;
+            warm->leafA = bestLeafA;
+            warm->leafB = bestLeafB;
+            std::memcpy(warm->rot, relative.rot, sizeof(warm->rot));
+            warm->offset = relative.offset;
+            warm->scale = relative.scale;
+        }
+        warm->lastUsedFrame = m_frame;
+
+        double queryUs = std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - queryStart).count();
+        m_queryCount++;
+        m_queryUs += queryUs;
+        m_trianglePairs += outContact.trianglePairs;
+        if (warmStarted)
+        {
+            m_warmQueryCount++;
+            m_warmUs += queryUs;
+            m_warmTrianglePairs += outContact.trianglePairs;
+            if (warmKept)
+                m_warmKeptCount++;
+        }
+        if (exhausted)
+            m_budgetExhaustedCount++;
+        else if (found)
+            m_inRangeCount++;
+
+        // Stats every 900 queries (~10s of continuous close contact at 90Hz)
+        if (m_queryCount >= 900)
+        {
+            _MESSAGE("MeshNarrowphase: %d queries - avg %.1fus, %.0f triangle pairs/query, %d in range, %d over budget (%d pairs/frame)",
+                m_queryCount, m_queryUs / m_queryCount, (double)m_trianglePairs / m_queryCount,
+                m_inRangeCount, m_budgetExhaustedCount, bladeMeshBudget);
+            _MESSAGE("MeshNarrowphase:   %d trees built (avg %.0fus)", m_buildCount, m_buildCount > 0 ? m_buildUs / m_buildCount : 0.0);
+            int coldCount = m_queryCount - m_warmQueryCount;
+            _MESSAGE("MeshNarrowphase:   Warm start %d/%d queries (%d kept the same leaf pair) - warm avg %.1fus / %.0f pairs, cold avg %.1fus / %.0f pairs",
+                m_warmQueryCount, m_queryCount, m_warmKeptCount,
+                m_warmQueryCount > 0 ? m_warmUs / m_warmQueryCount : 0.0,
+                m_warmQueryCount > 0 ? (double)m_warmTrianglePairs / m_warmQueryCount : 0.0,
+                coldCount > 0 ? (m_queryUs - m_warmUs) / coldCount : 0.0,
+                coldCount > 0 ? (double)(m_trianglePairs - m_warmTrianglePairs) / coldCount : 0.0);
+            m_queryCount = 0;
+            m_queryUs = 0.0;
+            m_trianglePairs = 0;
+            m_inRangeCount = 0;
+            m_budgetExhaustedCount = 0;
+            m_buildCount = 0;
+            m_buildUs = 0.0;
+            m_warmQueryCount = 0;
+            m_warmKeptCount = 0;
+            m_warmTrianglePairs = 0;
+            m_warmUs = 0.0;
+        }
+
+        if (exhausted)
+            return false;
+
+        if (found)
+        {
+            outContact.inRange = true;
+            outContact.distance = std::sqrt(bestSq) * transformA.scale;
+            outContact.pointA = ToWorld(transformA, bestA);
+            outContact.pointB = ToWorld(transformA, bestB);
+        }
+        return true;
+    }
+}
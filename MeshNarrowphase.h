@@ -0,0 +1,116 @@
+#pragma once
+
+#include "skse64/NiTypes.h"
+#include <vector>
+
+namespace FalseEdgeVR
+{
+    struct MeshContact
+    {
+        float distance = 0.0f;          // World surface distance, maxDistance if nothing is closer
+        NiPoint3 pointA;                // Closest points (world) - only meaningful when inRange
+        NiPoint3 pointB;
+        bool inRange = false;           // A triangle pair is closer than maxDistance
+        int trianglePairs = 0;          // Triangle pair tests this query ran
+    };
+
+    // ============================================
+    // MeshNarrowphase
+    // ============================================
+    // Precise weapon-vs-weapon distance on the real triangle meshes, for when
+    // the blade segments say the weapons are close. Meshes come from the
+    // profile database (WeaponProfileDB); each FormID's mesh gets an AABB tree
+    // built the first time it's queried and kept in a small cache.
+    // A query walks both trees together in A's node space and only descends
+    // into box pairs closer than the best distance so far (starting at
+    // maxDistance), so far-apart parts of the weapons cost nothing.
+    // Each weapon pair remembers the leaf pair that held last frame's closest
+    // triangles. While the relative pose has barely moved, that leaf pair is
+    // tested first, so the walk starts from a near-final best distance and
+    // prunes almost everything else; after a larger jump it starts cold.
+    // Triangle pair tests are capped per frame ([BladeCollision] MeshBudget);
+    // a query that runs out of budget fails and the caller keeps the segment
+    // result. Game thread only.
+    // ============================================
+
+    class MeshNarrowphase
+    {
+    public:
+        static MeshNarrowphase* GetSingleton();
+
+        // Reset the per-frame triangle pair budget (start of the pre-physics step)
+        void BeginFrame();
+
+        // Distance between two weapons' meshes, each placed by its weapon node's world transform.
+        // False if either form has no mesh or the budget ran out - outContact is not valid then.
+        bool Query(UInt32 formA, const NiTransform& transformA, UInt32 formB, const NiTransform& transformB,
+            float maxDistance, MeshContact& outContact);
+
+        // Drop every cached tree
+        void Clear();
+
+    private:
+        MeshNarrowphase() = default;
+        ~MeshNarrowphase() = default;
+        MeshNarrowphase(const MeshNarrowphase&) = delete;
+        MeshNarrowphase& operator=(const MeshNarrowphase&) = delete;
+
+        static const int kMaxCachedMeshes = 8;
+        static const int kLeafTriangles = 4;
+        static const int kWarmStartPairs = 4;
+
+        struct BvhNode
+        {
+            NiPoint3 boundsMin;
+            NiPoint3 boundsMax;
+            UInt32 first = 0;       // Leaf: first triangle; inner: left child (right = left + 1)
+            UInt32 count = 0;       // Triangles in a leaf, 0 for inner nodes
+        };
+
+        struct MeshBvh
+        {
+            UInt32 formID = 0;
+            UInt32 lastUsedFrame = 0;
+            std::vector<BvhNode> nodes;
+            std::vector<NiPoint3> triangles;    // 3 corners per triangle, in leaf order
+        };
+
+        // Last frame's closest leaf pair for one weapon pair, with the relative pose it was found at
+        struct WarmStart
+        {
+            UInt32 formA = 0;
+            UInt32 formB = 0;
+            UInt32 lastUsedFrame = 0;
+            UInt32 leafA = 0;
+            UInt32 leafB = 0;
+            float rot[3][3];
+            NiPoint3 offset;
+            float scale = 1.0f;
+        };
+
+        // Warm start slot for a weapon pair (existing, else empty, else least recently used)
+        WarmStart* GetWarmStart(UInt32 formA, UInt32 formB);
+
+        // Cached tree for a form, building it if needed - nullptr if the form has no mesh
+        const MeshBvh* GetBvh(UInt32 formID);
+        bool BuildBvh(UInt32 formID, MeshBvh& outBvh);
+
+        MeshBvh m_cache[kMaxCachedMeshes];
+        WarmStart m_warmStarts[kWarmStartPairs];
+        UInt32 m_frame = 0;
+        int m_budgetLeft = 0;
+
+        // Stats
+        int m_queryCount = 0;
+        int m_budgetExhaustedCount = 0;
+        int m_inRangeCount = 0;
+        int m_buildCount = 0;
+        long long m_trianglePairs = 0;
+        double m_queryUs = 0.0;
+        double m_buildUs = 0.0;
+        int m_warmQueryCount = 0;               // Queries that started from last frame's leaf pair
+        int m_warmKeptCount = 0;                // ...where that pair was still the closest
+        long long m_warmTrianglePairs = 0;
+        double m_warmUs = 0.0;
+    };
+}
@@ -0,0 +1,261 @@
+#include "RateScheduler.h"
+#include "config.h"
+#include "TrackingDormancy.h"
+#include "common/IDebugLog.h"
+#include <cmath>
+
+namespace FalseEdgeVR
+{
+    RateScheduler* RateScheduler::GetSingleton()
+    {
+        static RateScheduler instance;
+        return &instance;
+    }
+
+    RateScheduler::RateScheduler()
+    {
+        m_groups[(int)RateGroup::Collision].name = "Collision";
+        m_groups[(int)RateGroup::BodyZones].name = "BodyZones";
+        m_groups[(int)RateGroup::AutoEquip].name = "AutoEquip";
+        m_groups[(int)RateGroup::ShieldBash].name = "ShieldBash";
+        m_groups[(int)RateGroup::EquipConsistency].name = "EquipConsistency";
+        m_groups[(int)RateGroup::RefPool].name = "RefPool";
+        m_groups[(int)RateGroup::CombatScan].name = "CombatScan";
+    }
+
+    void RateScheduler::Reschedule()
+    {
+        m_groups[(int)RateGroup::Collision].targetHz = 0.0f;
+        m_groups[(int)RateGroup::BodyZones].targetHz = schedulerBodyZoneRate;
+        m_groups[(int)RateGroup::AutoEquip].targetHz = schedulerAutoEquipRate;
+        m_groups[(int)RateGroup::ShieldBash].targetHz = schedulerShieldBashRate;
+        m_groups[(int)RateGroup::EquipConsistency].targetHz = schedulerEquipConsistencyRate;
+        m_groups[(int)RateGroup::RefPool].targetHz = schedulerRefPoolRate;
+        m_groups[(int)RateGroup::CombatScan].targetHz = schedulerCombatScanRate;
+
+        bool changed = !m_scheduled;
+        for (int i = 0; i < kGroupCount; i++)
+        {
+            Group& g = m_groups[i];
+            int interval = 1;
+            if (rateSchedulerEnabled && g.targetHz > 0.0f && g.targetHz < m_physicsHz)
+            {
+                interval = (int)(m_physicsHz / g.targetHz + 0.5f);
+                if (interval < 1)
+                    interval = 1;
+                if (interval > kPhaseHorizon)
+                    interval = kPhaseHorizon;
+            }
+            if (interval != g.interval)
+            {
+                g.interval = interval;
+                changed = true;
+            }
+        }
+
+        // Groups we haven't timed yet still count, so equal-rate groups end up on different frames
+        double cost[kGroupCount];
+        int phases[kGroupCount];
+        for (int i = 0; i < kGroupCount; i++)
+        {
+            cost[i] = m_groups[i].avgCostUs > 0.0 ? m_groups[i].avgCostUs : 1.0;
+            phases[i] = m_groups[i].phase;
+        }
+
+        double currentPeak = PeakLoad(cost, phases);
+        double placedPeak = PlacePhases(cost, phases);
+
+        // Same intervals - only move phases when the measured costs say it pays off
+        if (!changed && placedPeak >= currentPeak * (1.0 - kReplaceGain))
+            return;
+
+        for (int i = 0; i < kGroupCount; i++)
+        {
+            m_groups[i].phase = phases[i];
+        }
+
+        m_scheduled = true;
+
+        _MESSAGE("RateScheduler: Scheduled for %.0f Hz physics%s - peak frame cost %.1fus (was %.1fus):", m_physicsHz,
+            rateSchedulerEnabled ? "" : " (disabled - all groups every step)", placedPeak, currentPeak);
+        for (int i = 0; i < kGroupCount; i++)
+        {
+            const Group& g = m_groups[i];
+            _MESSAGE("RateScheduler:   %-16s every %d step(s), phase %d (target %.0f Hz, avg %.1fus)",
+                g.name, g.interval, g.phase, g.targetHz > 0.0f ? g.targetHz : m_physicsHz, g.avgCostUs);
+        }
+    }
+
+    double RateScheduler::PlacePhases(const double* cost, int* outPhases) const
+    {
+        // Greedy placement: most expensive groups first, each into the phase whose frames carry the least cost so far
+        double load[kPhaseHorizon] = {};
+        bool placed[kGroupCount] = {};
+
+        for (int n = 0; n < kGroupCount; n++)
+        {
+            int best = -1;
+            for (int i = 0; i < kGroupCount; i++)
+            {
+                if (placed[i])
+                    continue;
+                if (best < 0 || cost[i] > cost[best])
+                    best = i;
+            }
+
+            const Group& g = m_groups[best];
+            placed[best] = true;
+
+            int bestPhase = 0;
+            double bestLoad = -1.0;
+            for (int phase = 0; phase < g.interval; phase++)
+            {
+                double phaseLoad = 0.0;
+                for (int f = 0; f < kPhaseHorizon; f++)
+                {
+                    if ((f + phase) % g.interval == 0 && load[f] > phaseLoad)
+                        phaseLoad = load[f];
+                }
+                if (bestLoad < 0.0 || phaseLoad < bestLoad)
+                {
+                    bestLoad = phaseLoad;
+                    bestPhase = phase;
+                }
+            }
+
+            outPhases[best] = bestPhase;
+            for (int f = 0; f < kPhaseHorizon; f++)
+            {
+                if ((f + bestPhase) % g.interval == 0)
+                    load[f] += cost[best];
+            }
+        }
+
+        return PeakLoad(cost, outPhases);
+    }
+
+    double RateScheduler::PeakLoad(const double* cost, const int* phases) const
+    {
+        double load[kPhaseHorizon] = {};
+        for (int i = 0; i < kGroupCount; i++)
+        {
+            const Group& g = m_groups[i];
+            for (int f = 0; f < kPhaseHorizon; f++)
+            {
+                if ((f + phases[i]) % g.interval == 0)
+                    load[f] += cost[i];
+            }
+        }
+
+        double peak = 0.0;
+        for (int f = 0; f < kPhaseHorizon; f++)
+        {
+            if (load[f] > peak)
+                peak = load[f];
+        }
+        return peak;
+    }
+
+    void RateScheduler::BeginFrame(float deltaTime)
+    {
+        // Physics rate changes (refresh rate, ASW, menus) are slow - smooth it and reschedule once a second
+        m_physicsHz += (1.0f / deltaTime - m_physicsHz) * 0.05f;
+        m_rescheduleTimer += deltaTime;
+        if (!m_scheduled || m_rescheduleTimer >= 1.0f)
+        {
+            m_rescheduleTimer = 0.0f;
+            Reschedule();
+        }
+
+        m_frame++;
+        m_frameCostUs = 0.0;
+
+        for (int i = 0; i < kGroupCount; i++)
+        {
+            Group& g = m_groups[i];
+            g.accumulated += deltaTime;
+            g.due = (g.interval <= 1) || ((m_frame + g.phase) % g.interval == 0);
+        }
+    }
+
+    void RateScheduler::EndRun(Group& g, std::chrono::high_resolution_clock::time_point start)
+    {
+        double costUs = std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - start).count();
+        g.lastCostUs = costUs;
+        g.avgCostUs = g.avgCostUs > 0.0 ? g.avgCostUs + (costUs - g.avgCostUs) * kCostSmoothing : costUs;
+        g.costSumUs += costUs;
+        g.runs++;
+        m_frameCostUs += costUs;
+    }
+
+    void RateScheduler::ResetAccumulated(RateGroup group)
+    {
+        m_groups[(int)group].accumulated = 0.0f;
+    }
+
+    void RateScheduler::EndFrame(float deltaTime)
+    {
+        // What this frame would have cost with every group at full rate
+        double fullRateUs = 0.0;
+        for (int i = 0; i < kGroupCount; i++)
+        {
+            fullRateUs += m_groups[i].lastCostUs;
+        }
+
+        m_statFrames++;
+        double delta = m_frameCostUs - m_costMean;
+        m_costMean += delta / m_statFrames;
+        m_costM2 += delta * (m_frameCostUs - m_costMean);
+
+        double fullDelta = fullRateUs - m_fullRateMean;
+        m_fullRateMean += fullDelta / m_statFrames;
+        m_fullRateM2 += fullDelta * (fullRateUs - m_fullRateMean);
+
+        if (m_frameCostUs > m_costMax)
+            m_costMax = m_frameCostUs;
+
+        // Stats every 10 seconds
+        m_statsTimer += deltaTime;
+        if (m_statsTimer >= 10.0f)
+        {
+            double sd = m_statFrames > 1 ? std::sqrt(m_costM2 / (m_statFrames - 1)) : 0.0;
+            double fullSd = m_statFrames > 1 ? std::sqrt(m_fullRateM2 / (m_statFrames - 1)) : 0.0;
+
+            float activeSeconds = 0.0f;
+            float dormantSeconds = 0.0f;
+            TrackingDormancy::GetSingleton()->TakeStateTimes(activeSeconds, dormantSeconds);
+
+            _MESSAGE("RateScheduler: Stats - frame cost mean %.1fus sd %.1fus max %.1fus over %d frames (full rate: mean %.1fus sd %.1fus)",
+                m_costMean, sd, m_costMax, m_statFrames, m_fullRateMean, fullSd);
+            _MESSAGE("RateScheduler:   Collision tracking active %.1fs, dormant %.1fs", activeSeconds, dormantSeconds);
+            for (int i = 0; i < kGroupCount; i++)
+            {
+                Group& g = m_groups[i];
+                if (g.runs > 0)
+                {
+                    _MESSAGE("RateScheduler:   %-16s %.1f runs/s, avg %.1fus", g.name, g.runs / m_statsTimer, g.costSumUs / g.runs);
+                }
+                g.runs = 0;
+                g.costSumUs = 0.0;
+            }
+
+            m_statsTimer = 0.0f;
+            m_statFrames = 0;
+            m_costMean = 0.0;
+            m_costM2 = 0.0;
+            m_fullRateMean = 0.0;
+            m_fullRateM2 = 0.0;
+            m_costMax = 0.0;
+        }
+    }
+
+    void RateScheduler::Clear()
+    {
+        for (int i = 0; i < kGroupCount; i++)
+        {
+            m_groups[i].accumulated = 0.0f;
+            m_groups[i].due = false;
+        }
+        m_scheduled = false;
+    }
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "skse64/GameTypes.h"
+#include <chrono>
+
+namespace FalseEdgeVR
+{
+    // Per-frame work driven from VRInputHandler::OnPrePhysicsStep, grouped by how often it needs to run
+    enum class RateGroup
+    {
+        Collision = 0,      // Blade/shield trackers - every physics step
+        BodyZones,          // Controller-to-body-zone tests
+        AutoEquip,          // Grabbed weapon auto-equip delay
+        ShieldBash,         // Shield bash window/lockout timers
+        EquipConsistency,   // Equipment changes without an equip event
+        RefPool,            // Avoidance weapon ref pool parking/expiry
+        CombatScan,         // Combat target distance / close combat mode
+        Count
+    };
+
+    // ============================================
+    // RateScheduler
+    // ============================================
+    // Runs each RateGroup at its [Scheduler] target rate instead of every physics step.
+    // The physics rate is measured from the frame delta, so a 45 Hz group runs every
+    // 2nd step at 90 Hz and every 3rd at 144 Hz. Groups get phase offsets chosen from
+    // their smoothed measured cost, so the reduced-rate work is spread over the frames
+    // in between rather than landing on the same one; phases are re-placed once a second
+    // when that lowers the peak frame cost by kReplaceGain.
+    // A group's callback gets the time since it last ran, so its timers stay exact.
+    // Callers that skip a group (disabled, dormant) call ResetAccumulated so the next
+    // run doesn't get the whole skipped span as one delta.
+    // Logs per-group cost and the per-frame cost spread every 10 seconds, together
+    // with the spread the same work would have at full rate.
+    // [Scheduler] Enabled = 0 runs everything every step.
+    // Game thread only.
+    // ============================================
+
+    class RateScheduler
+    {
+    public:
+        static RateScheduler* GetSingleton();
+
+        // Start of the pre-physics step - decides which groups are due this frame
+        void BeginFrame(float deltaTime);
+
+        // Run fn(groupDeltaTime) if the group is due this frame
+        template <typename Fn>
+        void Run(RateGroup group, Fn&& fn)
+        {
+            Group& g = m_groups[(int)group];
+            if (!g.due)
+                return;
+
+            float groupDelta = g.accumulated;
+            g.accumulated = 0.0f;
+            g.due = false;
+
+            auto start = std::chrono::high_resolution_clock::now();
+            fn(groupDelta);
+            EndRun(g, start);
+        }
+
+        // The caller skipped this group - its next run starts timing from now
+        void ResetAccumulated(RateGroup group);
+
+        // End of the pre-physics step - frame cost stats
+        void EndFrame(float deltaTime);
+
+        // Reset timing state (game load)
+        void Clear();
+
+    private:
+        RateScheduler();
+        ~RateScheduler() = default;
+        RateScheduler(const RateScheduler&) = delete;
+        RateScheduler& operator=(const RateScheduler&) = delete;
+
+        static const int kGroupCount = (int)RateGroup::Count;
+        static const int kPhaseHorizon = 240;   // Frames looked at when placing phase offsets
+        static constexpr double kReplaceGain = 0.1;     // Peak cost drop that makes a re-placement worth it
+        static constexpr double kCostSmoothing = 0.05;  // Per-run weight of the smoothed cost
+
+        struct Group
+        {
+            const char* name = "";
+            float targetHz = 0.0f;       // 0 = every physics step
+            int interval = 1;            // Physics steps between runs
+            int phase = 0;               // Runs when (frame + phase) % interval == 0
+            float accumulated = 0.0f;    // Time since the last run
+            bool due = false;
+            double lastCostUs = 0.0;     // Cost of the most recent run
+            double avgCostUs = 0.0;      // Smoothed run cost - what phase placement balances
+
+            // Stats (per 10 second window)
+            int runs = 0;
+            double costSumUs = 0.0;
+        };
+
+        void EndRun(Group& g, std::chrono::high_resolution_clock::time_point start);
+
+        // Recompute intervals from the measured physics rate and re-place phase offsets
+        void Reschedule();
+
+        // Greedy phase placement for the current intervals; both return the peak per-frame cost
+        double PlacePhases(const double* cost, int* outPhases) const;
+        double PeakLoad(const double* cost, const int* phases) const;
+
+        Group m_groups[kGroupCount];
+        UInt32 m_frame = 0;
+        float m_physicsHz = 90.0f;          // Smoothed physics step rate
+        float m_rescheduleTimer = 0.0f;
+        bool m_scheduled = false;
+
+        // Frame cost stats (per 10 second window, Welford)
+        double m_frameCostUs = 0.0;         // Work run this frame
+        float m_statsTimer = 0.0f;
+        int m_statFrames = 0;
+        double m_costMean = 0.0;
+        double m_costM2 = 0.0;
+        double m_fullRateMean = 0.0;        // Same, if every group ran every frame (latest cost per group)
+        double m_fullRateM2 = 0.0;
+        double m_costMax = 0.0;
+    };
+}
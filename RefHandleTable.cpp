@@ -0,0 +1,101 @@
+#include "RefHandleTable.h"
+#include "skse64/GameForms.h"
+#include "skse64/GameRTTI.h"
+#include "common/IDebugLog.h"
+
+namespace FalseEdgeVR
+{
+    RefHandleTable* RefHandleTable::GetSingleton()
+    {
+        static RefHandleTable instance;
+        return &instance;
+    }
+
+    RefTableHandle RefHandleTable::Acquire(TESObjectREFR* ref)
+    {
+        if (!ref)
+            return 0;
+
+        for (int i = 0; i < kMaxSlots; i++)
+        {
+            Slot& slot = m_slots[i];
+            if (slot.inUse)
+                continue;
+
+            slot.ref = ref;
+            slot.refFormID = ref->formID;
+            slot.baseFormID = ref->baseForm ? ref->baseForm->formID : 0;
+            slot.inUse = true;
+            m_acquireCount++;
+
+            return ((slot.generation & 0xFFFFFF) << 8) | (UInt32)(i + 1);
+        }
+
+        _MESSAGE("RefHandleTable: Table full (%d slots) - cannot track ref %08X", kMaxSlots, ref->formID);
+        return 0;
+    }
+
+    void RefHandleTable::Release(RefTableHandle& handle)
+    {
+        if (Resolve(handle))
+        {
+            Invalidate(m_slots[(handle & 0xFF) - 1]);
+        }
+        handle = 0;
+    }
+
+    TESObjectREFR* RefHandleTable::Resolve(RefTableHandle handle) const
+    {
+        UInt32 index = handle & 0xFF;
+        if (index == 0 || index > (UInt32)kMaxSlots)
+            return nullptr;
+
+        const Slot& slot = m_slots[index - 1];
+        if (!slot.inUse || (slot.generation & 0xFFFFFF) != (handle >> 8))
+            return nullptr;
+
+        return slot.ref;
+    }
+
+    void RefHandleTable::Invalidate(Slot& slot)
+    {
+        slot.ref = nullptr;
+        slot.refFormID = 0;
+        slot.baseFormID = 0;
+        slot.inUse = false;
+        slot.generation++;
+    }
+
+    void RefHandleTable::BeginFrame()
+    {
+        for (int i = 0; i < kMaxSlots; i++)
+        {
+            Slot& slot = m_slots[i];
+            if (!slot.inUse)
+                continue;
+
+            // Same check as WeaponRefPool: the FormID must still map to this exact, undeleted reference
+            TESForm* form = LookupFormByID(slot.refFormID);
+            TESObjectREFR* ref = form ? DYNAMIC_CAST(form, TESForm, TESObjectREFR) : nullptr;
+            bool valid = ref && ref == slot.ref && !(ref->flags & TESForm::kFlagIsDeleted) &&
+                ref->baseForm && ref->baseForm->formID == slot.baseFormID;
+
+            if (!valid)
+            {
+                m_staleCount++;
+                _MESSAGE("RefHandleTable: Ref %08X (base %08X) is gone - handle invalidated (%d stale of %d tracked)",
+                    slot.refFormID, slot.baseFormID, m_staleCount, m_acquireCount);
+                Invalidate(slot);
+            }
+        }
+    }
+
+    void RefHandleTable::Clear()
+    {
+        for (int i = 0; i < kMaxSlots; i++)
+        {
+            if (m_slots[i].inUse)
+                Invalidate(m_slots[i]);
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "skse64/GameReferences.h"
+
+namespace FalseEdgeVR
+{
+    // Generation-checked handle into RefHandleTable - (generation << 8) | (slot + 1), 0 = none
+    typedef UInt32 RefTableHandle;
+
+    // ============================================
+    // RefHandleTable
+    // ============================================
+    // Small table of world references we hold on to across frames (avoidance weapons,
+    // auto-equip weapons, combat target) so nobody keeps a raw TESObjectREFR*.
+    // BeginFrame re-resolves every live slot once; a reference that was deleted,
+    // unloaded or replaced bumps the slot generation, so every handle to it fails
+    // Resolve in O(1) from then on instead of being dereferenced.
+    // Game thread only.
+    // ============================================
+
+    class RefHandleTable
+    {
+    public:
+        static RefHandleTable* GetSingleton();
+
+        // Track a reference - returns 0 if ref is null or the table is full
+        RefTableHandle Acquire(TESObjectREFR* ref);
+
+        // Stop tracking - invalidates every copy of the handle and sets it to 0
+        void Release(RefTableHandle& handle);
+
+        // This frame's pointer for the handle, nullptr if released or stale
+        TESObjectREFR* Resolve(RefTableHandle handle) const;
+
+        // Once per frame (start of the pre-physics step): validate live slots
+        void BeginFrame();
+
+        // Invalidate everything (game load - references from the old session are gone)
+        void Clear();
+
+    private:
+        RefHandleTable() = default;
+        ~RefHandleTable() = default;
+        RefHandleTable(const RefHandleTable&) = delete;
+        RefHandleTable& operator=(const RefHandleTable&) = delete;
+
+        static const int kMaxSlots = 16;
+
+        struct Slot
+        {
+            TESObjectREFR* ref = nullptr;
+            UInt32 refFormID = 0;
+            UInt32 baseFormID = 0;
+            UInt32 generation = 0;
+            bool inUse = false;
+        };
+
+        // Free the slot and bump its generation so outstanding handles fail
+        void Invalidate(Slot& slot);
+
+        Slot m_slots[kMaxSlots];
+
+        // Stats
+        int m_acquireCount = 0;
+        int m_staleCount = 0;
+    };
+}
@@ -1,10 +1,15 @@
 #include "ShieldCollision.h"
 #include "Engine.h"
 #include "VRInputHandler.h"
+#include "WeaponProfileDB.h"
+#include "DistanceField.h"
+#include "CollisionWorld.h"
 #include "skse64/GameRTTI.h"
 #include "skse64/NiNodes.h"
 #include <cmath>
 #include <cfloat>
+#include <algorithm>
+#include <chrono>
 
 namespace FalseEdgeVR
 {
@@ -31,6 +36,9 @@ return &instance;
         m_weaponContactingShield = false;
         m_wasContacting = false;
         m_hasShield = false;
+        m_otherHandHasWeapon = false;
+        m_shieldFaceRadius = 0.0f;
+        m_shieldField = BladeProfileFieldView();
         
         // Load thresholds from shield-specific config
         m_collisionThreshold = shieldCollisionThreshold;
@@ -43,7 +51,7 @@ return &instance;
   _MESSAGE("ShieldCollisionTracker: Initialized successfully");
     }
 
-    void ShieldCollisionTracker::Update(float deltaTime)
+    void ShieldCollisionTracker::UpdateGeometry(float deltaTime, const CollisionHand* hands, bool handsChanged)
     {
         if (!m_initialized)
       return;
@@ -60,32 +68,37 @@ return &instance;
             loggedFirstUpdate = true;
         }
 
-  const PlayerEquipState& equipState = EquipManager::GetSingleton()->GetEquipState();
-        
-        // Check directly what the player has equipped - this is always accurate
-        TESForm* leftEquipped = player->GetEquippedObject(true);
-TESForm* rightEquipped = player->GetEquippedObject(false);
-   bool directLeftIsShield = leftEquipped && EquipManager::IsShield(leftEquipped);
- bool directRightIsShield = rightEquipped && EquipManager::IsShield(rightEquipped);
-      
-        // If we detect a mismatch between direct check and EquipManager, force update
-        bool equipManagerKnowsShield = (equipState.leftHand.type == WeaponType::Shield) || 
-     (equipState.rightHand.type == WeaponType::Shield);
- if ((directLeftIsShield || directRightIsShield) && !equipManagerKnowsShield)
-{
-    _MESSAGE("ShieldCollisionTracker: EquipManager mismatch - forcing UpdateEquipmentState");
-  EquipManager::GetSingleton()->UpdateEquipmentState();
-        }
-
         // ============================================
         // SHIELD DETECTION - DO THIS FIRST before anything else
+        // Hands come from CollisionWorld - only re-read on the step it re-resolved them
      // ============================================
-        // Re-fetch equipState after potential update
-     const PlayerEquipState& currentEquipState = EquipManager::GetSingleton()->GetEquipState();
+        if (handsChanged)
+        {
+            const CollisionHand& leftHand = hands[kSlotLeftHand];
+            const CollisionHand& rightHand = hands[kSlotRightHand];
+            
+            m_hasShield = leftHand.isShield || rightHand.isShield;
+            m_shieldInLeftHand = leftHand.isShield;
+            
+            // Weapon hand is OPPOSITE of shield hand
+            m_otherHandHasWeapon = (m_shieldInLeftHand ? rightHand : leftHand).isWeapon;
+
+            // Face radius and distance field of this shield's mesh, if the profile database has them
+            m_shieldFaceRadius = 0.0f;
+            m_shieldField = BladeProfileFieldView();
+            TESForm* shieldForm = m_shieldInLeftHand ? leftHand.equipped : rightHand.equipped;
+            if (m_hasShield && useBladeProfiles && shieldForm)
+            {
+                const BladeProfileRecord* profile = WeaponProfileDB::GetSingleton()->Find(shieldForm->formID);
+                if (profile && profile->weaponType == (UInt8)WeaponType::Shield)
+                {
+                    m_shieldFaceRadius = profile->headRadius;
+                    WeaponProfileDB::GetSingleton()->GetDistanceField(profile, m_shieldField);
+                }
+            }
+        }
         
-        // Set m_hasShield based on DIRECT player check (most reliable)
-      m_hasShield = directLeftIsShield || directRightIsShield;
-        m_shieldInLeftHand = directLeftIsShield;
+     const PlayerEquipState& currentEquipState = EquipManager::GetSingleton()->GetEquipState();
         
         // Update shield geometry if we have a shield
         if (m_hasShield)
@@ -112,66 +125,38 @@ TESForm* rightEquipped = player->GetEquippedObject(false);
         debugLogCounter++;
         if (debugLogCounter % 500 == 1)
         {
-            _MESSAGE("ShieldCollisionTracker: Debug - Left hand: type=%d isEquipped=%s, Right hand: type=%d isEquipped=%s, m_hasShield=%s, directShield=%s",
+            _MESSAGE("ShieldCollisionTracker: Debug - Left hand: type=%d isEquipped=%s, Right hand: type=%d isEquipped=%s, m_hasShield=%s, otherHandWeapon=%s",
         (int)currentEquipState.leftHand.type, currentEquipState.leftHand.isEquipped ? "YES" : "NO",
       (int)currentEquipState.rightHand.type, currentEquipState.rightHand.isEquipped ? "YES" : "NO",
  m_hasShield ? "YES" : "NO",
-   (directLeftIsShield || directRightIsShield) ? "YES" : "NO");
+   m_otherHandHasWeapon ? "YES" : "NO");
         }
-        
-        // Check weapon hand has HIGGS-grabbed weapon (from our shield collision avoidance)
-       // Weapon hand is OPPOSITE of shield hand
-        bool weaponHandIsLeft = !m_shieldInLeftHand;
-        bool weaponVRControllerIsLeft = GameHandToVRController(weaponHandIsLeft);
-   bool weaponHandHiggsGrabbed = false;
-        TESObjectREFR* higgsHeldWeapon = nullptr;
- 
-        if (EquipManager::GetSingleton()->HasPendingReequip(weaponHandIsLeft))
-        {
-         // Get the dropped weapon reference we created
-         higgsHeldWeapon = EquipManager::GetSingleton()->GetDroppedWeaponRef(weaponHandIsLeft);
-        if (higgsHeldWeapon)
-{
-        // Check if HIGGS is actually holding it
-         if (higgsInterface)
-          {
-           TESObjectREFR* currentlyHeld = higgsInterface->GetGrabbedObject(weaponVRControllerIsLeft);
-                if (currentlyHeld == higgsHeldWeapon)
-      {
-   weaponHandHiggsGrabbed = true;
- }
     }
-      }
-        }
-        
-// Check for weapon-shield collision if we have a shield
-      // and either a weapon equipped in the other hand OR a HIGGS-grabbed weapon
-        if (m_hasShield)
-      {
-  bool hasWeaponToCheck = false;
-            
-     // Use DIRECT player check for weapon in other hand (more reliable than EquipManager state)
-         if (m_shieldInLeftHand)
-        {
-                // Shield in left hand - check right hand for weapon (using direct check)
-                bool directRightIsWeapon = rightEquipped && EquipManager::IsWeapon(rightEquipped);
-  hasWeaponToCheck = directRightIsWeapon;
- }
-       else
-  {
-      // Shield in right hand - check left hand for weapon (using direct check)
-           bool directLeftIsWeapon = leftEquipped && EquipManager::IsWeapon(leftEquipped);
-           hasWeaponToCheck = directLeftIsWeapon;
-        }
-    
-    // Also check if we have a HIGGS-grabbed weapon
-       if (hasWeaponToCheck || weaponHandHiggsGrabbed)
+
+    bool ShieldCollisionTracker::ProcessWeaponPair(const Collider& blade, const Collider& shield, ShieldCollisionResult& outResult)
     {
+        outResult.Clear();
+
+        // Shield collider must be this tracker's shield, the blade the opposite (weapon) hand's
+        ColliderSlot shieldSlot = m_shieldInLeftHand ? kSlotLeftHand : kSlotRightHand;
+        if (!m_hasShield || shield.slot != shieldSlot || shield.shield != &GetShieldGeometry(m_shieldInLeftHand) ||
+            blade.slot == shieldSlot || !blade.blade)
+            return false;
+
+        // Weapon hand holds our dropped weapon through HIGGS (from our collision avoidance)
+        bool weaponHandHiggsGrabbed = blade.grabbed;
+
+        // Only a weapon equipped in the weapon hand OR a HIGGS-grabbed weapon counts
+        if (!m_otherHandHasWeapon && !weaponHandHiggsGrabbed)
+            return false;
+
+        m_pairProcessed = true;
+        
      m_wasContacting = m_weaponContactingShield;
         m_wasImminent = m_collisionImminent;
     
-   ShieldCollisionResult collision;
-        bool detected = CheckWeaponShieldCollision(collision, weaponHandHiggsGrabbed);
+   ShieldCollisionResult& collision = outResult;
+        CheckWeaponShieldCollision(*blade.blade, *shield.shield, collision);
        
   m_weaponContactingShield = collision.isColliding;
        m_collisionImminent = collision.isImminent;
@@ -232,22 +217,21 @@ _MESSAGE("  Collision Point: (%.2f, %.2f, %.2f)",
              
         m_lastCollision.Clear();
    }
-}
-    else
-            {
-     m_weaponContactingShield = false;
-        m_collisionImminent = false;
-     m_wasContacting = false;
-           m_wasImminent = false;
+        
+        return true;
     }
-        }
-        else
+
+    void ShieldCollisionTracker::FinishUpdate()
+    {
+        // No weapon/shield pair this step (shield or weapon gone, weapon geometry unusable)
+        if (!m_pairProcessed)
         {
-      m_weaponContactingShield = false;
-   m_collisionImminent = false;
+            m_weaponContactingShield = false;
+            m_collisionImminent = false;
             m_wasContacting = false;
-       m_wasImminent = false;
-   }
+            m_wasImminent = false;
+        }
+        m_pairProcessed = false;
     }
 
     void ShieldCollisionTracker::UpdateShieldGeometry(bool isLeftHand, float deltaTime)
@@ -284,8 +268,9 @@ _MESSAGE("  Collision Point: (%.2f, %.2f, %.2f)",
         );
         geometry.normal = Normalize(geometry.normal);
         
-        // Set shield radius from config (focuses on shield face, not edges)
-        geometry.radius = shieldRadius;
+        // Profiled face radius, otherwise the config radius (focuses on shield face, not edges)
+        geometry.radius = m_shieldFaceRadius > 0.0f ? m_shieldFaceRadius * shieldNode->m_worldTransform.scale : shieldRadius;
+        geometry.nodeTransform = shieldNode->m_worldTransform;
      
         // Calculate velocity
         if (deltaTime > 0.0f && (geometry.prevCenterPosition.x != 0.0f || 
@@ -338,6 +323,16 @@ geometry.velocity.z = (geometry.centerPosition.z - geometry.prevCenterPosition.z
         }
     }
 
+    void ShieldCollisionTracker::ResetGeometry()
+    {
+        m_leftHandShield.Clear();
+        m_rightHandShield.Clear();
+        m_weaponContactingShield = false;
+        m_wasContacting = false;
+        m_collisionImminent = false;
+        m_wasImminent = false;
+    }
+
     bool ShieldCollisionTracker::HasShieldEquipped() const
     {
         return m_hasShield;
@@ -352,29 +347,18 @@ geometry.velocity.z = (geometry.centerPosition.z - geometry.prevCenterPosition.z
     // Shield Collision Detection
     // ============================================
 
-  bool ShieldCollisionTracker::CheckWeaponShieldCollision(ShieldCollisionResult& outResult, bool weaponHandHiggsGrabbed)
+  bool ShieldCollisionTracker::CheckWeaponShieldCollision(const BladeGeometry& weapon, const ShieldGeometry& shield, ShieldCollisionResult& outResult)
     {
         outResult.Clear();
         
 if (!m_hasShield)
 return false;
         
-        // Get shield geometry
-        const ShieldGeometry& shield = m_shieldInLeftHand ? m_leftHandShield : m_rightHandShield;
    if (!shield.isValid)
             return false;
       
-      // Get weapon geometry from WeaponGeometryTracker (right hand weapon vs left hand shield)
+      // Weapon hand's blade - CollisionWorld built its collider from this step's geometry (equipped or HIGGS-grabbed)
  bool weaponIsLeftHand = !m_shieldInLeftHand;  // Weapon is in opposite hand from shield
-    const BladeGeometry& weapon = WeaponGeometryTracker::GetSingleton()->GetBladeGeometry(weaponIsLeftHand);
-      
-        // For HIGGS-grabbed weapon, use the HIGGS grabbed geometry if available
-        if (weaponHandHiggsGrabbed && m_higgsGrabbedWeapon.isValid)
-        {
-       // Use the HIGGS grabbed weapon geometry instead
-    // (This would be updated separately)
-        }
-  
       if (!weapon.isValid)
        return false;
         
@@ -385,11 +369,58 @@ return false;
         float bladeParam;
   NiPoint3 bladePoint, shieldPoint;
         
-      float distance = ClosestDistanceBladeToShield(
-            weapon.basePosition, weapon.tipPosition,
-            shield.centerPosition, shield.normal, shield.radius,
-            bladeParam, bladePoint, shieldPoint
-        );
+        float distance;
+        if (shieldDistanceField && m_shieldField.samples)
+        {
+            distance = ClosestDistanceBladeToShieldField(
+                weapon.basePosition, weapon.tipPosition, shield.nodeTransform,
+                bladeParam, bladePoint, shieldPoint
+            );
+
+            // Time the disc every so often to compare against ([General] Profiling)
+            if (collisionProfiling && m_fieldQueryCount % 8 == 0)
+            {
+                float discParam;
+                NiPoint3 discBladePoint, discShieldPoint;
+                auto discStart = std::chrono::high_resolution_clock::now();
+                ClosestDistanceBladeToShield(
+                    weapon.basePosition, weapon.tipPosition,
+                    shield.centerPosition, shield.normal, shield.radius,
+                    discParam, discBladePoint, discShieldPoint
+                );
+                m_discNs += std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - discStart).count();
+                m_discQueryCount++;
+            }
+
+            if (m_fieldQueryCount >= 900)
+            {
+                float fieldKB = m_shieldField.resolution * m_shieldField.resolution * m_shieldField.resolution * sizeof(SInt16) / 1024.0f;
+                if (collisionProfiling)
+                {
+                    _MESSAGE("ShieldCollision: %d distance field queries, avg %.0fns (%.1f samples) vs disc %.0fns, field %.1f KB",
+                        m_fieldQueryCount, m_fieldNs / m_fieldQueryCount, (float)m_fieldSampleCount / m_fieldQueryCount,
+                        m_discQueryCount > 0 ? m_discNs / m_discQueryCount : 0.0, fieldKB);
+                }
+                else
+                {
+                    _MESSAGE("ShieldCollision: %d distance field queries, %.1f samples/query, field %.1f KB",
+                        m_fieldQueryCount, (float)m_fieldSampleCount / m_fieldQueryCount, fieldKB);
+                }
+                m_fieldQueryCount = 0;
+                m_fieldSampleCount = 0;
+                m_fieldNs = 0.0;
+                m_discQueryCount = 0;
+                m_discNs = 0.0;
+            }
+        }
+        else
+        {
+            distance = ClosestDistanceBladeToShield(
+                weapon.basePosition, weapon.tipPosition,
+                shield.centerPosition, shield.normal, shield.radius,
+                bladeParam, bladePoint, shieldPoint
+            );
+        }
         
     outResult.closestDistance = distance;
         outResult.weaponParameter = bladeParam;
@@ -566,6 +597,47 @@ return false;
         return minDist;
 }
 
+    float ShieldCollisionTracker::ClosestDistanceBladeToShieldField(
+        const NiPoint3& bladeBase, const NiPoint3& bladeTip, const NiTransform& shieldTransform,
+        float& outBladeParam, NiPoint3& outBladePoint, NiPoint3& outShieldPoint)
+    {
+        std::chrono::high_resolution_clock::time_point startTime;
+        if (collisionProfiling)
+            startTime = std::chrono::high_resolution_clock::now();
+
+        // Into the shield node's space: local = R^T * (world - pos) / scale
+        const NiMatrix33& rot = shieldTransform.rot;
+        float scale = shieldTransform.scale > 0.0001f ? shieldTransform.scale : 1.0f;
+        auto toLocal = [&](const NiPoint3& world) {
+            NiPoint3 d(world.x - shieldTransform.pos.x, world.y - shieldTransform.pos.y, world.z - shieldTransform.pos.z);
+            return NiPoint3(
+                (rot.data[0][0] * d.x + rot.data[1][0] * d.y + rot.data[2][0] * d.z) / scale,
+                (rot.data[0][1] * d.x + rot.data[1][1] * d.y + rot.data[2][1] * d.z) / scale,
+                (rot.data[0][2] * d.x + rot.data[1][2] * d.y + rot.data[2][2] * d.z) / scale);
+        };
+        auto toWorld = [&](const NiPoint3& local) {
+            return NiPoint3(
+                (rot.data[0][0] * local.x + rot.data[0][1] * local.y + rot.data[0][2] * local.z) * scale + shieldTransform.pos.x,
+                (rot.data[1][0] * local.x + rot.data[1][1] * local.y + rot.data[1][2] * local.z) * scale + shieldTransform.pos.y,
+                (rot.data[2][0] * local.x + rot.data[2][1] * local.y + rot.data[2][2] * local.z) * scale + shieldTransform.pos.z);
+        };
+
+        FieldContact contact;
+        SegmentDistanceField(m_shieldField, toLocal(bladeBase), toLocal(bladeTip), contact);
+
+        outBladeParam = contact.segmentParam;
+        outBladePoint = toWorld(contact.segmentPoint);
+        outShieldPoint = toWorld(contact.surfacePoint);
+
+        m_fieldQueryCount++;
+        m_fieldSampleCount += contact.samples;
+        if (collisionProfiling)
+            m_fieldNs += std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - startTime).count();
+
+        // A blade inside the shell is touching it - the disc never goes below zero either
+        return std::max(contact.distance * scale, 0.0f);
+    }
+
     NiPoint3 ShieldCollisionTracker::ProjectPointOntoPlane(
     const NiPoint3& point, const NiPoint3& planePoint, const NiPoint3& planeNormal)
     {
@@ -681,9 +753,4 @@ NiPoint3 projected = ProjectPointOntoPlane(point, center, normal);
     {
         ShieldCollisionTracker::GetSingleton()->Initialize();
     }
-
-    void UpdateShieldCollision(float deltaTime)
-    {
-        ShieldCollisionTracker::GetSingleton()->Update(deltaTime);
-    }
 }
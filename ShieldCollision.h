@@ -8,6 +8,7 @@
 #include "config.h"
 #include "EquipManager.h"
 #include "WeaponGeometry.h"
+#include "WeaponProfileDB.h"
 
 namespace FalseEdgeVR
 {
@@ -22,6 +23,8 @@ namespace FalseEdgeVR
    
      // Previous frame position for velocity calculation
    NiPoint3 prevCenterPosition;
+
+        NiTransform nodeTransform;  // Shield node world transform (distance field space)
         
         void Clear()
  {
@@ -89,8 +92,19 @@ namespace FalseEdgeVR
         // Initialize the tracker
         void Initialize();
         
-   // Update shield geometry and check collisions - call this each frame
-        void Update(float deltaTime);
+   // Geometry phase of the CollisionWorld step - shield hand and shield geometry from the hands it resolved
+        // handsChanged: CollisionWorld re-read the equipped forms this step
+        void UpdateGeometry(float deltaTime, const CollisionHand* hands, bool handsChanged);
+        
+        // Pair phase: weapon-vs-shield check and its reactions
+        // False unless the blade is in the shield's weapon hand and that hand holds a weapon (equipped or HIGGS-grabbed)
+        bool ProcessWeaponPair(const Collider& blade, const Collider& shield, ShieldCollisionResult& outResult);
+        
+        // End of the step - contact state clears if the pair didn't run
+        void FinishUpdate();
+        
+        // Forget shield/weapon positions and contact state (tracking went dormant - next update starts fresh)
+        void ResetGeometry();
       
       // Get shield geometry for a specific hand
         const ShieldGeometry& GetShieldGeometry(bool isLeftHand) const;
@@ -105,8 +119,8 @@ namespace FalseEdgeVR
   // Shield Collision Detection
    // ============================================
         
-      // Check if weapon is colliding with shield
-      bool CheckWeaponShieldCollision(ShieldCollisionResult& outResult, bool rightHandHiggsGrabbed = false);
+      // Check if the weapon hand's blade is colliding with the shield
+      bool CheckWeaponShieldCollision(const BladeGeometry& weapon, const ShieldGeometry& shield, ShieldCollisionResult& outResult);
       
      // Get the last collision result
         const ShieldCollisionResult& GetLastCollisionResult() const { return m_lastCollision; }
@@ -137,9 +151,6 @@ namespace FalseEdgeVR
   // Update geometry for shield
         void UpdateShieldGeometry(bool isLeftHand, float deltaTime);
      
-     // Update geometry for HIGGS-grabbed weapon
-        void UpdateHiggsGrabbedWeaponGeometry(TESObjectREFR* grabbedRef, float deltaTime);
- 
         // Get the shield node from player skeleton
         NiAVObject* GetShieldNode(bool isLeftHand);
         
@@ -153,6 +164,12 @@ namespace FalseEdgeVR
        float& outBladeParam, NiPoint3& outBladePoint, NiPoint3& outShieldPoint
         );
         
+        // Same, against the shield mesh's distance field (m_shieldField) - distances in world units
+        float ClosestDistanceBladeToShieldField(
+            const NiPoint3& bladeBase, const NiPoint3& bladeTip, const NiTransform& shieldTransform,
+            float& outBladeParam, NiPoint3& outBladePoint, NiPoint3& outShieldPoint
+        );
+        
         // Estimate time to collision
         float EstimateTimeToCollision(float distance, float closingVelocity);
     
@@ -174,24 +191,31 @@ namespace FalseEdgeVR
         
         ShieldGeometry m_leftHandShield;
      ShieldGeometry m_rightHandShield;
-        BladeGeometry m_higgsGrabbedWeapon;   // For tracking HIGGS-grabbed right hand weapon
         ShieldCollisionResult m_lastCollision;
     ShieldCollisionCallback m_collisionCallback = nullptr;
  
         bool m_initialized = false;
         bool m_shieldInLeftHand = true;     // Which hand has shield
         bool m_hasShield = false;       // Whether shield is equipped
+        bool m_otherHandHasWeapon = false;      // Whether the non-shield hand has a weapon equipped
+        bool m_pairProcessed = false;           // ProcessWeaponPair ran this step
+        float m_shieldFaceRadius = 0.0f;        // Measured face radius from the shield's profile (0 = use ShieldRadius)
+        BladeProfileFieldView m_shieldField;    // Distance field from the shield's profile (samples null = use the disc)
         bool m_weaponContactingShield = false;
 bool m_wasContacting = false;       // Previous frame contact state
  bool m_collisionImminent = false;
         bool m_wasImminent = false;             // Previous frame imminent state
         float m_collisionThreshold = 8.0f;      // Distance threshold for collision
   float m_imminentThreshold = 15.0f;  // Distance threshold for imminent collision
+
+        // Distance field stats (with [General] Profiling the disc is timed on every 8th query for comparison)
+        int m_fieldQueryCount = 0;
+        int m_fieldSampleCount = 0;
+        double m_fieldNs = 0.0;
+        int m_discQueryCount = 0;
+        double m_discNs = 0.0;
     };
     
     // Convenience function to initialize shield collision tracking
     void InitializeShieldCollisionTracker();
-    
-    // Convenience function to update shield collision (call each frame)
-    void UpdateShieldCollision(float deltaTime);
 }
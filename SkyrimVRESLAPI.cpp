@@ -1,5 +1,10 @@
 #include "SkyrimVRESLAPI.h"
 #include <random>
+#include <chrono>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <mutex>
 // Interface code based on https://github.com/adamhynek/higgs
 
 // Stores the API after it has already been fetched
@@ -38,62 +43,187 @@ template <typename I> static inline std::string num2hex(I w, size_t hex_len = si
 	return rc;
 }
 
-const ModInfo* NEWLookupAllLoadedModByName(const char* modName)
+// Case-insensitive plugin name index. Keys point into ModInfo::name, which lives as long as the game.
+struct ModNameHash
 {
-	DataHandler* dataHandler = DataHandler::GetSingleton();
-	if (dataHandler)
+	std::size_t operator()(std::string_view name) const
 	{
-		if (!g_SkyrimVRESLInterface)
+		// FNV-1a over the lowercased name
+		std::size_t hash = 14695981039346656037ULL;
+		for (char c : name)
 		{
-			return dataHandler->LookupLoadedModByName(modName);
+			hash ^= (std::size_t)::tolower((unsigned char)c);
+			hash *= 1099511628211ULL;
 		}
-		else
+		return hash;
+	}
+};
+
+struct ModNameEqual
+{
+	bool operator()(std::string_view a, std::string_view b) const
+	{
+		return a.size() == b.size() && _strnicmp(a.data(), b.data(), a.size()) == 0;
+	}
+};
+
+typedef std::unordered_map<std::string_view, const ModInfo*, ModNameHash, ModNameEqual> ModNameIndex;
+
+// Everything below is reached from the equip event sinks as well as the game thread - s_modIndexLock guards it all
+static std::mutex s_modIndexLock;
+
+static ModNameIndex s_fullModIndex;     // DataHandler loadedMods
+static ModNameIndex s_lightModIndex;    // SkyrimVRESL smallFiles
+
+// What the index was built from - any change triggers a rebuild on the next lookup
+static bool s_modIndexBuilt = false;
+static const SkyrimVRESLPluginAPI::ISkyrimVRESLInterface001* s_indexedInterface = nullptr;
+static const SkyrimVRESLPluginAPI::TESFileCollection* s_indexedCollection = nullptr;
+static UInt32 s_indexedFullCount = 0;
+static UInt32 s_indexedLightCount = 0;
+
+// Memoized (plugin, base FormID) -> full FormID. Key is the name hash in the high half, base FormID in the low half;
+// the entry's ModInfo name is compared on a hit so a hash collision can't return the wrong plugin's form.
+struct FullFormIdMemoEntry
+{
+	const ModInfo* modInfo = nullptr;
+	UInt32 fullFormID = 0;
+};
+static std::unordered_map<UInt64, FullFormIdMemoEntry> s_fullFormIdMemo;
+static UInt32 s_memoLookups = 0;
+static UInt32 s_memoHits = 0;
+static std::unordered_set<const ModInfo*> s_loggedModInfos;    // Plugins whose ModInfo was already logged
+
+static void AddModsToIndex(ModNameIndex& index, const tArray<ModInfo*>& mods)
+{
+	for (UInt32 i = 0; i < mods.count; i++)
+	{
+		ModInfo* modInfo = nullptr;
+		mods.GetNthItem(i, modInfo);
+		if (modInfo != nullptr)
 		{
-			const ModInfo* modInfo = dataHandler->LookupLoadedModByName(modName);
-			if (modInfo == nullptr)
-			{
-				modInfo = NEWLookupLoadedLightModByName(modName);
-			}
-			return modInfo;
+			// First entry wins, same as the linear scans this replaces
+			index.emplace(std::string_view(modInfo->name), modInfo);
 		}
 	}
+}
+
+static void BuildModNameIndexLocked()
+{
+	DataHandler* dataHandler = DataHandler::GetSingleton();
+	if (!dataHandler)
+	{
+		return;
+	}
+
+	auto startTime = std::chrono::high_resolution_clock::now();
+
+	const SkyrimVRESLPluginAPI::TESFileCollection* fileCollection =
+		g_SkyrimVRESLInterface ? g_SkyrimVRESLInterface->GetCompiledFileCollection() : nullptr;
+
+	s_fullModIndex.clear();
+	s_lightModIndex.clear();
+	s_fullFormIdMemo.clear();
+	s_loggedModInfos.clear();
+
+	s_fullModIndex.reserve(dataHandler->modList.loadedMods.count);
+	AddModsToIndex(s_fullModIndex, dataHandler->modList.loadedMods);
+
+	if (fileCollection != nullptr)
+	{
+		s_lightModIndex.reserve(fileCollection->smallFiles.count);
+		AddModsToIndex(s_lightModIndex, fileCollection->smallFiles);
+	}
+
+	s_indexedInterface = g_SkyrimVRESLInterface;
+	s_indexedCollection = fileCollection;
+	s_indexedFullCount = dataHandler->modList.loadedMods.count;
+	s_indexedLightCount = fileCollection ? fileCollection->smallFiles.count : 0;
+	s_modIndexBuilt = true;
+
+	double buildMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count();
+	_MESSAGE("SkyrimVRESL: Indexed %d full + %d light plugins in %.3fms", (int)s_fullModIndex.size(), (int)s_lightModIndex.size(), buildMs);
+}
+
+void BuildModNameIndex()
+{
+	std::lock_guard<std::mutex> lock(s_modIndexLock);
+	BuildModNameIndexLocked();
+}
+
+// Rebuild when the SkyrimVRESL interface, its collection or the plugin counts differ from what was indexed (lock held)
+static void EnsureModNameIndexLocked()
+{
+	DataHandler* dataHandler = DataHandler::GetSingleton();
+	if (!dataHandler)
+	{
+		return;
+	}
+
+	const SkyrimVRESLPluginAPI::TESFileCollection* fileCollection =
+		g_SkyrimVRESLInterface ? g_SkyrimVRESLInterface->GetCompiledFileCollection() : nullptr;
+	UInt32 lightCount = fileCollection ? fileCollection->smallFiles.count : 0;
+
+	if (s_modIndexBuilt &&
+		s_indexedInterface == g_SkyrimVRESLInterface &&
+		s_indexedCollection == fileCollection &&
+		s_indexedFullCount == dataHandler->modList.loadedMods.count &&
+		s_indexedLightCount == lightCount)
+	{
+		return;
+	}
+
+	BuildModNameIndexLocked();
+}
+
+static const ModInfo* FindInIndex(const ModNameIndex& index, const char* modName)
+{
+	auto it = index.find(std::string_view(modName));
+	return it != index.end() ? it->second : nullptr;
+}
+
+// Lock held
+static const ModInfo* LookupAllLoadedModLocked(const char* modName)
+{
+	EnsureModNameIndexLocked();
+
+	const ModInfo* modInfo = FindInIndex(s_fullModIndex, modName);
+	if (modInfo == nullptr && g_SkyrimVRESLInterface)
+	{
+		modInfo = FindInIndex(s_lightModIndex, modName);
+	}
+	return modInfo;
+}
+
+const ModInfo* NEWLookupAllLoadedModByName(const char* modName)
+{
+	DataHandler* dataHandler = DataHandler::GetSingleton();
+	if (dataHandler)
+	{
+		std::lock_guard<std::mutex> lock(s_modIndexLock);
+		return LookupAllLoadedModLocked(modName);
+	}
 	return nullptr;
 }
 
 const ModInfo* NEWLookupLoadedLightModByName(const char* modName)
 {
+	DataHandler* dataHandler = DataHandler::GetSingleton();
+	if (!dataHandler)
+	{
+		return nullptr;
+	}
+
+	std::lock_guard<std::mutex> lock(s_modIndexLock);
+	EnsureModNameIndexLocked();
+
 	if (!g_SkyrimVRESLInterface)
 	{
-		DataHandler* dataHandler = DataHandler::GetSingleton();
-		if (dataHandler)
-		{
-			return dataHandler->LookupLoadedModByName(modName);
-		}
-		else
-		{
-			return nullptr;
-		}
+		return FindInIndex(s_fullModIndex, modName);
 	}
 	else
 	{
-		const SkyrimVRESLPluginAPI::TESFileCollection* fileCollection = g_SkyrimVRESLInterface->GetCompiledFileCollection();
-		if (fileCollection != nullptr)
-		{
-			for (int i = 0; i < fileCollection->smallFiles.count; i++)
-			{
-				ModInfo* smallFile = nullptr;
-				fileCollection->smallFiles.GetNthItem(i, smallFile);
-				if (smallFile != nullptr)
-				{
-					int modNameLength = strlen(modName);
-					if (modNameLength == strlen(smallFile->name) && _strnicmp(smallFile->name, modName, modNameLength) == 0)
-					{
-						return smallFile;
-					}
-				}
-			}
-		}
-		return nullptr;
+		return FindInIndex(s_lightModIndex, modName);
 	}
 }
 
@@ -104,11 +234,7 @@ TESForm* ParseFormFromSplitted(std::vector<std::string>& splittedByPlugin)
 		DataHandler* dataHandler = DataHandler::GetSingleton();
 		if (dataHandler)
 		{
-			const ModInfo* modInfo = dataHandler->LookupLoadedModByName(splittedByPlugin[0].c_str());
-			if (modInfo == nullptr)
-			{
-				modInfo = NEWLookupLoadedLightModByName(splittedByPlugin[0].c_str());
-			}
+			const ModInfo* modInfo = NEWLookupAllLoadedModByName(splittedByPlugin[0].c_str());
 			if (modInfo != nullptr && modInfo->IsActive())
 			{
 				UInt32 formLower = getHex(splittedByPlugin[1].c_str());
@@ -148,33 +274,63 @@ static inline UInt32 GetBaseFormID(UInt32 formId)
 	return formId & 0x00FFFFFF;
 }
 
-UInt32 GetFullFormIdFromEspAndFormId(const char* espName, UInt32 baseFormId)
+UInt32 GetFullFormIdMemoized(const char* espName, UInt32 baseFormId)
 {
-	UInt32 fullFormID = 0;
-
-	std::string espNameStr = espName;
-	std::transform(espNameStr.begin(), espNameStr.end(), espNameStr.begin(), ::tolower);
+	if (_stricmp(espName, "skyrim.esm") == 0)
+	{
+		return baseFormId;
+	}
 
-	if (espNameStr == "skyrim.esm")
+	DataHandler* dataHandler = DataHandler::GetSingleton();
+	if (!dataHandler)
 	{
-		fullFormID = baseFormId;
+		return 0;
 	}
-	else
+
+	std::lock_guard<std::mutex> lock(s_modIndexLock);
+
+	// Rebuilding the index also drops the memo
+	EnsureModNameIndexLocked();
+
+	UInt64 key = (UInt64(ModNameHash()(std::string_view(espName)) & 0xFFFFFFFF) << 32) | baseFormId;
+	s_memoLookups++;
+
+	auto it = s_fullFormIdMemo.find(key);
+	if (it != s_fullFormIdMemo.end() && _stricmp(it->second.modInfo->name, espName) == 0)
 	{
-		DataHandler* dataHandler = DataHandler::GetSingleton();
+		s_memoHits++;
+		return it->second.fullFormID;
+	}
 
-		if (dataHandler)
+	UInt32 fullFormID = 0;
+	const ModInfo* modInfo = LookupAllLoadedModLocked(espName);
+	if (modInfo)
+	{
+		if (s_loggedModInfos.insert(modInfo).second)
 		{
-			const ModInfo* modInfo = NEWLookupAllLoadedModByName(espName);
-			if (modInfo)
-			{
-				_MESSAGE("Modinfo %x - %x - %s", modInfo->modIndex, modInfo->lightIndex, modInfo->name);
-				if (IsValidModIndex(modInfo->modIndex)) //If plugin is in the load order.
-				{
-					fullFormID = GetFullFormID(modInfo, GetBaseFormID(baseFormId));
-				}
-			}
+			_MESSAGE("Modinfo %x - %x - %s", modInfo->modIndex, modInfo->lightIndex, modInfo->name);
 		}
+		if (IsValidModIndex(modInfo->modIndex)) //If plugin is in the load order.
+		{
+			fullFormID = GetFullFormID(modInfo, GetBaseFormID(baseFormId));
+
+			FullFormIdMemoEntry entry;
+			entry.modInfo = modInfo;
+			entry.fullFormID = fullFormID;
+			s_fullFormIdMemo[key] = entry;
+		}
+	}
+
+	if (s_memoLookups % 500 == 0)
+	{
+		_MESSAGE("SkyrimVRESL: FormID memo - %u lookups, %u hits (%.1f%%), %d entries",
+			s_memoLookups, s_memoHits, 100.0f * s_memoHits / s_memoLookups, (int)s_fullFormIdMemo.size());
 	}
+
 	return fullFormID;
 }
+
+UInt32 GetFullFormIdFromEspAndFormId(const char* espName, UInt32 baseFormId)
+{
+	return GetFullFormIdMemoized(espName, baseFormId);
+}
@@ -111,3 +111,11 @@ const ModInfo* NEWLookupLoadedLightModByName(const char* modName);
 TESForm* ParseFormFromSplitted(std::vector<std::string>& splittedByPlugin);
 
 UInt32 GetFullFormIdFromEspAndFormId(const char* espName, UInt32 baseFormId);
+
+// Case-insensitive hash index of full and light plugin names, used by the lookups above.
+// Built after kMessage_DataLoaded; rebuilt on the next lookup if the SkyrimVRESL interface or its collection changes.
+// The index and memo are guarded by a lock - these are safe to call from the equip event sinks.
+void BuildModNameIndex();
+
+// (plugin, base FormID) -> full FormID, memoized (cleared whenever the name index is rebuilt)
+UInt32 GetFullFormIdMemoized(const char* espName, UInt32 baseFormId);
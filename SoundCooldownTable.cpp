@@ -0,0 +1,125 @@
+#include "SoundCooldownTable.h"
+#include "common/IDebugLog.h"
+#include <chrono>
+
+namespace FalseEdgeVR
+{
+    SoundCooldownTable::SoundCooldownTable(const char* name)
+        : m_name(name), m_evictionCount(0), m_contentionCount(0)
+    {
+        for (UInt32 i = 0; i < kCapacity; i++)
+        {
+            m_slots[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    UInt32 SoundCooldownTable::NowMs()
+    {
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        return (UInt32)std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
+    }
+
+    UInt32 SoundCooldownTable::HomeSlot(UInt32 formID)
+    {
+        // Fibonacci hashing - load order index in the high byte would otherwise cluster
+        return (UInt32)((formID * 2654435769u) >> 26) & (kCapacity - 1);
+    }
+
+    void SoundCooldownTable::Record(UInt32 formID)
+    {
+        if (formID == 0)
+            return;
+
+        UInt32 now = NowMs();
+        UInt64 desired = Pack(formID, now);
+        UInt32 home = HomeSlot(formID);
+
+        for (int attempt = 0; attempt < kMaxCasAttempts; attempt++)
+        {
+            UInt32 victim = home;
+            UInt32 victimAge = 0;
+            bool victimLive = false;
+            bool raced = false;
+
+            for (UInt32 probe = 0; probe < kProbeLength; probe++)
+            {
+                UInt32 index = (home + probe) & (kCapacity - 1);
+                UInt64 current = m_slots[index].load(std::memory_order_acquire);
+
+                if (current == 0 || SlotFormID(current) == formID)
+                {
+                    // Free slot, or our own entry - claim/refresh it
+                    if (m_slots[index].compare_exchange_strong(current, desired, std::memory_order_acq_rel))
+                        return;
+
+                    m_contentionCount.fetch_add(1, std::memory_order_relaxed);
+                    raced = true;
+                    break;
+                }
+
+                // Least recently recorded slot in the window is the eviction candidate
+                UInt32 age = now - SlotTime(current);
+                if (age >= victimAge)
+                {
+                    victim = index;
+                    victimAge = age;
+                    victimLive = true;
+                }
+            }
+
+            if (raced)
+                continue;   // Lost a race on a free/own slot - rescan
+
+            UInt64 current = m_slots[victim].load(std::memory_order_acquire);
+            if (SlotFormID(current) == formID || (now - SlotTime(current)) >= victimAge)
+            {
+                if (m_slots[victim].compare_exchange_strong(current, desired, std::memory_order_acq_rel))
+                {
+                    if (victimLive)
+                    {
+                        UInt32 evictions = m_evictionCount.fetch_add(1, std::memory_order_relaxed) + 1;
+                        _MESSAGE("SoundCooldownTable: %s - evicted %08X (%u ms old) for %08X (%u evictions, %u contended writes)",
+                            m_name, SlotFormID(current), victimAge, formID, evictions, GetContentionCount());
+                    }
+                    return;
+                }
+            }
+
+            m_contentionCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Every attempt raced another writer - dropping one timestamp only means one extra sound
+        _MESSAGE("SoundCooldownTable: %s - gave up recording %08X after %d contended attempts", m_name, formID, kMaxCasAttempts);
+    }
+
+    bool SoundCooldownTable::IsCoolingDown(UInt32 formID, UInt32 cooldownMs, UInt32& elapsedMs) const
+    {
+        elapsedMs = 0;
+        if (formID == 0)
+            return false;
+
+        UInt32 now = NowMs();
+        UInt32 home = HomeSlot(formID);
+        bool found = false;
+
+        for (UInt32 probe = 0; probe < kProbeLength; probe++)
+        {
+            UInt64 current = m_slots[(home + probe) & (kCapacity - 1)].load(std::memory_order_acquire);
+            if (current == 0)
+                break;   // Slots are never emptied, so the key can't be further along
+
+            if (SlotFormID(current) != formID)
+                continue;
+
+            // Racing evictions can briefly leave two entries - the newest one counts
+            UInt32 elapsed = now - SlotTime(current);
+            if (!found || elapsed < elapsedMs)
+            {
+                elapsedMs = elapsed;
+                found = true;
+            }
+        }
+
+        return found && elapsedMs < cooldownMs;
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "skse64/GameTypes.h"
+#include <atomic>
+
+namespace FalseEdgeVR
+{
+    // ============================================
+    // SoundCooldownTable
+    // ============================================
+    // Per-weapon timestamps for the draw/sheath sound cooldowns, safe to use from
+    // equip event sinks on any thread without a mutex.
+    // Fixed capacity open-addressing table keyed by FormID. Each slot is a single
+    // atomic (FormID << 32 | milliseconds), so a reader never sees a FormID paired
+    // with another weapon's time. Checks read at most kProbeLength slots and never
+    // allocate; records CAS into the first matching or free slot and otherwise evict
+    // the least recently recorded slot in the probe window.
+    // ============================================
+
+    class SoundCooldownTable
+    {
+    public:
+        explicit SoundCooldownTable(const char* name);
+
+        // Remember that the weapon's cooldown starts now
+        void Record(UInt32 formID);
+
+        // True if Record was called for this weapon less than cooldownMs ago (elapsedMs = time since)
+        bool IsCoolingDown(UInt32 formID, UInt32 cooldownMs, UInt32& elapsedMs) const;
+
+        // Stats
+        UInt32 GetEvictionCount() const { return m_evictionCount.load(std::memory_order_relaxed); }
+        UInt32 GetContentionCount() const { return m_contentionCount.load(std::memory_order_relaxed); }
+
+    private:
+        SoundCooldownTable(const SoundCooldownTable&) = delete;
+        SoundCooldownTable& operator=(const SoundCooldownTable&) = delete;
+
+        static const UInt32 kCapacity = 64;        // Power of two
+        static const UInt32 kProbeLength = 8;
+        static const int kMaxCasAttempts = 4;
+
+        static UInt64 Pack(UInt32 formID, UInt32 timeMs) { return ((UInt64)formID << 32) | timeMs; }
+        static UInt32 SlotFormID(UInt64 slot) { return (UInt32)(slot >> 32); }
+        static UInt32 SlotTime(UInt64 slot) { return (UInt32)(slot & 0xFFFFFFFF); }
+
+        // Milliseconds on the steady clock (wraps after ~49 days - elapsed times use unsigned subtraction)
+        static UInt32 NowMs();
+
+        static UInt32 HomeSlot(UInt32 formID);
+
+        const char* m_name;
+        std::atomic<UInt64> m_slots[kCapacity];   // 0 = empty (FormID 0 is never a weapon)
+
+        mutable std::atomic<UInt32> m_evictionCount;    // Live entries replaced because the probe window was full
+        mutable std::atomic<UInt32> m_contentionCount;  // CAS lost to another thread writing the same slot
+    };
+}
@@ -0,0 +1,404 @@
+#include "ThresholdCalibration.h"
+#include "WeaponGeometry.h"
+#include "config.h"
+#include "common/IDebugLog.h"
+#include <algorithm>
+#include <cfloat>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace FalseEdgeVR
+{
+    // ============================================
+    // P2Quantile
+    // ============================================
+
+    void P2Quantile::Reset(float quantile)
+    {
+        m_quantile = quantile;
+        m_count = 0;
+
+        const float increments[5] = { 0.0f, quantile / 2.0f, quantile, (1.0f + quantile) / 2.0f, 1.0f };
+        for (int i = 0; i < 5; i++)
+        {
+            m_heights[i] = 0.0f;
+            m_positions[i] = (float)(i + 1);
+            m_increments[i] = increments[i];
+        }
+    }
+
+    void P2Quantile::Add(float x)
+    {
+        // First five samples are kept sorted as the initial markers
+        if (m_count < 5)
+        {
+            int i = (int)m_count++;
+            while (i > 0 && m_heights[i - 1] > x)
+            {
+                m_heights[i] = m_heights[i - 1];
+                i--;
+            }
+            m_heights[i] = x;
+            return;
+        }
+
+        // Cell the sample falls in, stretching the end markers if it's a new extreme
+        int cell;
+        if (x < m_heights[0])
+        {
+            m_heights[0] = x;
+            cell = 0;
+        }
+        else if (x >= m_heights[4])
+        {
+            m_heights[4] = x;
+            cell = 3;
+        }
+        else
+        {
+            cell = 0;
+            while (cell < 3 && x >= m_heights[cell + 1])
+                cell++;
+        }
+
+        for (int i = cell + 1; i < 5; i++)
+            m_positions[i] += 1.0f;
+        m_count++;
+
+        // Move the middle markers a step towards their desired positions, parabolic if it stays ordered.
+        // Desired positions come straight from the count - summing the increments drifts over long sessions
+        for (int i = 1; i < 4; i++)
+        {
+            float desired = 1.0f + (float)(m_count - 1) * m_increments[i];
+            float offset = desired - m_positions[i];
+            if ((offset >= 1.0f && m_positions[i + 1] - m_positions[i] > 1.0f) ||
+                (offset <= -1.0f && m_positions[i - 1] - m_positions[i] < -1.0f))
+            {
+                float step = offset >= 0.0f ? 1.0f : -1.0f;
+                float parabolic = m_heights[i] + step / (m_positions[i + 1] - m_positions[i - 1]) *
+                    ((m_positions[i] - m_positions[i - 1] + step) * (m_heights[i + 1] - m_heights[i]) / (m_positions[i + 1] - m_positions[i]) +
+                     (m_positions[i + 1] - m_positions[i] - step) * (m_heights[i] - m_heights[i - 1]) / (m_positions[i] - m_positions[i - 1]));
+
+                if (m_heights[i - 1] < parabolic && parabolic < m_heights[i + 1])
+                {
+                    m_heights[i] = parabolic;
+                }
+                else
+                {
+                    int neighbour = i + (int)step;
+                    m_heights[i] += step * (m_heights[neighbour] - m_heights[i]) / (m_positions[neighbour] - m_positions[i]);
+                }
+                m_positions[i] += step;
+            }
+        }
+    }
+
+    float P2Quantile::Value() const
+    {
+        if (m_count == 0)
+            return 0.0f;
+        if (m_count < 5)
+            return m_heights[(int)(m_quantile * (m_count - 1) + 0.5f)];
+        return m_heights[2];
+    }
+
+    void P2Quantile::GetMarkers(float outHeights[5], float outPositions[5]) const
+    {
+        for (int i = 0; i < 5; i++)
+        {
+            outHeights[i] = m_heights[i];
+            outPositions[i] = m_positions[i];
+        }
+    }
+
+    bool P2Quantile::SetMarkers(UInt32 count, const float heights[5], const float positions[5])
+    {
+        Reset(m_quantile);
+        if (count == 0)
+            return true;
+
+        // Saved state has to be ordered, or later updates divide by zero / run off the ends
+        UInt32 used = count < 5 ? count : 5;
+        for (UInt32 i = 1; i < used; i++)
+        {
+            if (heights[i] < heights[i - 1])
+                return false;
+            if (count >= 5 && positions[i] <= positions[i - 1])
+                return false;
+        }
+        if (count >= 5 && (positions[0] != 1.0f || positions[4] != (float)count))
+            return false;
+
+        m_count = count;
+        for (UInt32 i = 0; i < used; i++)
+        {
+            m_heights[i] = heights[i];
+            if (count >= 5)
+                m_positions[i] = positions[i];
+        }
+        return true;
+    }
+
+    // ============================================
+    // ThresholdCalibration
+    // ============================================
+
+    // Seconds of warning the imminent threshold should give - covers the unequip swap (see PredictionTime)
+    static const float CALIBRATION_LEAD_TIME = 0.033f;
+    // The least it may give, once pulled in towards the player's close passes (one frame at 90Hz)
+    static const float CALIBRATION_MIN_LEAD_TIME = 0.011f;
+    // Slower approaches are grinding or resting blades together, not swings
+    static const float CALIBRATION_MIN_APPROACH_SPEED = 50.0f;
+    // No detailed check for this long ends the approach (weapon unequipped, tracking paused)
+    static const float CALIBRATION_APPROACH_GAP = 0.25f;
+    static const UInt32 CALIBRATION_MIN_APPROACHES = 100;
+    static const UInt32 CALIBRATION_MIN_PASSES = 30;
+    static const int CALIBRATION_RECOMPUTE_INTERVAL = 25;
+
+    static std::string GetCalibrationPath()
+    {
+        return GetRuntimeDirectory() + "Data\\SKSE\\Plugins\\FalseEdgeVR_Calibration.ini";
+    }
+
+    ThresholdCalibration* ThresholdCalibration::GetSingleton()
+    {
+        static ThresholdCalibration instance;
+        return &instance;
+    }
+
+    void ThresholdCalibration::Load()
+    {
+        std::ifstream file(GetCalibrationPath());
+        if (file.is_open())
+        {
+            std::string line;
+            while (std::getline(file, line))
+            {
+                trim(line);
+                skipComments(line);
+                if (line.empty() || line[0] == '[')
+                    continue;
+
+                std::string variableName;
+                std::string variableValueStr = GetConfigSettingsStringValue(line, variableName);
+
+                P2Quantile* estimator = nullptr;
+                if (variableName == "ApproachSpeed90")
+                    estimator = &m_approachSpeed90;
+                else if (variableName == "ApproachSpeed99")
+                    estimator = &m_approachSpeed99;
+                else if (variableName == "PassDistance10")
+                    estimator = &m_passDistance10;
+                if (!estimator)
+                    continue;
+
+                // count, 5 heights, 5 positions
+                std::istringstream values(variableValueStr);
+                UInt32 count = 0;
+                float heights[5] = {};
+                float positions[5] = {};
+                values >> count;
+                for (int i = 0; i < 5; i++)
+                    values >> heights[i];
+                for (int i = 0; i < 5; i++)
+                    values >> positions[i];
+                if (values.fail() || !estimator->SetMarkers(count, heights, positions))
+                    _MESSAGE("ThresholdCalibration: Ignoring bad %s line in FalseEdgeVR_Calibration.ini", variableName.c_str());
+            }
+
+            _MESSAGE("ThresholdCalibration: Loaded %u approaches, %u close passes",
+                m_approachSpeed90.Count(), m_passDistance10.Count());
+        }
+
+        OnConfigLoaded();
+    }
+
+    void ThresholdCalibration::OnConfigLoaded()
+    {
+        m_configImminent = bladeImminentThreshold;
+        m_configBackup = bladeImminentThresholdBackup;
+        m_configTimeToCollision = bladeTimeToCollisionThreshold;
+
+        // The tracker keeps its own copy - put the configured value back unless a suggestion is applied below
+        WeaponGeometryTracker::GetSingleton()->SetImminentThreshold(m_configImminent);
+
+        if (bladeAutoCalibrate == 0)
+            return;
+
+        // Suggestions are clamped against the configured values, so recompute them for these
+        m_hasSuggestion = false;
+        Recompute();
+        if (!m_hasSuggestion)
+        {
+            _MESSAGE("ThresholdCalibration: %u of %u approaches needed before suggesting thresholds",
+                m_approachSpeed90.Count(), CALIBRATION_MIN_APPROACHES);
+        }
+    }
+
+    void ThresholdCalibration::Observe(float time, float distance, float closingSpeed, bool colliding, bool imminent)
+    {
+        if (bladeAutoCalibrate == 0)
+            return;
+
+        if (m_inApproach && time - m_lastObserveTime > CALIBRATION_APPROACH_GAP)
+            EndApproach();
+
+        if (!m_inApproach)
+        {
+            m_inApproach = true;
+            m_approachCounted = false;
+            m_approachMinDistance = FLT_MAX;
+            m_approachPeakSpeed = 0.0f;
+        }
+        m_lastObserveTime = time;
+
+        if (distance < m_approachMinDistance)
+            m_approachMinDistance = distance;
+        if (closingSpeed > m_approachPeakSpeed)
+            m_approachPeakSpeed = closingSpeed;
+
+        // An approach counts once, with the speed it came in at - not what it does while touching
+        if ((colliding || imminent) && !m_approachCounted)
+        {
+            m_approachCounted = true;
+            if (m_approachPeakSpeed >= CALIBRATION_MIN_APPROACH_SPEED)
+            {
+                m_approachSpeed90.Add(m_approachPeakSpeed);
+                m_approachSpeed99.Add(m_approachPeakSpeed);
+
+                if (++m_samplesSinceRecompute >= CALIBRATION_RECOMPUTE_INTERVAL)
+                {
+                    m_samplesSinceRecompute = 0;
+                    Recompute();
+                    QueueSave();
+                }
+            }
+        }
+    }
+
+    void ThresholdCalibration::ObserveApart()
+    {
+        if (m_inApproach)
+            EndApproach();
+    }
+
+    void ThresholdCalibration::EndApproach()
+    {
+        // Came close and left again without touching or being flagged - a pass the player made on purpose
+        if (!m_approachCounted && m_approachMinDistance < FLT_MAX)
+            m_passDistance10.Add(m_approachMinDistance);
+        m_inApproach = false;
+    }
+
+    void ThresholdCalibration::Recompute()
+    {
+        if (m_approachSpeed90.Count() < CALIBRATION_MIN_APPROACHES)
+            return;
+
+        float collision = bladeCollisionThreshold;
+        float speed90 = std::max(m_approachSpeed90.Value(), CALIBRATION_MIN_APPROACH_SPEED);
+        float speed99 = std::max(m_approachSpeed99.Value(), speed90);
+
+        // Far enough out that a fast approach is caught a swap ahead of contact...
+        float imminent = collision + speed90 * CALIBRATION_LEAD_TIME;
+
+        // ...unless the player's own close passes come nearer - then stay under them while still a frame ahead
+        bool usedPasses = false;
+        if (m_passDistance10.Count() >= CALIBRATION_MIN_PASSES)
+        {
+            float pass = m_passDistance10.Value();
+            if (pass < imminent)
+            {
+                imminent = std::max(pass, collision + speed90 * CALIBRATION_MIN_LEAD_TIME);
+                usedPasses = true;
+            }
+        }
+
+        float backup = std::max(imminent + 2.0f, collision + speed99 * CALIBRATION_LEAD_TIME);
+        float timeToCollision = (backup - collision) / speed90;
+
+        m_imminent = std::min(std::max(imminent, m_configImminent * 0.5f), m_configImminent * 2.0f);
+        m_backup = std::min(std::max(backup, m_configBackup * 0.5f), m_configBackup * 2.0f);
+        m_backup = std::max(m_backup, m_imminent);
+        m_timeToCollision = std::min(std::max(timeToCollision, m_configTimeToCollision * 0.5f), m_configTimeToCollision * 2.0f);
+        m_hasSuggestion = true;
+
+        _MESSAGE("ThresholdCalibration: %u approaches (p90 %.0f, p99 %.0f units/s), %u close passes (p10 %.1f)%s",
+            m_approachSpeed90.Count(), speed90, speed99, m_passDistance10.Count(), m_passDistance10.Value(),
+            usedPasses ? " - imminent pulled in to the passes" : "");
+        _MESSAGE("ThresholdCalibration: %s ImminentThreshold=%.1f (config %.1f), ImminentThresholdBackup=%.1f (config %.1f), TimeToCollisionThreshold=%.3f (config %.3f)",
+            bladeAutoCalibrate == 2 ? "Applying" : "Suggested",
+            m_imminent, m_configImminent, m_backup, m_configBackup, m_timeToCollision, m_configTimeToCollision);
+
+        if (bladeAutoCalibrate == 2)
+            Apply();
+    }
+
+    void ThresholdCalibration::Apply()
+    {
+        bladeImminentThreshold = m_imminent;
+        bladeImminentThresholdBackup = m_backup;
+        bladeTimeToCollisionThreshold = m_timeToCollision;
+        WeaponGeometryTracker::GetSingleton()->SetImminentThreshold(m_imminent);
+    }
+
+    void ThresholdCalibration::QueueSave()
+    {
+        SavedState state;
+        state.hasSuggestion = m_hasSuggestion;
+        state.imminent = m_imminent;
+        state.backup = m_backup;
+        state.timeToCollision = m_timeToCollision;
+
+        const P2Quantile* estimators[3] = { &m_approachSpeed90, &m_approachSpeed99, &m_passDistance10 };
+        for (int e = 0; e < 3; e++)
+        {
+            state.counts[e] = estimators[e]->Count();
+            estimators[e]->GetMarkers(state.heights[e], state.positions[e]);
+        }
+
+        std::lock_guard<std::mutex> lock(m_saveLock);
+        m_pendingSave = state;
+        m_saveQueued = true;
+    }
+
+    void ThresholdCalibration::FlushSave()
+    {
+        SavedState state;
+        {
+            std::lock_guard<std::mutex> lock(m_saveLock);
+            if (!m_saveQueued)
+                return;
+            state = m_pendingSave;
+            m_saveQueued = false;
+        }
+
+        std::ofstream file(GetCalibrationPath());
+        if (!file.is_open())
+        {
+            _MESSAGE("ThresholdCalibration: Could not write FalseEdgeVR_Calibration.ini");
+            return;
+        }
+        file << "# Written by FalseEdgeVR ([BladeCollision] AutoCalibrate) - delete to start over\n[Calibration]\n";
+
+        char line[256];
+        if (state.hasSuggestion)
+        {
+            snprintf(line, sizeof(line), "ImminentThreshold = %.2f\nImminentThresholdBackup = %.2f\nTimeToCollisionThreshold = %.3f\n",
+                state.imminent, state.backup, state.timeToCollision);
+            file << line;
+        }
+
+        const char* names[3] = { "ApproachSpeed90", "ApproachSpeed99", "PassDistance10" };
+        for (int e = 0; e < 3; e++)
+        {
+            const float* heights = state.heights[e];
+            const float* positions = state.positions[e];
+            snprintf(line, sizeof(line), "%s = %u %.9g %.9g %.9g %.9g %.9g %.9g %.9g %.9g %.9g %.9g\n", names[e], state.counts[e],
+                heights[0], heights[1], heights[2], heights[3], heights[4],
+                positions[0], positions[1], positions[2], positions[3], positions[4]);
+            file << line;
+        }
+    }
+}
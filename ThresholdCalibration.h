@@ -0,0 +1,130 @@
+#pragma once
+
+#include "skse64/NiTypes.h"
+#include <mutex>
+
+namespace FalseEdgeVR
+{
+    // Streaming quantile estimate (P-squared, Jain & Chlamtac): five markers,
+    // constant memory, O(1) per sample. Exact until the fifth sample.
+    class P2Quantile
+    {
+    public:
+        explicit P2Quantile(float quantile = 0.5f) { Reset(quantile); }
+
+        void Reset(float quantile);
+        void Add(float x);
+        float Value() const;
+
+        UInt32 Count() const { return m_count; }
+        float Quantile() const { return m_quantile; }
+
+        // Marker state, for saving between sessions - heights and positions hold min(count, 5) values
+        void GetMarkers(float outHeights[5], float outPositions[5]) const;
+        bool SetMarkers(UInt32 count, const float heights[5], const float positions[5]);
+
+    private:
+        float m_quantile;
+        UInt32 m_count;
+        float m_heights[5];
+        float m_positions[5];           // Actual marker positions (1-based sample ranks)
+        float m_increments[5];          // Desired position step per sample
+    };
+
+    // ============================================
+    // ThresholdCalibration
+    // ============================================
+    // Learns [BladeCollision] ImminentThreshold, ImminentThresholdBackup and
+    // TimeToCollisionThreshold from how the player actually moves their blades.
+    // The blade kernel reports every detailed check; checks between two rejects
+    // form one approach. An approach that touches or gets flagged imminent adds
+    // its peak closing speed, one that does neither adds its closest distance
+    // (a deliberate close pass). Distances and speeds are divided by the
+    // kernel's threshold scale, so a dagger approach asks for the sword-sized
+    // threshold that scales down to what the dagger needs.
+    //
+    // From those quantiles:
+    //   ImminentThreshold        = collision + fast approach speed * lead time,
+    //                              pulled in towards the player's close passes
+    //                              as long as it still leads by a frame
+    //   ImminentThresholdBackup  = collision + fastest approaches * lead time
+    //   TimeToCollisionThreshold = time a fast approach takes to cross the backup band
+    // each kept within half and twice the configured value.
+    //
+    // [BladeCollision] AutoCalibrate: 0 = off, 1 = log the suggestions,
+    // 2 = apply them. Estimator state and the last suggestions persist in
+    // Data\SKSE\Plugins\FalseEdgeVR_Calibration.ini; a recompute only copies
+    // them aside, and FlushSave formats and writes the file when a menu opens.
+    // Game thread only, apart from FlushSave.
+    // ============================================
+
+    class ThresholdCalibration
+    {
+    public:
+        static ThresholdCalibration* GetSingleton();
+
+        // Read the saved state and apply its thresholds when AutoCalibrate=2 (kMessage_DataLoaded, after loadConfig)
+        void Load();
+
+        // Config was (re)loaded - take its thresholds as the base and reapply ours on top
+        void OnConfigLoaded();
+
+        // A detailed blade check: imminence distance and closing speed (+ = approaching), both / threshold scale
+        void Observe(float time, float distance, float closingSpeed, bool colliding, bool imminent);
+
+        // The blades were rejected as out of reach - the current approach is over
+        void ObserveApart();
+
+        // Write the state queued by the last recompute (menu open - keeps file I/O out of the physics step)
+        void FlushSave();
+
+    private:
+        ThresholdCalibration() = default;
+        ~ThresholdCalibration() = default;
+        ThresholdCalibration(const ThresholdCalibration&) = delete;
+        ThresholdCalibration& operator=(const ThresholdCalibration&) = delete;
+
+        void EndApproach();
+        void Recompute();
+        void Apply();
+        void QueueSave();
+
+        // Approach speeds behind the suggestions, and the close passes the imminent threshold should stay under
+        P2Quantile m_approachSpeed90{ 0.90f };
+        P2Quantile m_approachSpeed99{ 0.99f };
+        P2Quantile m_passDistance10{ 0.10f };
+
+        // Current approach
+        bool m_inApproach = false;
+        bool m_approachCounted = false;     // Touched or flagged - its speed is already in
+        float m_approachMinDistance = 0.0f;
+        float m_approachPeakSpeed = 0.0f;
+        float m_lastObserveTime = 0.0f;
+
+        // Configured values (the INI) and the current suggestions
+        float m_configImminent = 0.0f;
+        float m_configBackup = 0.0f;
+        float m_configTimeToCollision = 0.0f;
+        bool m_hasSuggestion = false;
+        float m_imminent = 0.0f;
+        float m_backup = 0.0f;
+        float m_timeToCollision = 0.0f;
+
+        int m_samplesSinceRecompute = 0;
+
+        // State waiting for FlushSave - plain values, so queueing it doesn't allocate on the physics step
+        struct SavedState
+        {
+            bool hasSuggestion;
+            float imminent;
+            float backup;
+            float timeToCollision;
+            UInt32 counts[3];
+            float heights[3][5];
+            float positions[3][5];
+        };
+        std::mutex m_saveLock;
+        SavedState m_pendingSave = {};
+        bool m_saveQueued = false;
+    };
+}
@@ -0,0 +1,136 @@
+#include "TrackingDormancy.h"
+#include "EquipManager.h"
+#include "CollisionWorld.h"
+#include "skse64/GameReferences.h"
+#include "common/IDebugLog.h"
+
+namespace FalseEdgeVR
+{
+    TrackingDormancy* TrackingDormancy::GetSingleton()
+    {
+        static TrackingDormancy instance;
+        return &instance;
+    }
+
+    TrackingDormancy::TrackingDormancy()
+        : m_dormant(false), m_wakeReason(nullptr), m_wakeSequence(0), m_stateStart(std::chrono::steady_clock::now())
+    {
+    }
+
+    void TrackingDormancy::Wake(const char* reason)
+    {
+        // Always bump the sequence - an Evaluate deciding to go dormant right now must see it
+        m_wakeReason.store(reason, std::memory_order_relaxed);
+        m_wakeSequence.fetch_add(1, std::memory_order_acq_rel);
+        m_dormant.store(false, std::memory_order_release);
+    }
+
+    bool TrackingDormancy::HasCollidableState()
+    {
+        PlayerCharacter* player = *g_thePlayer;
+        if (!player || !player->loadedState)
+            return false;
+
+        EquipManager* equipManager = EquipManager::GetSingleton();
+
+        // Avoidance weapon held by HIGGS - tracked whether or not anything is drawn
+        if (equipManager->HasPendingReequip(true) || equipManager->HasPendingReequip(false))
+            return true;
+
+        if (!player->actorState.IsWeaponDrawn())
+            return false;
+
+        // Cached per equip generation - no game query unless equipment changed
+        TESForm* leftEquipped = equipManager->GetEquippedObject(true);
+        TESForm* rightEquipped = equipManager->GetEquippedObject(false);
+        return (leftEquipped && (EquipManager::IsWeapon(leftEquipped) || EquipManager::IsShield(leftEquipped))) ||
+            (rightEquipped && (EquipManager::IsWeapon(rightEquipped) || EquipManager::IsShield(rightEquipped)));
+    }
+
+    void TrackingDormancy::AccountStateTime()
+    {
+        auto now = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(now - m_stateStart).count();
+        m_stateStart = now;
+
+        if (m_accountedDormant)
+        {
+            m_dormantSeconds += seconds;
+            m_windowDormantSeconds += seconds;
+        }
+        else
+        {
+            m_activeSeconds += seconds;
+            m_windowActiveSeconds += seconds;
+        }
+    }
+
+    void TrackingDormancy::Evaluate(float deltaTime)
+    {
+        UInt32 wakeSequence = m_wakeSequence.load(std::memory_order_acquire);
+
+        if (m_accountedDormant)
+        {
+            // Woken since the last awake step
+            AccountStateTime();
+            m_accountedDormant = false;
+            m_idleTime = 0.0f;
+            m_wakeCount++;
+
+            const char* reason = m_wakeReason.exchange(nullptr, std::memory_order_relaxed);
+            _MESSAGE("TrackingDormancy: Woken (%s) - %d wakeups, active %.1fs, dormant %.1fs total",
+                reason ? reason : "unknown", m_wakeCount, m_activeSeconds, m_dormantSeconds);
+        }
+
+        // Any wake (dormant or not) restarts the grace period
+        if (wakeSequence != m_seenWakeSequence)
+        {
+            m_seenWakeSequence = wakeSequence;
+            m_wakeGraceLeft = kWakeGrace;
+        }
+
+        if (HasCollidableState())
+        {
+            m_idleTime = 0.0f;
+            m_wakeGraceLeft = 0.0f;
+            return;
+        }
+
+        if (m_wakeGraceLeft > 0.0f)
+        {
+            m_wakeGraceLeft -= deltaTime;
+            m_idleTime = 0.0f;
+            return;
+        }
+
+        m_idleTime += deltaTime;
+        if (m_idleTime < kDormantDelay)
+            return;
+
+        AccountStateTime();
+        m_accountedDormant = true;
+        m_dormant.store(true, std::memory_order_release);
+
+        // A Wake raced the checks above - stay awake, the next step logs it as a wakeup
+        if (m_wakeSequence.load(std::memory_order_acquire) != wakeSequence)
+        {
+            m_dormant.store(false, std::memory_order_release);
+            return;
+        }
+
+        // Stale positions would turn into a velocity spike on the first step after waking
+        CollisionWorld::GetSingleton()->ResetGeometry();
+
+        _MESSAGE("TrackingDormancy: Nothing collidable for %.1fs - collision tracking dormant (active %.1fs, dormant %.1fs total)",
+            m_idleTime, m_activeSeconds, m_dormantSeconds);
+    }
+
+    void TrackingDormancy::TakeStateTimes(float& activeSeconds, float& dormantSeconds)
+    {
+        AccountStateTime();
+        activeSeconds = (float)m_windowActiveSeconds;
+        dormantSeconds = (float)m_windowDormantSeconds;
+        m_windowActiveSeconds = 0.0;
+        m_windowDormantSeconds = 0.0;
+    }
+}
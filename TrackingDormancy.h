@@ -0,0 +1,70 @@
+#pragma once
+
+#include "skse64/GameTypes.h"
+#include <atomic>
+#include <chrono>
+
+namespace FalseEdgeVR
+{
+    // ============================================
+    // TrackingDormancy
+    // ============================================
+    // Parks the blade/shield collision trackers while there is nothing to track:
+    // no weapon or shield equipped, weapons sheathed, and no avoidance weapon held
+    // by HIGGS. While dormant the pre-physics step only tests IsDormant().
+    // Equip, draw, HIGGS grab, menu close and game load call Wake() (any thread);
+    // the next step re-evaluates and stays dormant if still nothing is collidable.
+    // Awake, Evaluate() goes dormant after kDormantDelay seconds with nothing to track.
+    // Idle time only starts counting kWakeGrace seconds after the last Wake, so a draw
+    // (woken at BeginDraw, drawn only once the animation ends) isn't parked mid-draw.
+    // Time spent in each state is logged on every transition.
+    // ============================================
+
+    class TrackingDormancy
+    {
+    public:
+        static TrackingDormancy* GetSingleton();
+
+        bool IsDormant() const { return m_dormant.load(std::memory_order_relaxed); }
+
+        // Something collidable may have appeared - track again from the next step
+        void Wake(const char* reason);
+
+        // Awake steps only (game thread) - go dormant once nothing is collidable
+        void Evaluate(float deltaTime);
+
+        // Seconds spent in each state since the last call (for the scheduler stats)
+        void TakeStateTimes(float& activeSeconds, float& dormantSeconds);
+
+    private:
+        TrackingDormancy();
+        ~TrackingDormancy() = default;
+        TrackingDormancy(const TrackingDormancy&) = delete;
+        TrackingDormancy& operator=(const TrackingDormancy&) = delete;
+
+        static constexpr float kDormantDelay = 0.5f;
+        static constexpr float kWakeGrace = 1.0f;
+
+        // Anything the trackers would do work for this step
+        static bool HasCollidableState();
+
+        // Close the current state's time span (game thread)
+        void AccountStateTime();
+
+        std::atomic<bool> m_dormant;
+        std::atomic<const char*> m_wakeReason;   // Set by Wake, logged by the next Evaluate
+        std::atomic<UInt32> m_wakeSequence;      // Bumped by every Wake
+        bool m_accountedDormant = false;         // Game thread view of the state, for the time profile
+        float m_idleTime = 0.0f;                 // Awake with nothing collidable
+        UInt32 m_seenWakeSequence = 0;           // Last wake sequence Evaluate saw
+        float m_wakeGraceLeft = 0.0f;            // Idle time isn't counted until this runs out
+
+        // Time profile
+        std::chrono::steady_clock::time_point m_stateStart;
+        double m_activeSeconds = 0.0;
+        double m_dormantSeconds = 0.0;
+        double m_windowActiveSeconds = 0.0;
+        double m_windowDormantSeconds = 0.0;
+        int m_wakeCount = 0;
+    };
+}
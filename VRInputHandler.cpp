@@ -2,7 +2,16 @@
 #include "Engine.h"
 #include "WeaponGeometry.h"
 #include "ShieldCollision.h"
+#include "CollisionWorld.h"
 #include "DaggerFlipTracker.h"
+#include "WeaponRefPool.h"
+#include "EquipCommandBuffer.h"
+#include "RefHandleTable.h"
+#include "RateScheduler.h"
+#include "TrackingDormancy.h"
+#include "HostileIndex.h"
+#include "BodyZones.h"
+#include "MeshNarrowphase.h"
 #include "ActivateHook.h"
 #include "skse64/GameReferences.h"
 
@@ -99,47 +108,6 @@ namespace FalseEdgeVR
     // Grip button mask (k_EButton_Grip = 2)
     static const uint64_t GRIP_BUTTON_MASK = (1ull << 2);
 
-    // ============================================
-    // Shoulder Zone Detection
-    // Detects when controller with grabbed weapon is near shoulder
-    // Used for holstering/sheathing detection
-    // ============================================
-
-    // Shoulder zone tracking state
-    static bool s_leftControllerNearLeftShoulder = false;
-    static bool s_leftControllerNearRightShoulder = false;
-    static bool s_rightControllerNearLeftShoulder = false;
-    static bool s_rightControllerNearRightShoulder = false;
-
-    // Previous frame state for edge detection
-    static bool s_prevLeftNearLeftShoulder = false;
-    static bool s_prevLeftNearRightShoulder = false;
-    static bool s_prevRightNearLeftShoulder = false;
-    static bool s_prevRightNearRightShoulder = false;
-
-    // Shoulder zone configuration (in Skyrim units, ~70 units = 1 meter)
-    static constexpr float SHOULDER_ZONE_RADIUS = 25.0f;  // Detection radius around shoulder
-    static constexpr float SHOULDER_OFFSET_X = 17.5f;     // Left/right offset from head (matches HIGGS RightShoulderHmdOffsetX)
-    static constexpr float SHOULDER_OFFSET_Y = -5.0f;     // Forward/back offset from head (matches HIGGS RightShoulderHmdOffsetY)
-    static constexpr float SHOULDER_OFFSET_Z = -6.85f;    // Up/down offset from head (matches HIGGS RightShoulderHmdOffsetZ)
-
-    // Node names for VR tracking
-    static const char* kHMDNodeName = "NPC Head [Head]";
-    static const char* kLeftHandNodeName = "NPC L Hand [LHnd]";
-    static const char* kRightHandNodeName = "NPC R Hand [RHnd]";
-
-    // Helper function to check if a VR controller is in ANY shoulder zone
-    bool IsControllerInShoulderZone(bool isLeftVRController)
-    {
-        if (isLeftVRController)
-        {
-            return s_leftControllerNearLeftShoulder || s_leftControllerNearRightShoulder;
-        }
-        else
-        {
-            return s_rightControllerNearLeftShoulder || s_rightControllerNearRightShoulder;
-        }
-    }
     // ============================================
     // VRInputHandler Implementation
     // ============================================
@@ -290,11 +258,34 @@ namespace FalseEdgeVR
 loggedOnce = true;
         }
     
+  // Collect this frame's internal equips/unequips - applied together at the end of the step
+        EquipCommandBuffer::GetSingleton()->BeginFrame();
+        
+        // Validate tracked references once - stale ones fail every Resolve this frame
+        RefHandleTable::GetSingleton()->BeginFrame();
+        
+        // Fresh triangle pair budget for the mesh narrowphase
+        MeshNarrowphase::GetSingleton()->BeginFrame();
+        
+        // Decide which rate groups run this step
+        RateScheduler* scheduler = RateScheduler::GetSingleton();
+        scheduler->BeginFrame(deltaTime);
+        
   // Poll trigger button state each frame
         PollTriggerState();
    
         // Check for pending auto-unequip (trigger-based weapon hold system)
         EquipManager::GetSingleton()->CheckPendingAutoUnequip();
+        
+        // Catch equipment changes that never fired an equip event
+        scheduler->Run(RateGroup::EquipConsistency, [](float dt) {
+            EquipManager::GetSingleton()->CheckEquipConsistency(dt);
+        });
+        
+        // Park returned avoidance weapon refs / expire stale ones
+        scheduler->Run(RateGroup::RefPool, [](float dt) {
+            WeaponRefPool::GetSingleton()->Update(dt);
+        });
     
      // Log every 500 frames to confirm still running
         if (frameCount % 500 == 0)
@@ -331,26 +322,56 @@ handler->m_leftHandOnCooldown = false;
   
         // handler->CheckCollisionTimeout(deltaTime);      // DISABLED - trigger system handles this
      // handler->CheckPendingReequip(deltaTime);        // DISABLED - trigger system handles this
-   // handler->UpdateCombatTracking();              // DISABLED - not needed for trigger system
+   // Combat target + nearby hostile distance for close combat mode - off by default, not needed for trigger system
+        if (closeCombatEnabled)
+        {
+            scheduler->Run(RateGroup::CombatScan, [handler](float dt) {
+                handler->UpdateCombatTracking(dt);
+            });
+        }
+        else
+        {
+            scheduler->ResetAccumulated(RateGroup::CombatScan);
+        }
         
   // DISABLED: Shield collision timeout also now handled by trigger system
  // handler->CheckShieldCollisionTimeout(deltaTime); // DISABLED - trigger system handles this
    
         // RE-ENABLED: Auto-equip grabbed weapons (needed for world object grab -> equip -> trigger system)
-      handler->CheckAutoEquipGrabbedWeapon(deltaTime);
+      scheduler->Run(RateGroup::AutoEquip, [handler](float dt) {
+            handler->CheckAutoEquipGrabbedWeapon(dt);
+        });
         
         // Update shield bash tracking (still needed for shield bash detection)
-    handler->UpdateShieldBashTracking(deltaTime);
+    scheduler->Run(RateGroup::ShieldBash, [handler](float dt) {
+            handler->UpdateShieldBashTracking(dt);
+        });
 
   
         // Update grabbed weapon scales (keeps weapons scaled while held by HIGGS)
         // REMOVED: Weapon scaling logic removed
         // UpdateGrabbedWeaponScales();
       
-  // ALWAYS update weapon geometry and shield collision tracking
-    // These trackers handle their own equipment checks internally
-      UpdateWeaponGeometry(deltaTime);
-  UpdateShieldCollision(deltaTime);
+  // One collision world step: hands, blade and shield geometry, then every collider pair
+      // Dormant (nothing collidable) - a single test until an equip/draw/grab/menu-close wakes the trackers
+      TrackingDormancy* dormancy = TrackingDormancy::GetSingleton();
+      if (!dormancy->IsDormant())
+      {
+        scheduler->Run(RateGroup::Collision, [dormancy](float dt) {
+            UpdateCollisionWorld(dt);
+            dormancy->Evaluate(dt);
+        });
+      }
+      else
+      {
+        // The first step after a wake gets one frame of delta, not the whole dormant span
+        scheduler->ResetAccumulated(RateGroup::Collision);
+      }
+  
+        // Safe point: every tracker has run - apply the coalesced equip commands once
+        EquipCommandBuffer::GetSingleton()->Flush(deltaTime);
+        
+        scheduler->EndFrame(deltaTime);
     }
     
 
@@ -367,8 +388,8 @@ handler->m_leftHandOnCooldown = false;
             m_autoEquipPendingRight = false;
           m_autoEquipTimerLeft = 0.0f;
      m_autoEquipTimerRight = 0.0f;
-      m_autoEquipWeaponLeft = nullptr;
-            m_autoEquipWeaponRight = nullptr;
+      RefHandleTable::GetSingleton()->Release(m_autoEquipWeaponHandleLeft);
+            RefHandleTable::GetSingleton()->Release(m_autoEquipWeaponHandleRight);
             m_autoEquipFormIDLeft = 0;
      m_autoEquipFormIDRight = 0;
             
@@ -381,13 +402,19 @@ handler->m_leftHandOnCooldown = false;
         else
         {
             _MESSAGE("VRInputHandler: === TRACKING RESUMED === (menu closed)");
+            TrackingDormancy::GetSingleton()->Wake("menu close");
             // Force equipment state refresh when menu closes
             EquipManager::GetSingleton()->UpdateEquipmentState();
             UpdateGrabListening();
  }
     }
 
-    void VRInputHandler::UpdateCombatTracking()
+    TESObjectREFR* VRInputHandler::GetAutoEquipWeapon(bool isLeftVRController) const
+    {
+        return RefHandleTable::GetSingleton()->Resolve(isLeftVRController ? m_autoEquipWeaponHandleLeft : m_autoEquipWeaponHandleRight);
+    }
+
+    void VRInputHandler::UpdateCombatTracking(float deltaTime)
     {
         PlayerCharacter* player = *g_thePlayer;
         if (!player)
@@ -414,6 +441,9 @@ handler->m_leftHandOnCooldown = false;
             _MESSAGE("VRInputHandler: === PLAYER LEFT COMBAT ===");
     m_closestTargetDistance = 9999.0f;
           m_closestTargetHandle = 0;
+          RefHandleTable::GetSingleton()->Release(m_combatTargetRef);
+          m_combatTargetGameHandle = 0;
+          HostileIndex::GetSingleton()->Clear();
        
   // Exit close combat mode when leaving combat
   if (m_closeCombatMode)
@@ -435,10 +465,22 @@ handler->m_leftHandOnCooldown = false;
        UInt32 combatTargetHandle = player->currentCombatTarget;
          if (combatTargetHandle != 0 && combatTargetHandle != *g_invalidRefHandle)
             {
-          NiPointer<TESObjectREFR> targetRefr;
-  if (LookupREFRByHandle(combatTargetHandle, targetRefr) && targetRefr)
+          // Game handle lookup only when the target changes - RefHandleTable keeps it valid in between
+          RefHandleTable* refTable = RefHandleTable::GetSingleton();
+          if (combatTargetHandle != m_combatTargetGameHandle)
+          {
+              refTable->Release(m_combatTargetRef);
+              m_combatTargetGameHandle = combatTargetHandle;
+
+              NiPointer<TESObjectREFR> lookedUp;
+              if (LookupREFRByHandle(combatTargetHandle, lookedUp) && lookedUp)
+                  m_combatTargetRef = refTable->Acquire(lookedUp.get());
+          }
+
+          TESObjectREFR* targetRefr = refTable->Resolve(m_combatTargetRef);
+  if (targetRefr)
     {
-  Actor* targetActor = DYNAMIC_CAST(targetRefr.get(), TESObjectREFR, Actor);
+  Actor* targetActor = DYNAMIC_CAST(targetRefr, TESObjectREFR, Actor);
          if (targetActor && !targetActor->IsDead(1))
        {
     NiPoint3 targetPos = targetActor->pos;
@@ -461,6 +503,14 @@ handler->m_leftHandOnCooldown = false;
     combatTargetHandle, *g_invalidRefHandle);
     }
             }
+            
+            // Flanking enemies count too - nearest hostile from the time-sliced index
+            HostileIndex* hostileIndex = HostileIndex::GetSingleton();
+            hostileIndex->Update(player);
+            if (hostileIndex->GetNearestDistance() < m_closestTargetDistance)
+            {
+                m_closestTargetDistance = hostileIndex->GetNearestDistance();
+            }
     
    // ============================================
      // Close Combat Mode Logic
@@ -496,17 +546,17 @@ handler->m_leftHandOnCooldown = false;
             }
        
        // Log combat status periodically (every 2 seconds)
-   m_combatLogTimer += 0.011f; // Approximate frame time at 90fps
+   m_combatLogTimer += deltaTime;
   if (m_combatLogTimer >= 2.0f)
             {
          m_combatLogTimer = 0.0f;
     
            if (m_closestTargetHandle != 0)
              {
-   NiPointer<TESObjectREFR> targetRefr;
- if (LookupREFRByHandle(m_closestTargetHandle, targetRefr) && targetRefr)
+   TESObjectREFR* targetRefr = RefHandleTable::GetSingleton()->Resolve(m_combatTargetRef);
+ if (targetRefr)
         {
-       const char* targetName = CALL_MEMBER_FN(targetRefr.get(), GetReferenceName)();
+       const char* targetName = CALL_MEMBER_FN(targetRefr, GetReferenceName)();
           _MESSAGE("VRInputHandler: COMBAT STATUS - Target: %s, Distance: %.1f units (%.1f m), CloseCombat: %s", 
  targetName ? targetName : "Unknown",
            m_closestTargetDistance,
@@ -542,10 +592,10 @@ handler->m_leftHandOnCooldown = false;
     return;
 
         // Check left VR controller for grabbed weapon
-        if (m_autoEquipWeaponLeft && higgsInterface)
+        if (GetAutoEquipWeapon(true) && higgsInterface)
         {
        TESObjectREFR* grabbed = higgsInterface->GetGrabbedObject(true);
-            if (grabbed == m_autoEquipWeaponLeft && grabbed->baseForm)
+            if (grabbed == GetAutoEquipWeapon(true) && grabbed->baseForm)
             {
                 _MESSAGE("VRInputHandler: Close combat - force equipping LEFT grabbed weapon");
        
@@ -556,60 +606,22 @@ handler->m_leftHandOnCooldown = false;
      if (activated)
     {
          bool isLeftGameHand = VRControllerToGameHand(true);
-           ::EquipManager* equipMan = ::EquipManager::GetSingleton();
-       if (equipMan)
-            {
-       BGSEquipSlot* slot = isLeftGameHand ? GetLeftHandSlot() : GetRightHandSlot();
-    // Suppress draw sound during collision re-equip
-         EquipManager::s_suppressDrawSound = true;
-         // Temporarily strip enchantment to prevent enchant VFX/sound
-         TESObjectWEAP* weap = DYNAMIC_CAST(grabbed->baseForm, TESForm, TESObjectWEAP);
-         EnchantmentItem* cachedEnchant = nullptr;
-         if (weap && weap->enchantable.enchantment)
-         {
-             cachedEnchant = weap->enchantable.enchantment;
-             weap->enchantable.enchantment = nullptr;
-         }
-
-         // Temporarily strip enchantment to prevent enchant VFX/sound
-         TESObjectWEAP* weap2 = DYNAMIC_CAST(grabbed->baseForm, TESForm, TESObjectWEAP);
-         EnchantmentItem* cachedEnchant2 = nullptr;
-         if (weap2 && weap2->enchantable.enchantment)
-         {
-             cachedEnchant2 = weap2->enchantable.enchantment;
-             weap2->enchantable.enchantment = nullptr;
-         }
-            
-            CALL_MEMBER_FN(equipMan, EquipItem)(player, grabbed->baseForm, nullptr, 1, slot, false, true, false, nullptr);
-            
-            // Restore enchantment immediately
-            if (weap2 && cachedEnchant2)
-            {
-                weap2->enchantable.enchantment = cachedEnchant2;
-            }
-
-         // Restore enchantment immediately
-         if (weap && cachedEnchant)
-         {
-             weap->enchantable.enchantment = cachedEnchant;
-         }
-
-       EquipManager::s_suppressDrawSound = false;
-       _MESSAGE("VRInputHandler: Force equipped weapon to %s game hand", isLeftGameHand ? "LEFT" : "RIGHT");
-          }
+       // Silent equip - applied with the rest of this frame's equips by EquipCommandBuffer
+       EquipCommandBuffer::GetSingleton()->QueueEquip(grabbed->baseForm, isLeftGameHand, true);
+       _MESSAGE("VRInputHandler: Queued force equip of weapon to %s game hand", isLeftGameHand ? "LEFT" : "RIGHT");
  }
         
               m_autoEquipPendingLeft = false;
   m_autoEquipTimerLeft = 0.0f;
-          m_autoEquipWeaponLeft = nullptr;
+          RefHandleTable::GetSingleton()->Release(m_autoEquipWeaponHandleLeft);
          }
  }
         
         // Check right VR controller for grabbed weapon
-        if (m_autoEquipWeaponRight && higgsInterface)
+        if (GetAutoEquipWeapon(false) && higgsInterface)
         {
             TESObjectREFR* grabbed = higgsInterface->GetGrabbedObject(false);
-            if (grabbed == m_autoEquipWeaponRight && grabbed->baseForm)
+            if (grabbed == GetAutoEquipWeapon(false) && grabbed->baseForm)
        {
                 _MESSAGE("VRInputHandler: Close combat - force equipping RIGHT grabbed weapon");
           
@@ -620,36 +632,14 @@ handler->m_leftHandOnCooldown = false;
         if (activated)
    {
  bool isLeftGameHand = VRControllerToGameHand(false);
-            ::EquipManager* equipMan = ::EquipManager::GetSingleton();
-    if (equipMan)
-  {
-      BGSEquipSlot* slot = isLeftGameHand ? GetLeftHandSlot() : GetRightHandSlot();
-      // Suppress draw sound during auto-equip
-   EquipManager::s_suppressDrawSound = true;
-   // Temporarily strip enchantment to prevent enchant VFX/sound
-   TESObjectWEAP* weap = DYNAMIC_CAST(grabbed->baseForm, TESForm, TESObjectWEAP);
-   EnchantmentItem* cachedEnchant = nullptr;
-   if (weap && weap->enchantable.enchantment)
-   {
-       cachedEnchant = weap->enchantable.enchantment;
-       weap->enchantable.enchantment = nullptr;
-   }
-
-   CALL_MEMBER_FN(equipMan, EquipItem)(player, grabbed->baseForm, nullptr, 1, slot, false, true, false, nullptr);
-
-   // Restore enchantment immediately
-   if (weap && cachedEnchant)
-   {
-       weap->enchantable.enchantment = cachedEnchant;
-   }
-       EquipManager::s_suppressDrawSound = false;
-                 _MESSAGE("VRInputHandler: Force equipped weapon to %s game hand", isLeftGameHand ? "LEFT" : "RIGHT");
-          }
+      // Silent equip - applied with the rest of this frame's equips by EquipCommandBuffer
+      EquipCommandBuffer::GetSingleton()->QueueEquip(grabbed->baseForm, isLeftGameHand, true);
+                 _MESSAGE("VRInputHandler: Queued force equip of weapon to %s game hand", isLeftGameHand ? "LEFT" : "RIGHT");
 }
          
          m_autoEquipPendingRight = false;
        m_autoEquipTimerRight = 0.0f;
-        m_autoEquipWeaponRight = nullptr;
+        RefHandleTable::GetSingleton()->Release(m_autoEquipWeaponHandleRight);
       }
  }
         
@@ -825,6 +815,8 @@ if (shieldDropped && higgsInterface)
     {
         VRInputHandler* handler = GetSingleton();
 
+        TrackingDormancy::GetSingleton()->Wake("HIGGS grab");
+
         // Check for dagger flip (throw and catch)
         DaggerFlipTracker::GetSingleton()->OnGrabbed(isLeftVRController, grabbedRefr);
         // Skip if tracking is paused (menu open)
@@ -954,14 +946,14 @@ vrControllerName, gameHandName);
      {
   handler->m_autoEquipPendingLeft = true;
 handler->m_autoEquipTimerLeft = 0.0f;
-   handler->m_autoEquipWeaponLeft = nullptr;  // Ref was activated, use FormID
+   RefHandleTable::GetSingleton()->Release(handler->m_autoEquipWeaponHandleLeft);  // Ref was activated, use FormID
         handler->m_autoEquipFormIDLeft = weaponFormID;
   }
         else
            {
      handler->m_autoEquipPendingRight = true;
    handler->m_autoEquipTimerRight = 0.0f;
-   handler->m_autoEquipWeaponRight = nullptr;  // Ref was activated, use FormID
+   RefHandleTable::GetSingleton()->Release(handler->m_autoEquipWeaponHandleRight);  // Ref was activated, use FormID
        handler->m_autoEquipFormIDRight = weaponFormID;
         }
    }
@@ -1059,14 +1051,14 @@ handler->m_autoEquipTimerLeft = 0.0f;
    {
  handler->m_autoEquipPendingLeft = false;
  handler->m_autoEquipTimerLeft = 0.0f;
-        handler->m_autoEquipWeaponLeft = nullptr;
+        RefHandleTable::GetSingleton()->Release(handler->m_autoEquipWeaponHandleLeft);
         handler->m_autoEquipFormIDLeft = 0;
       }
      else
   {
   handler->m_autoEquipPendingRight = false;
     handler->m_autoEquipTimerRight = 0.0f;
- handler->m_autoEquipWeaponRight = nullptr;
+ RefHandleTable::GetSingleton()->Release(handler->m_autoEquipWeaponHandleRight);
  handler->m_autoEquipFormIDRight = 0;
         }
             
@@ -1076,6 +1068,18 @@ handler->m_autoEquipTimerLeft = 0.0f;
     // Clear weapon lock state
        ClearWeaponLock(isLeftVRController);
       
+    // Pooled proxy dropped on purpose - the world ref becomes the real item, so take the kept copy out of inventory
+  if (EquipManager::GetSingleton()->IsDroppedWeaponPooled(isLeftGameHand) &&
+      EquipManager::GetSingleton()->GetDroppedWeaponRef(isLeftGameHand) == droppedRefr && droppedRefr->baseForm)
+  {
+      PlayerCharacter* player = *g_thePlayer;
+      if (player)
+      {
+          RemoveItemFromInventory(player, droppedRefr->baseForm, 1, true);
+          _MESSAGE("VRInputHandler:   Removed kept inventory copy of pooled weapon %08X", droppedRefr->baseForm->formID);
+      }
+  }
+      
     // Clear EquipManager dropped weapon tracking
   EquipManager::GetSingleton()->ClearDroppedWeaponRef(isLeftGameHand);
        EquipManager::GetSingleton()->ClearPendingReequip(isLeftGameHand);
@@ -1092,7 +1096,7 @@ handler->m_autoEquipTimerLeft = 0.0f;
         bool isCollisionAvoidanceWeapon = false;
         
         // Check if this was a weapon we were waiting to auto-equip
-        if (isLeftVRController && handler->m_autoEquipWeaponLeft == droppedRefr)
+        if (isLeftVRController && handler->GetAutoEquipWeapon(true) == droppedRefr)
         {
 isAutoEquipWeapon = true;
             _MESSAGE("VRInputHandler: === ACCIDENTAL DROP DETECTED (LEFT) ===");
@@ -1101,9 +1105,9 @@ isAutoEquipWeapon = true;
             
    handler->m_autoEquipPendingLeft = false;
             handler->m_autoEquipTimerLeft = 0.0f;
-    handler->m_autoEquipWeaponLeft = nullptr;
+    RefHandleTable::GetSingleton()->Release(handler->m_autoEquipWeaponHandleLeft);
         }
-        else if (!isLeftVRController && handler->m_autoEquipWeaponRight == droppedRefr)
+        else if (!isLeftVRController && handler->GetAutoEquipWeapon(false) == droppedRefr)
         {
             isAutoEquipWeapon = true;
    _MESSAGE("VRInputHandler: === ACCIDENTAL DROP DETECTED (RIGHT) ===");
@@ -1112,7 +1116,7 @@ isAutoEquipWeapon = true;
      
  handler->m_autoEquipPendingRight = false;
             handler->m_autoEquipTimerRight = 0.0f;
- handler->m_autoEquipWeaponRight = nullptr;
+ RefHandleTable::GetSingleton()->Release(handler->m_autoEquipWeaponHandleRight);
         }
 
         // Check if this is the weapon we were tracking for collision avoidance
@@ -1393,17 +1397,17 @@ VRInputHandler* handler = GetSingleton();
     leftTrig ? "YES" : "NO", rightTrig ? "YES" : "NO");
        
     // Check if this was a dual-wield same weapon situation
- bool wasDualWieldingSame = EquipManager::GetSingleton()->WasDualWieldingSameWeapon(offHandIsLeft);
+ bool wasDualWieldingSame = EquipManager::GetSingleton()->IsDroppedWeaponProxy(offHandIsLeft);
 
       if (wasDualWieldingSame)
    {
-          // For dual-wield same weapon: DON'T activate (which would add duplicate to inventory)
+          // For proxy refs (dual-wield same weapon, or pooled ref): DON'T activate (which would add duplicate to inventory)
        // The re-equip will use the existing inventory item via cached FormID
-           _MESSAGE("VRInputHandler: Dual-wield same weapon - SKIPPING activation (will re-equip from existing inventory)");
-        _MESSAGE("VRInputHandler: Deleting spawned weapon (RefID: %08X) from world", triggerDroppedWeapon->formID);
+           _MESSAGE("VRInputHandler: Proxy weapon ref (same weapon / pooled) - SKIPPING activation (will re-equip from existing inventory)");
+        _MESSAGE("VRInputHandler: Returning spawned weapon (RefID: %08X) to pool / deleting from world", triggerDroppedWeapon->formID);
          
-     // Delete the spawned world object so it doesn't accumulate on the ground
- DeleteWorldObject(triggerDroppedWeapon);
+     // Pool parks it for reuse, or deletes it so it doesn't accumulate on the ground
+ WeaponRefPool::GetSingleton()->Release(triggerDroppedWeapon);
       }
       else
         {
@@ -1535,17 +1539,17 @@ m_timeSinceLastCollision, bladeCollisionTimeout);
         if (droppedWeapon && droppedWeapon->baseForm)
         {
             // Check if this was a dual-wield same weapon situation
-            bool wasDualWieldingSame = EquipManager::GetSingleton()->WasDualWieldingSameWeapon(offHandIsLeft);
+            bool wasDualWieldingSame = EquipManager::GetSingleton()->IsDroppedWeaponProxy(offHandIsLeft);
 
             if (wasDualWieldingSame)
             {
-      // For dual-wield same weapon: DON'T activate (which would add duplicate to inventory)
+      // For proxy refs (dual-wield same weapon, or pooled ref): DON'T activate (which would add duplicate to inventory)
        // The re-equip will use the existing inventory item via cached FormID
-   _MESSAGE("VRInputHandler: Dual-wield same weapon - SKIPPING activation (will re-equip from existing inventory)");
-      _MESSAGE("VRInputHandler: Deleting spawned weapon (RefID: %08X) from world", droppedWeapon->formID);
+   _MESSAGE("VRInputHandler: Proxy weapon ref (same weapon / pooled) - SKIPPING activation (will re-equip from existing inventory)");
+      _MESSAGE("VRInputHandler: Returning spawned weapon (RefID: %08X) to pool / deleting from world", droppedWeapon->formID);
            
-         // Delete the spawned world object so it doesn't accumulate on the ground
- DeleteWorldObject(droppedWeapon);
+         // Pool parks it for reuse, or deletes it so it doesn't accumulate on the ground
+ WeaponRefPool::GetSingleton()->Release(droppedWeapon);
             }
           else
             {
@@ -1681,22 +1685,16 @@ m_leftHandCooldownTimer = 0.0f;
             
     if (player && weaponForm)
     {
-   ::EquipManager* equipMan = ::EquipManager::GetSingleton();
-      if (equipMan)
-    {
-            BGSEquipSlot* slot = isLeftGameHand ? GetLeftHandSlot() : GetRightHandSlot();
-   EquipManager::s_suppressDrawSound = true;
-       CALL_MEMBER_FN(equipMan, EquipItem)(player, weaponForm, nullptr, 1, slot, false, true, false, nullptr);
-  EquipManager::s_suppressDrawSound = false;
-      _MESSAGE("VRInputHandler: Equipped grabbed weapon to %s game hand", 
+            // Silent equip - applied with the rest of this frame's equips by EquipCommandBuffer
+            EquipCommandBuffer::GetSingleton()->QueueEquip(weaponForm, isLeftGameHand, false);
+      _MESSAGE("VRInputHandler: Queued equip of grabbed weapon to %s game hand", 
               isLeftGameHand ? "LEFT" : "RIGHT");
-     }
     }
      
       m_autoEquipPendingLeft = false;
    m_autoEquipTimerLeft = 0.0f;
               m_autoEquipFormIDLeft = 0;
-       m_autoEquipWeaponLeft = nullptr;
+       RefHandleTable::GetSingleton()->Release(m_autoEquipWeaponHandleLeft);
           }
       return;  // Don't process old logic if we handled FormID equip
         }
@@ -1717,22 +1715,16 @@ m_leftHandCooldownTimer = 0.0f;
  
       if (player && weaponForm)
               {
-        ::EquipManager* equipMan = ::EquipManager::GetSingleton();
-          if (equipMan)
-          {
-             BGSEquipSlot* slot = isLeftGameHand ? GetLeftHandSlot() : GetRightHandSlot();
-            EquipManager::s_suppressDrawSound = true;
-          CALL_MEMBER_FN(equipMan, EquipItem)(player, weaponForm, nullptr, 1, slot, false, true, false, nullptr);
-      EquipManager::s_suppressDrawSound = false;
-        _MESSAGE("VRInputHandler: Equipped grabbed weapon to %s game hand", 
+             // Silent equip - applied with the rest of this frame's equips by EquipCommandBuffer
+             EquipCommandBuffer::GetSingleton()->QueueEquip(weaponForm, isLeftGameHand, false);
+        _MESSAGE("VRInputHandler: Queued equip of grabbed weapon to %s game hand", 
       isLeftGameHand ? "LEFT" : "RIGHT");
-    }
  }
              
  m_autoEquipPendingRight = false;
      m_autoEquipTimerRight = 0.0f;
            m_autoEquipFormIDRight = 0;
-          m_autoEquipWeaponRight = nullptr;
+          RefHandleTable::GetSingleton()->Release(m_autoEquipWeaponHandleRight);
     }
    return;  // Don't process old logic if we handled FormID equip
         }
@@ -1748,14 +1740,14 @@ m_leftHandCooldownTimer = 0.0f;
       return;
          
         // Skip legacy logic if there's no weapon reference being tracked
-     if (!m_autoEquipWeaponLeft && !m_autoEquipWeaponRight)
+     if (!GetAutoEquipWeapon(true) && !GetAutoEquipWeapon(false))
           return;
           
         // First, check if the OTHER hand still has a weapon equipped
      // If player manually unequipped their main hand weapon, cancel auto-equip
      const PlayerEquipState& equipState = EquipManager::GetSingleton()->GetEquipState();
         
-if (m_autoEquipPendingLeft && m_autoEquipWeaponLeft)
+if (m_autoEquipPendingLeft && GetAutoEquipWeapon(true))
         {
       // Left VR controller is holding grabbed weapon - check if RIGHT game hand still has weapon
             bool isLeftGameHand = VRControllerToGameHand(true);
@@ -1767,14 +1759,14 @@ if (m_autoEquipPendingLeft && m_autoEquipWeaponLeft)
              _MESSAGE("VRInputHandler: Auto-equip cancelled for LEFT VR hand - other hand no longer has weapon equipped");
      m_autoEquipPendingLeft = false;
        m_autoEquipTimerLeft = 0.0f;
-           m_autoEquipWeaponLeft = nullptr;
+           RefHandleTable::GetSingleton()->Release(m_autoEquipWeaponHandleLeft);
    }
-            else if (!higgsInterface || higgsInterface->GetGrabbedObject(true) != m_autoEquipWeaponLeft)
+            else if (!higgsInterface || higgsInterface->GetGrabbedObject(true) != GetAutoEquipWeapon(true))
   {
        _MESSAGE("VRInputHandler: Auto-equip cancelled for LEFT VR hand - weapon no longer held");
   m_autoEquipPendingLeft = false;
      m_autoEquipTimerLeft = 0.0f;
-     m_autoEquipWeaponLeft = nullptr;
+     RefHandleTable::GetSingleton()->Release(m_autoEquipWeaponHandleLeft);
             }
   else
        {
@@ -1811,7 +1803,7 @@ if (m_autoEquipPendingLeft && m_autoEquipWeaponLeft)
      _MESSAGE("VRInputHandler: Auto-equiping grabbed weapon to LEFT game hand after %.1f sec",
                    autoEquipGrabbedWeaponDelay);
  
-             TESForm* weaponForm = m_autoEquipWeaponLeft->baseForm;
+             TESForm* weaponForm = GetAutoEquipWeapon(true)->baseForm;
      if (weaponForm)
       {
    bool isLeftGameHand = VRControllerToGameHand(true);
@@ -1821,36 +1813,15 @@ if (m_autoEquipPendingLeft && m_autoEquipWeaponLeft)
       {
 // Suppress pickup sound during internal re-equip
            EquipManager::s_suppressPickupSound = true;
- bool activated = SafeActivate(m_autoEquipWeaponLeft, player, 0, 0, 1, true);
+ bool activated = SafeActivate(GetAutoEquipWeapon(true), player, 0, 0, 1, true);
        EquipManager::s_suppressPickupSound = false;
    _MESSAGE("VRInputHandler: Activate grabbed weapon result: %s", activated ? "SUCCESS" : "FAILED");
  
       if (activated)
       {
-    ::EquipManager* equipMan = ::EquipManager::GetSingleton();
-  if (equipMan)
-   {
-    BGSEquipSlot* slot = isLeftGameHand ? GetLeftHandSlot() : GetRightHandSlot();
-    // Suppress draw sound during auto-equip
-      EquipManager::s_suppressDrawSound = true;
-      // Temporarily strip enchantment to prevent enchant VFX/sound
-      TESObjectWEAP* weapEnch = DYNAMIC_CAST(weaponForm, TESForm, TESObjectWEAP);
-      EnchantmentItem* cachedEnchantAuto = nullptr;
-      if (weapEnch && weapEnch->enchantable.enchantment)
-      {
-          cachedEnchantAuto = weapEnch->enchantable.enchantment;
-          weapEnch->enchantable.enchantment = nullptr;
-      }
-
-      CALL_MEMBER_FN(equipMan, EquipItem)(player, weaponForm, nullptr, 1, slot, false, true, false, nullptr);
-
-      // Restore enchantment immediately
-      if (weapEnch && cachedEnchantAuto)
-      {
-          weapEnch->enchantable.enchantment = cachedEnchantAuto;
-      }
- EquipManager::s_suppressDrawSound = false;
-   _MESSAGE("VRInputHandler: Equipped weapon to %s game hand (silent)",
+    // Silent equip - applied with the rest of this frame's equips by EquipCommandBuffer
+    EquipCommandBuffer::GetSingleton()->QueueEquip(weaponForm, isLeftGameHand, true);
+   _MESSAGE("VRInputHandler: Queued equip of weapon to %s game hand (silent)",
 isLeftGameHand ? "LEFT" : "RIGHT");
           
         // Start cooldown to prevent immediate collision detection re-triggering
@@ -1866,20 +1837,19 @@ isLeftGameHand ? "LEFT" : "RIGHT");
          m_rightHandCooldownTimer = 0.0f;
              _MESSAGE("VRInputHandler: Started %.0fms cooldown for right hand (auto-equip)", bladeReequipCooldown * 1000.0f);
      }
-    }
     }
         }
    }
         
         m_autoEquipPendingLeft = false;
   m_autoEquipTimerLeft = 0.0f;
-         m_autoEquipWeaponLeft = nullptr;
+         RefHandleTable::GetSingleton()->Release(m_autoEquipWeaponHandleLeft);
          }
     }
   }
         }
         
-      if (m_autoEquipPendingRight && m_autoEquipWeaponRight)
+      if (m_autoEquipPendingRight && GetAutoEquipWeapon(false))
         {
       // Right VR controller is holding grabbed weapon - check if LEFT game hand still has weapon
        bool isLeftGameHand = VRControllerToGameHand(false);
@@ -1891,14 +1861,14 @@ isLeftGameHand ? "LEFT" : "RIGHT");
        _MESSAGE("VRInputHandler: Auto-equipCancelled for RIGHT VR hand - other hand no longer has weapon equipped");
       m_autoEquipPendingRight = false;
       m_autoEquipTimerRight = 0.0f;
-           m_autoEquipWeaponRight = nullptr;
+           RefHandleTable::GetSingleton()->Release(m_autoEquipWeaponHandleRight);
  }
-     else if (!higgsInterface || higgsInterface->GetGrabbedObject(false) != m_autoEquipWeaponRight)
+     else if (!higgsInterface || higgsInterface->GetGrabbedObject(false) != GetAutoEquipWeapon(false))
        {
    _MESSAGE("VRInputHandler: Auto-equipCancelled for RIGHT VR hand - weapon no longer held");
     m_autoEquipPendingRight = false;
       m_autoEquipTimerRight = 0.0f;
-    m_autoEquipWeaponRight = nullptr;
+    RefHandleTable::GetSingleton()->Release(m_autoEquipWeaponHandleRight);
      }
       else
        {
@@ -1934,7 +1904,7 @@ isLeftGameHand ? "LEFT" : "RIGHT");
     _MESSAGE("VRInputHandler: Auto-equiping grabbed weapon to RIGHT game hand after %.1f sec",
     autoEquipGrabbedWeaponDelay);
   
-          TESForm* weaponForm = m_autoEquipWeaponRight->baseForm;
+          TESForm* weaponForm = GetAutoEquipWeapon(false)->baseForm;
         if (weaponForm)
        {
          bool isLeftGameHand = VRControllerToGameHand(false);
@@ -1944,36 +1914,15 @@ isLeftGameHand ? "LEFT" : "RIGHT");
   {
       // Suppress pickup sound during internal re-equip
          EquipManager::s_suppressPickupSound = true;
-      bool activated = SafeActivate(m_autoEquipWeaponRight, player, 0, 0, 1, true);
+      bool activated = SafeActivate(GetAutoEquipWeapon(false), player, 0, 0, 1, true);
          EquipManager::s_suppressPickupSound = false;
  _MESSAGE("VRInputHandler: Activate grabbed weapon result: %s", activated ? "SUCCESS" : "FAILED");
      
   if (activated)
    {
-  ::EquipManager* equipMan = ::EquipManager::GetSingleton();
-      if (equipMan)
-        {
-   BGSEquipSlot* slot = isLeftGameHand ? GetLeftHandSlot() : GetRightHandSlot();
-   // Suppress draw sound during auto-equip
-   EquipManager::s_suppressDrawSound = true;
-   // Temporarily strip enchantment to prevent enchant VFX/sound
-   TESObjectWEAP* weapEnch2 = DYNAMIC_CAST(weaponForm, TESForm, TESObjectWEAP);
-   EnchantmentItem* cachedEnchantAuto2 = nullptr;
-   if (weapEnch2 && weapEnch2->enchantable.enchantment)
-   {
-       cachedEnchantAuto2 = weapEnch2->enchantable.enchantment;
-       weapEnch2->enchantable.enchantment = nullptr;
-   }
-
-   CALL_MEMBER_FN(equipMan, EquipItem)(player, weaponForm, nullptr, 1, slot, false, true, false, nullptr);
-
-   // Restore enchantment immediately
-   if (weapEnch2 && cachedEnchantAuto2)
-   {
-       weapEnch2->enchantable.enchantment = cachedEnchantAuto2;
-   }
-  EquipManager::s_suppressDrawSound = false;
-           _MESSAGE("VRInputHandler: Equipped grabbed weapon to %s game hand (silent)",
+   // Silent equip - applied with the rest of this frame's equips by EquipCommandBuffer
+   EquipCommandBuffer::GetSingleton()->QueueEquip(weaponForm, isLeftGameHand, true);
+           _MESSAGE("VRInputHandler: Queued equip of grabbed weapon to %s game hand (silent)",
    isLeftGameHand ? "LEFT" : "RIGHT");
      
        // Start cooldown to prevent immediate collision detection re-triggering
@@ -1989,14 +1938,13 @@ isLeftGameHand ? "LEFT" : "RIGHT");
     m_rightHandCooldownTimer = 0.0f;
    _MESSAGE("VRInputHandler: Started %.0fms cooldown for right hand (auto-equip)", bladeReequipCooldown * 1000.0f);
       }
-   }
    }
       }
       }
       
       m_autoEquipPendingRight = false;
    m_autoEquipTimerRight = 0.0f;
-     m_autoEquipWeaponRight = nullptr;
+     RefHandleTable::GetSingleton()->Release(m_autoEquipWeaponHandleRight);
          }
              }
    }
@@ -2212,17 +2160,17 @@ m_timeSinceLastShieldCollision += deltaTime;
       if (droppedWeapon && droppedWeapon->baseForm)
         {
         // Check if this was a dual-wield same weapon situation
-    bool wasDualWieldingSame = EquipManager::GetSingleton()->WasDualWieldingSameWeapon(weaponHandIsLeft);
+    bool wasDualWieldingSame = EquipManager::GetSingleton()->IsDroppedWeaponProxy(weaponHandIsLeft);
      
             if (wasDualWieldingSame)
             {
-      // For dual-wield same weapon: DON'T activate (which would add duplicate to inventory)
+      // For proxy refs (dual-wield same weapon, or pooled ref): DON'T activate (which would add duplicate to inventory)
   // The re-equip will use the existing inventory item via cached FormID
-   _MESSAGE("VRInputHandler: Dual-wield same weapon - SKIPPING activation (will re-equip from existing inventory)");
-      _MESSAGE("VRInputHandler: Deleting spawned weapon (RefID: %08X) from world", droppedWeapon->formID);
+   _MESSAGE("VRInputHandler: Proxy weapon ref (same weapon / pooled) - SKIPPING activation (will re-equip from existing inventory)");
+      _MESSAGE("VRInputHandler: Returning spawned weapon (RefID: %08X) to pool / deleting from world", droppedWeapon->formID);
            
-         // Delete the spawned world object so it doesn't accumulate on the ground
- DeleteWorldObject(droppedWeapon);
+         // Pool parks it for reuse, or deletes it so it doesn't accumulate on the ground
+ WeaponRefPool::GetSingleton()->Release(droppedWeapon);
             }
           else
             {
@@ -2364,13 +2312,21 @@ float VRInputHandler::GetCurrentWeaponShieldDistance() const
         m_autoEquipPendingRight = false;
      m_autoEquipTimerLeft = 0.0f;
         m_autoEquipTimerRight = 0.0f;
-   m_autoEquipWeaponLeft = nullptr;
-     m_autoEquipWeaponRight = nullptr;
+   RefHandleTable::GetSingleton()->Release(m_autoEquipWeaponHandleLeft);
+     RefHandleTable::GetSingleton()->Release(m_autoEquipWeaponHandleRight);
         
         // Clear weapon lock state
      ClearWeaponLock(true);   // Left VR controller
      ClearWeaponLock(false);  // Right VR controller
         
+        // Pooled weapon refs belong to the previous session
+        WeaponRefPool::GetSingleton()->Clear();
+        EquipCommandBuffer::GetSingleton()->Clear();
+        RefHandleTable::GetSingleton()->Clear();
+        RateScheduler::GetSingleton()->Clear();
+        BodyZoneSystem::GetSingleton()->Clear();
+        TrackingDormancy::GetSingleton()->Wake("game load");
+        
   // Clear drop protection override state
         s_leftDropProtectionDisabled = false;
         s_leftDropProtectionDisableTimer = 0.0f;
@@ -2385,6 +2341,9 @@ float VRInputHandler::GetCurrentWeaponShieldDistance() const
         m_isInCombat = false;
    m_closestTargetDistance = 9999.0f;
       m_closestTargetHandle = 0;
+      RefHandleTable::GetSingleton()->Release(m_combatTargetRef);
+      m_combatTargetGameHandle = 0;
+        HostileIndex::GetSingleton()->Clear();
         m_closeCombatMode = false;
   m_combatLogTimer = 0.0f;
    
@@ -2439,127 +2398,13 @@ return 0.0f;
 
     void CheckShoulderZones()
     {
-        PlayerCharacter* player = *g_thePlayer;
-        if (!player)
+        // Zone tests run at the [Scheduler] BodyZoneRate; the grip checks below need every poll to catch press edges
+        BodyZoneSystem* bodyZones = BodyZoneSystem::GetSingleton();
+        RateScheduler::GetSingleton()->Run(RateGroup::BodyZones, [bodyZones](float) {
+            bodyZones->Update();
+        });
+        if (!bodyZones->IsValid())
             return;
-
-        NiNode* rootNode = player->GetNiNode();
-        if (!rootNode)
-            rootNode = player->GetNiRootNode(1);
-        if (!rootNode)
-            return;
-
-        // Get HMD (head) node
-        BSFixedString hmdNodeStr(kHMDNodeName);
-        NiAVObject* hmdNode = rootNode->GetObjectByName(&hmdNodeStr.data);
-        if (!hmdNode)
-            return;
-
-        NiPoint3 hmdPos = hmdNode->m_worldTransform.pos;
-        NiMatrix33& hmdRot = hmdNode->m_worldTransform.rot;
-
-        // Calculate shoulder positions in world space using HMD rotation
-        // Left shoulder: negative X offset (left of head)
-        NiPoint3 leftShoulderLocal(-SHOULDER_OFFSET_X, SHOULDER_OFFSET_Y, SHOULDER_OFFSET_Z);
-        NiPoint3 leftShoulderWorld;
-        leftShoulderWorld.x = hmdPos.x + hmdRot.data[0][0] * leftShoulderLocal.x + hmdRot.data[0][1] * leftShoulderLocal.y + hmdRot.data[0][2] * leftShoulderLocal.z;
-        leftShoulderWorld.y = hmdPos.y + hmdRot.data[1][0] * leftShoulderLocal.x + hmdRot.data[1][1] * leftShoulderLocal.y + hmdRot.data[1][2] * leftShoulderLocal.z;
-        leftShoulderWorld.z = hmdPos.z + hmdRot.data[2][0] * leftShoulderLocal.x + hmdRot.data[2][1] * leftShoulderLocal.y + hmdRot.data[2][2] * leftShoulderLocal.z;
-
-        // Right shoulder: positive X offset (right of head)
-        NiPoint3 rightShoulderLocal(SHOULDER_OFFSET_X, SHOULDER_OFFSET_Y, SHOULDER_OFFSET_Z);
-        NiPoint3 rightShoulderWorld;
-        rightShoulderWorld.x = hmdPos.x + hmdRot.data[0][0] * rightShoulderLocal.x + hmdRot.data[0][1] * rightShoulderLocal.y + hmdRot.data[0][2] * rightShoulderLocal.z;
-        rightShoulderWorld.y = hmdPos.y + hmdRot.data[1][0] * rightShoulderLocal.x + hmdRot.data[1][1] * rightShoulderLocal.y + hmdRot.data[1][2] * rightShoulderLocal.z;
-        rightShoulderWorld.z = hmdPos.z + hmdRot.data[2][0] * rightShoulderLocal.x + hmdRot.data[2][1] * rightShoulderLocal.y + hmdRot.data[2][2] * rightShoulderLocal.z;
-
-        // Get hand nodes
-        BSFixedString leftHandStr(kLeftHandNodeName);
-        BSFixedString rightHandStr(kRightHandNodeName);
-        NiAVObject* leftHandNode = rootNode->GetObjectByName(&leftHandStr.data);
-        NiAVObject* rightHandNode = rootNode->GetObjectByName(&rightHandStr.data);
-
-        // Store previous state
-        s_prevLeftNearLeftShoulder = s_leftControllerNearLeftShoulder;
-        s_prevLeftNearRightShoulder = s_leftControllerNearRightShoulder;
-        s_prevRightNearLeftShoulder = s_rightControllerNearLeftShoulder;
-        s_prevRightNearRightShoulder = s_rightControllerNearRightShoulder;
-
-        // Check left controller distances
-        if (leftHandNode)
-        {
-            NiPoint3 leftHandPos = leftHandNode->m_worldTransform.pos;
-
-            float distToLeftShoulder = sqrt(
-                (leftHandPos.x - leftShoulderWorld.x) * (leftHandPos.x - leftShoulderWorld.x) +
-                (leftHandPos.y - leftShoulderWorld.y) * (leftHandPos.y - leftShoulderWorld.y) +
-                (leftHandPos.z - leftShoulderWorld.z) * (leftHandPos.z - leftShoulderWorld.z));
-
-            float distToRightShoulder = sqrt(
-                (leftHandPos.x - rightShoulderWorld.x) * (leftHandPos.x - rightShoulderWorld.x) +
-                (leftHandPos.y - rightShoulderWorld.y) * (leftHandPos.y - rightShoulderWorld.y) +
-                (leftHandPos.z - rightShoulderWorld.z) * (leftHandPos.z - rightShoulderWorld.z));
-
-            s_leftControllerNearLeftShoulder = (distToLeftShoulder <= SHOULDER_ZONE_RADIUS);
-            s_leftControllerNearRightShoulder = (distToRightShoulder <= SHOULDER_ZONE_RADIUS);
-
-            // Log enter/exit events for left controller
-            if (s_leftControllerNearLeftShoulder && !s_prevLeftNearLeftShoulder)
-            {
-                _MESSAGE("VRInputHandler: LEFT controller ENTERED LEFT SHOULDER zone (dist: %.1f)", distToLeftShoulder);
-            }
-            else if (!s_leftControllerNearLeftShoulder && s_prevLeftNearLeftShoulder)
-            {
-                _MESSAGE("VRInputHandler: LEFT controller EXITED LEFT SHOULDER zone");
-            }
-
-            if (s_leftControllerNearRightShoulder && !s_prevLeftNearRightShoulder)
-            {
-                _MESSAGE("VRInputHandler: LEFT controller ENTERED RIGHT SHOULDER zone (dist: %.1f)", distToRightShoulder);
-            }
-            else if (!s_leftControllerNearRightShoulder && s_prevLeftNearRightShoulder)
-            {
-                _MESSAGE("VRInputHandler: LEFT controller EXITED RIGHT SHOULDER zone");
-            }
-        }
-
-        // Check right controller distances
-        if (rightHandNode)
-        {
-            NiPoint3 rightHandPos = rightHandNode->m_worldTransform.pos;
-
-            float distToLeftShoulder = sqrt(
-                (rightHandPos.x - leftShoulderWorld.x) * (rightHandPos.x - leftShoulderWorld.x) +
-                (rightHandPos.y - leftShoulderWorld.y) * (rightHandPos.y - leftShoulderWorld.y) +
-                (rightHandPos.z - leftShoulderWorld.z) * (rightHandPos.z - leftShoulderWorld.z));
-
-            float distToRightShoulder = sqrt(
-                (rightHandPos.x - rightShoulderWorld.x) * (rightHandPos.x - rightShoulderWorld.x) +
-                (rightHandPos.y - rightShoulderWorld.y) * (rightHandPos.y - rightShoulderWorld.y) +
-                (rightHandPos.z - rightShoulderWorld.z) * (rightHandPos.z - rightShoulderWorld.z));
-
-            s_rightControllerNearLeftShoulder = (distToLeftShoulder <= SHOULDER_ZONE_RADIUS);
-            s_rightControllerNearRightShoulder = (distToRightShoulder <= SHOULDER_ZONE_RADIUS);
-
-            // Log enter/exit events for right controller
-            if (s_rightControllerNearLeftShoulder && !s_prevRightNearLeftShoulder)
-            {
-                _MESSAGE("VRInputHandler: RIGHT controller ENTERED LEFT SHOULDER zone (dist: %.1f)", distToLeftShoulder);
-            }
-            else if (!s_rightControllerNearLeftShoulder && s_prevRightNearLeftShoulder)
-            {
-                _MESSAGE("VRInputHandler: RIGHT controller EXITED LEFT SHOULDER zone");
-            }
-
-            if (s_rightControllerNearRightShoulder && !s_prevRightNearRightShoulder)
-            {
-                _MESSAGE("VRInputHandler: RIGHT controller ENTERED RIGHT SHOULDER zone (dist: %.1f)", distToRightShoulder);
-         }
-    else if (!s_rightControllerNearRightShoulder && s_prevRightNearRightShoulder)
-       {
-    _MESSAGE("VRInputHandler: RIGHT controller EXITED RIGHT SHOULDER zone");
-   }
-        }
  
         // ============================================
   // CHECK GRIP + SHOULDER + GRABBED WEAPON
@@ -2568,7 +2413,7 @@ return 0.0f;
 
         
         // Check LEFT controller: in shoulder zone + has grabbed weapon + grip pressed
-        if (IsControllerInShoulderZone(true) && s_leftGripPressed && higgsInterface)
+        if (bodyZones->IsInHolsterZone(true) && s_leftGripPressed && higgsInterface)
   {
    TESObjectREFR* leftGrabbed = higgsInterface->GetGrabbedObject(true);
 if (leftGrabbed && leftGrabbed->baseForm && leftGrabbed->baseForm->formType == kFormType_Weapon)
@@ -2576,16 +2421,16 @@ if (leftGrabbed && leftGrabbed->baseForm && leftGrabbed->baseForm->formType == k
         // Only log on grip press (edge detection)
                 if (!s_leftGripWasPressed)
     {
-         const char* shoulderSide = s_leftControllerNearLeftShoulder ? "LEFT" : "RIGHT";
+         const char* shoulderSide = bodyZones->GetHolsterZoneName(true);
         _MESSAGE("VRInputHandler: === HOLSTER GESTURE DETECTED ===");
-  _MESSAGE("VRInputHandler: LEFT controller + GRIP pressed + grabbed weapon in %s SHOULDER zone", shoulderSide);
+  _MESSAGE("VRInputHandler: LEFT controller + GRIP pressed + grabbed weapon in %s zone", shoulderSide);
       _MESSAGE("VRInputHandler:   Weapon FormID: %08X", leftGrabbed->baseForm->formID);
            }
    }
         }
         
         // Check RIGHT controller: in shoulder zone + has grabbed weapon + grip pressed
-        if (IsControllerInShoulderZone(false) && s_rightGripPressed && higgsInterface)
+        if (bodyZones->IsInHolsterZone(false) && s_rightGripPressed && higgsInterface)
         {
             TESObjectREFR* rightGrabbed = higgsInterface->GetGrabbedObject(false);
          if (rightGrabbed && rightGrabbed->baseForm && rightGrabbed->baseForm->formType == kFormType_Weapon)
@@ -2593,9 +2438,9 @@ if (leftGrabbed && leftGrabbed->baseForm && leftGrabbed->baseForm->formType == k
     // Only log on grip press (edge detection)
    if (!s_rightGripWasPressed)
 {
-           const char* shoulderSide = s_rightControllerNearLeftShoulder ? "LEFT" : "RIGHT";
+           const char* shoulderSide = bodyZones->GetHolsterZoneName(false);
           _MESSAGE("VRInputHandler: === HOLSTER GESTURE DETECTED ===");
-        _MESSAGE("VRInputHandler:   RIGHT controller + GRIP pressed + grabbed weapon in %s SHOULDER zone", shoulderSide);
+        _MESSAGE("VRInputHandler:   RIGHT controller + GRIP pressed + grabbed weapon in %s zone", shoulderSide);
   _MESSAGE("VRInputHandler:   Weapon FormID: %08X", rightGrabbed->baseForm->formID);
       }
             }
@@ -2615,7 +2460,7 @@ if (leftGrabbed && leftGrabbed->baseForm && leftGrabbed->baseForm->formType == k
 
         // Check LEFT controller: in shoulder zone + has grabbed weapon + trigger touched
         bool leftInShoulderWithWeapon = false;
-        if (IsControllerInShoulderZone(true) && s_leftTriggerTouched && higgsInterface)
+        if (bodyZones->IsInHolsterZone(true) && s_leftTriggerTouched && higgsInterface)
         {
             TESObjectREFR* leftGrabbed = higgsInterface->GetGrabbedObject(true);
             if (leftGrabbed && leftGrabbed->baseForm && leftGrabbed->baseForm->formType == kFormType_Weapon)
@@ -2629,9 +2474,9 @@ if (leftGrabbed && leftGrabbed->baseForm && leftGrabbed->baseForm->formType == k
                     higgsInterface->SetSettingDouble("RightShoulderRadius", SHOULDER_RADIUS_HOLSTER);
                     s_leftShoulderRadiusModified = true;
 
-                    const char* shoulderSide = s_leftControllerNearLeftShoulder ? "LEFT" : "RIGHT";
+                    const char* shoulderSide = bodyZones->GetHolsterZoneName(true);
                     _MESSAGE("VRInputHandler: === HOLSTER MODE ENABLED (LEFT controller) ===");
-                    _MESSAGE("VRInputHandler:   Trigger touched + grabbed weapon in %s SHOULDER zone", shoulderSide);
+                    _MESSAGE("VRInputHandler:   Trigger touched + grabbed weapon in %s zone", shoulderSide);
                     _MESSAGE("VRInputHandler:   HIGGS shoulder radius set to 0");
                 }
             }
@@ -2649,7 +2494,7 @@ if (leftGrabbed && leftGrabbed->baseForm && leftGrabbed->baseForm->formType == k
 
         // Check RIGHT controller: in shoulder zone + has grabbed weapon + trigger touched
         bool rightInShoulderWithWeapon = false;
-        if (IsControllerInShoulderZone(false) && s_rightTriggerTouched && higgsInterface)
+        if (bodyZones->IsInHolsterZone(false) && s_rightTriggerTouched && higgsInterface)
         {
             TESObjectREFR* rightGrabbed = higgsInterface->GetGrabbedObject(false);
             if (rightGrabbed && rightGrabbed->baseForm && rightGrabbed->baseForm->formType == kFormType_Weapon)
@@ -2663,9 +2508,9 @@ if (leftGrabbed && leftGrabbed->baseForm && leftGrabbed->baseForm->formType == k
                     higgsInterface->SetSettingDouble("RightShoulderRadius", SHOULDER_RADIUS_HOLSTER);
                     s_rightShoulderRadiusModified = true;
 
-                    const char* shoulderSide = s_rightControllerNearLeftShoulder ? "LEFT" : "RIGHT";
+                    const char* shoulderSide = bodyZones->GetHolsterZoneName(false);
                     _MESSAGE("VRInputHandler: === HOLSTER MODE ENABLED (RIGHT controller) ===");
-                    _MESSAGE("VRInputHandler:   Trigger touched + grabbed weapon in %s SHOULDER zone", shoulderSide);
+                    _MESSAGE("VRInputHandler:   Trigger touched + grabbed weapon in %s zone", shoulderSide);
                     _MESSAGE("VRInputHandler:   HIGGS shoulder radius set to 0");
                 }
             }
@@ -2688,7 +2533,7 @@ if (leftGrabbed && leftGrabbed->baseForm && leftGrabbed->baseForm->formType == k
         // ============================================
 
         // Check LEFT controller: in shoulder zone + has grabbed weapon + grip pressed
-        if (IsControllerInShoulderZone(true) && s_leftGripPressed && higgsInterface)
+        if (bodyZones->IsInHolsterZone(true) && s_leftGripPressed && higgsInterface)
         {
             TESObjectREFR* leftGrabbed = higgsInterface->GetGrabbedObject(true);
             if (leftGrabbed && leftGrabbed->baseForm && leftGrabbed->baseForm->formType == kFormType_Weapon)
@@ -2696,11 +2541,11 @@ if (leftGrabbed && leftGrabbed->baseForm && leftGrabbed->baseForm->formType == k
                 // Only log on grip press (edge detection)
                 if (!s_leftGripWasPressed)
                 {
-                    const char* shoulderSide = s_leftControllerNearLeftShoulder ? "LEFT" : "RIGHT";
+                    const char* shoulderSide = bodyZones->GetHolsterZoneName(true);
                     UInt32 weaponFormID = leftGrabbed->baseForm->formID;
 
                     _MESSAGE("VRInputHandler: === WEAPON ADDED TO INVENTORY (LEFT controller) ===");
-                    _MESSAGE("VRInputHandler:   Grip pressed + grabbed weapon in %s SHOULDER zone", shoulderSide);
+                    _MESSAGE("VRInputHandler:   Grip pressed + grabbed weapon in %s zone", shoulderSide);
                     _MESSAGE("VRInputHandler:   Weapon FormID: %08X", weaponFormID);
 
                     // Clear EquipManager tracking to prevent re-equip on trigger pull
@@ -2718,7 +2563,7 @@ if (leftGrabbed && leftGrabbed->baseForm && leftGrabbed->baseForm->formType == k
         }
 
         // Check RIGHT controller: in shoulder zone + has grabbed weapon + grip pressed
-        if (IsControllerInShoulderZone(false) && s_rightGripPressed && higgsInterface)
+        if (bodyZones->IsInHolsterZone(false) && s_rightGripPressed && higgsInterface)
         {
             TESObjectREFR* rightGrabbed = higgsInterface->GetGrabbedObject(false);
          if (rightGrabbed && rightGrabbed->baseForm && rightGrabbed->baseForm->formType == kFormType_Weapon)
@@ -2726,11 +2571,11 @@ if (leftGrabbed && leftGrabbed->baseForm && leftGrabbed->baseForm->formType == k
                 // Only log on grip press (edge detection)
                 if (!s_rightGripWasPressed)
                 {
-                    const char* shoulderSide = s_rightControllerNearLeftShoulder ? "LEFT" : "RIGHT";
+                    const char* shoulderSide = bodyZones->GetHolsterZoneName(false);
                     UInt32 weaponFormID = rightGrabbed->baseForm->formID;
 
                     _MESSAGE("VRInputHandler: === WEAPON ADDED TO INVENTORY (RIGHT controller) ===");
-                    _MESSAGE("VRInputHandler:   Grip pressed + grabbed weapon in %s SHOULDER zone", shoulderSide);
+                    _MESSAGE("VRInputHandler:   Grip pressed + grabbed weapon in %s zone", shoulderSide);
                     _MESSAGE("VRInputHandler:   Weapon FormID: %08X", weaponFormID);
 
                     // Clear EquipManager tracking to prevent re-equip on trigger pull
@@ -3100,14 +2945,14 @@ if (leftGrabbed && leftGrabbed->baseForm && leftGrabbed->baseForm->formType == k
                     {
                         _MESSAGE("VRInputHandler: LEFT hand TRIGGER HELD - Re-equipping grabbed weapon");
 
-                        bool wasDualWieldingSame = EquipManager::GetSingleton()->WasDualWieldingSameWeapon(true);
+                        bool wasDualWieldingSame = EquipManager::GetSingleton()->IsDroppedWeaponProxy(true);
 
                         PlayerCharacter* player = *g_thePlayer;
                         if (player)
                         {
                             if (wasDualWieldingSame)
                             {
-                                DeleteWorldObject(droppedWeaponLeft);
+                                WeaponRefPool::GetSingleton()->Release(droppedWeaponLeft);
                             }
                             else
                             {
@@ -3158,14 +3003,14 @@ if (leftGrabbed && leftGrabbed->baseForm && leftGrabbed->baseForm->formType == k
                     {
                         _MESSAGE("VRInputHandler: RIGHT hand TRIGGER HELD - Re-equipping grabbed weapon");
 
-                        bool wasDualWieldingSame = EquipManager::GetSingleton()->WasDualWieldingSameWeapon(false);
+                        bool wasDualWieldingSame = EquipManager::GetSingleton()->IsDroppedWeaponProxy(false);
 
                         PlayerCharacter* player = *g_thePlayer;
                         if (player)
                         {
                             if (wasDualWieldingSame)
                             {
-                                DeleteWorldObject(droppedWeaponRight);
+                                WeaponRefPool::GetSingleton()->Release(droppedWeaponRight);
                             }
                             else
                             {
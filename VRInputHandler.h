@@ -44,7 +44,7 @@ namespace FalseEdgeVR
         void CheckAutoEquipGrabbedWeapon(float deltaTime);
     void PauseTracking(bool pause);
      bool IsPaused() const { return m_paused; }
-  void UpdateCombatTracking();
+  void UpdateCombatTracking(float deltaTime);
    bool IsPlayerInCombat() const { return m_isInCombat; }
    float GetClosestTargetDistance() const { return m_closestTargetDistance; }
         bool IsInCloseCombatMode() const { return m_closeCombatMode; }
@@ -149,6 +149,9 @@ namespace FalseEdgeVR
         static void OnStartTwoHanding();
      static void OnStopTwoHanding();
         static void OnPrePhysicsStep(void* world);
+        
+        // Auto-equip weapon held by a VR controller (this frame's pointer, nullptr if none or stale)
+        TESObjectREFR* GetAutoEquipWeapon(bool isLeftVRController) const;
     
         bool m_initialized = false;
         bool m_callbacksRegistered = false;
@@ -160,6 +163,8 @@ namespace FalseEdgeVR
     bool m_wasInCombat = false;
      float m_closestTargetDistance = 9999.0f;
 UInt32 m_closestTargetHandle = 0;
+        RefTableHandle m_combatTargetRef = 0;       // Combat target in RefHandleTable - looked up only when the game handle changes
+        UInt32 m_combatTargetGameHandle = 0;
     float m_combatLogTimer = 0.0f;
     
         // Close combat mode - disables collision avoidance when too close to enemy
@@ -210,8 +215,8 @@ float m_leftHandCooldownTimer = 0.0f;
         bool m_autoEquipPendingRight = false;
         float m_autoEquipTimerLeft = 0.0f;
      float m_autoEquipTimerRight = 0.0f;
-        TESObjectREFR* m_autoEquipWeaponLeft = nullptr;
-        TESObjectREFR* m_autoEquipWeaponRight = nullptr;
+        RefTableHandle m_autoEquipWeaponHandleLeft = 0;    // RefHandleTable - resolve through GetAutoEquipWeapon
+        RefTableHandle m_autoEquipWeaponHandleRight = 0;
         UInt32 m_autoEquipFormIDLeft = 0;   // FormID for grabbed weapon auto-equip
  UInt32 m_autoEquipFormIDRight = 0;  // FormID for grabbed weapon auto-equip
 
@@ -3,15 +3,23 @@
 #include "EquipManager.h"
 #include "VRInputHandler.h"
 #include "config.h"
+#include "WeaponProfileDB.h"
+#include "MeshNarrowphase.h"
+#include "ThresholdCalibration.h"
 #include "skse64/GameRTTI.h"
 #include "skse64/NiNodes.h"
 #include <cmath>
 #include <cfloat>
+#include <chrono>
 
 namespace FalseEdgeVR
 {
     // Static constant for blade radius (thickness)
     const float WeaponGeometryTracker::BLADE_RADIUS = 2.0f;  // Approximate blade thickness in units
+    
+    // Slack on top of the widest threshold before the tiers reject - covers ray capsules,
+    // mace heads / axe bits and crossguards in the real meshes reaching past the blade line
+    const float WeaponGeometryTracker::TIER_REACH_MARGIN = 10.0f;
 
     // ============================================
     // WeaponGeometryTracker Implementation
@@ -39,7 +47,7 @@ m_geometryState.leftHand.Clear();
     m_wasImminent = false;
     m_bladesGrinding = false;
       m_wasGrinding = false;
-        m_grindStartTime = 0.0f;
+        m_contactManifold.Clear();
         m_grindDuration = 0.0f;
         m_framesSinceEquipChange = 0;
         m_lastUpdateTime = 0.0f;
@@ -50,18 +58,21 @@ m_geometryState.leftHand.Clear();
         
         _MESSAGE("WeaponGeometryTracker: Collision threshold: %.2f, Imminent threshold: %.2f", 
             m_collisionThreshold, m_imminentThreshold);
-        _MESSAGE("WeaponGeometryTracker: Raycasting enabled with %d samples per blade, blade radius: %.2f",
-      RAYCAST_SAMPLES, BLADE_RADIUS);
+        _MESSAGE("WeaponGeometryTracker: Raycasting enabled with %d-%d adaptive samples per blade, blade radius: %.2f",
+      RAYCAST_MIN_SAMPLES, RAYCAST_MAX_SAMPLES, BLADE_RADIUS);
+        _MESSAGE("WeaponGeometryTracker: Velocity source: %d (0=finite difference, 1=OpenVR, 2=HIGGS)", bladeVelocitySource);
         
         m_initialized = true;
 LOG("WeaponGeometryTracker: Initialized successfully");
     }
 
-    void WeaponGeometryTracker::Update(float deltaTime)
+    void WeaponGeometryTracker::UpdateGeometry(float deltaTime, const CollisionHand* hands)
     {
    static int updateCount = 0;
    static bool loggedOnce = false;
         
+        m_bladePairValid = false;
+        
         if (!m_initialized)
           return;
 
@@ -81,18 +92,11 @@ loggedOnce = true;
         if (!player || !player->loadedState)
     return;
 
-      const PlayerEquipState& equipState = EquipManager::GetSingleton()->GetEquipState();
-      
-        // DIRECT check for shields - more reliable than EquipManager state
-   TESForm* leftEquipped = player->GetEquippedObject(true);
-   TESForm* rightEquipped = player->GetEquippedObject(false);
-        bool leftIsShield = leftEquipped && EquipManager::IsShield(leftEquipped);
- bool rightIsShield = rightEquipped && EquipManager::IsShield(rightEquipped);
-        
         // Check for equipment changes - reset grace period if weapons changed
+        // Equipment comes from CollisionWorld (re-resolved when EquipEventHandler bumps the generation)
         // Note: Ignore shields - they are handled by ShieldCollisionTracker
-   UInt32 currentLeftFormID = (leftEquipped && !leftIsShield) ? leftEquipped->formID : 0;
-        UInt32 currentRightFormID = (rightEquipped && !rightIsShield) ? rightEquipped->formID : 0;
+        UInt32 currentLeftFormID = hands[kSlotLeftHand].weaponFormID;
+        UInt32 currentRightFormID = hands[kSlotRightHand].weaponFormID;
     
      if (currentLeftFormID != m_lastLeftWeaponFormID || currentRightFormID != m_lastRightWeaponFormID)
    {
@@ -112,6 +116,11 @@ m_framesSinceEquipChange = 0;
   m_wasInContact = false;
     m_collisionImminent = false;
             m_wasImminent = false;
+            m_contactManifold.Clear();
+
+            // The blade sits differently in the hand with another weapon - capture its controller-space pose again
+            m_hasControllerLocalBlade[0] = false;
+            m_hasControllerLocalBlade[1] = false;
  }
  
         // Increment frame counter
@@ -121,8 +130,8 @@ m_framesSinceEquipChange = 0;
 // Off-hand is determined by INI setting CollisionAvoidanceHand (0=left, 1=right)
    bool offHandIsLeft = GetCollisionAvoidanceHandIsLeft();
    bool offHandVRControllerIsLeft = GameHandToVRController(offHandIsLeft);
-   bool offHandHiggsGrabbed = false;
-   TESObjectREFR* higgsHeldOffHand = nullptr;
+   TESObjectREFR* higgsHeldOffHand = hands[offHandIsLeft ? kSlotLeftHand : kSlotRightHand].grabbedRef;
+   bool offHandHiggsGrabbed = (higgsHeldOffHand != nullptr);
 
    // Debug: Log handedness mode periodically
    static int handednessLogCounter = 0;
@@ -135,62 +144,48 @@ m_framesSinceEquipChange = 0;
            offHandVRControllerIsLeft ? "YES" : "NO");
    }
 
-   if (EquipManager::GetSingleton()->HasPendingReequip(offHandIsLeft))
-   {
-       // Get the dropped weapon reference we created
-       higgsHeldOffHand = EquipManager::GetSingleton()->GetDroppedWeaponRef(offHandIsLeft);
-       if (higgsHeldOffHand)
-       {
-           // Check if HIGGS is actually holding it
-           if (higgsInterface)
-           {
-               TESObjectREFR* currentlyHeld = higgsInterface->GetGrabbedObject(offHandVRControllerIsLeft);
-               if (currentlyHeld == higgsHeldOffHand)
-               {
-                   offHandHiggsGrabbed = true;
-               }
-           }
-       }
-   }
+   TrackSwapLatency(offHandHiggsGrabbed);
 
    // Debug logging for HIGGS state
    static bool loggedHiggsState = false;
    if (EquipManager::GetSingleton()->HasPendingReequip(offHandIsLeft) && !loggedHiggsState)
    {
        _MESSAGE("WeaponGeometry: Pending reequip - DroppedRef: %p, HIGGS holding: %s",
-           higgsHeldOffHand, offHandHiggsGrabbed ? "YES" : "NO");
+           EquipManager::GetSingleton()->GetDroppedWeaponRef(offHandIsLeft), offHandHiggsGrabbed ? "YES" : "NO");
        loggedHiggsState = true;
    }
    
    // Update left hand geometry - skip if shield (ShieldCollisionTracker handles that)
-   if (leftEquipped && !leftIsShield)
+   if (m_lastLeftWeaponFormID != 0)
    {
        // Normal equipped weapon
        UpdateHandGeometry(true, deltaTime);
    }
-   else if (offHandHiggsGrabbed && higgsHeldOffHand && offHandIsLeft)
+   else if (hands[kSlotLeftHand].grabbedRef)
    {
        // HIGGS-grabbed weapon in left hand - update geometry from the grabbed object
-       UpdateHiggsGrabbedGeometry(true, higgsHeldOffHand, deltaTime);
+       UpdateHiggsGrabbedGeometry(true, hands[kSlotLeftHand].grabbedRef, deltaTime);
    }
    else
    {
        m_geometryState.leftHand.Clear();
+       m_hasControllerLocalBlade[0] = false;
    }
 
    // Update right hand if weapon equipped - skip if shield
-   if (rightEquipped && !rightIsShield)
+   if (m_lastRightWeaponFormID != 0)
    {
        UpdateHandGeometry(false, deltaTime);
    }
-   else if (offHandHiggsGrabbed && higgsHeldOffHand && !offHandIsLeft)
+   else if (hands[kSlotRightHand].grabbedRef)
    {
        // HIGGS-grabbed weapon in right hand - update geometry from the grabbed object
-       UpdateHiggsGrabbedGeometry(false, higgsHeldOffHand, deltaTime);
+       UpdateHiggsGrabbedGeometry(false, hands[kSlotRightHand].grabbedRef, deltaTime);
    }
    else
    {
        m_geometryState.rightHand.Clear();
+       m_hasControllerLocalBlade[1] = false;
    }
         
         // Check for blade collision if both hands have valid weapons
@@ -207,8 +202,23 @@ m_framesSinceEquipChange = 0;
   fabs(m_geometryState.rightHand.basePosition.y) > 0.1f ||
    fabs(m_geometryState.rightHand.basePosition.z) > 0.1f);
 
-        if (leftGeomValid && rightGeomValid)
-   {
+        m_bladePairValid = leftGeomValid && rightGeomValid;
+    }
+
+    bool WeaponGeometryTracker::ProcessBladePair(const Collider& bladeA, const Collider& bladeB, BladeCollisionResult& outResult)
+    {
+        outResult.Clear();
+
+        // The kernel works on this tracker's left/right blades - the colliders must be exactly those
+        const Collider& left = (bladeA.slot == kSlotLeftHand) ? bladeA : bladeB;
+        const Collider& right = (bladeA.slot == kSlotLeftHand) ? bladeB : bladeA;
+        if (!m_bladePairValid || left.slot != kSlotLeftHand || right.slot != kSlotRightHand ||
+            left.blade != &m_geometryState.leftHand || right.blade != &m_geometryState.rightHand)
+            return false;
+
+        bool offHandIsLeft = GetCollisionAvoidanceHandIsLeft();
+        bool offHandHiggsGrabbed = (offHandIsLeft ? left : right).grabbed;
+        
             // Log once when both weapons are valid (including HIGGS grabbed)
        static bool loggedBothValid = false;
          static bool loggedHiggsTracking = false;
@@ -243,8 +253,8 @@ m_wasInContact = m_bladesInContact;
             m_wasImminent = m_collisionImminent;
           m_wasGrinding = m_bladesGrinding;
           
-            BladeCollisionResult collision;
-   bool detected = CheckBladeCollision(collision);
+            BladeCollisionResult& collision = outResult;
+   CheckBladeCollision(collision);
     
          // Log distance periodically when HIGGS grabbed
     static int distanceLogCounter = 0;
@@ -289,12 +299,13 @@ _MESSAGE("  Distance: %.2f, Raycast Hits: %d", collision.closestDistance, collis
        // Log when grinding starts
                 if (collision.isGrinding && !m_wasGrinding)
                {
-           _MESSAGE("WeaponGeometry: *** GRINDING STARTED *** (duration: %.2fs, velocity: %.1f)",
-         collision.grindDuration, collision.relativeVelocity);
+           _MESSAGE("WeaponGeometry: *** GRINDING STARTED *** (duration: %.2fs, velocity: %.1f, slide L=%.1f R=%.1f)",
+         collision.grindDuration, collision.relativeVelocity,
+                    m_contactManifold.leftSlideSpeed, m_contactManifold.rightSlideSpeed);
     }
 
          // Check for X-POSE every frame while blades are touching
-             CheckXPose(m_geometryState.leftHand, m_geometryState.rightHand);
+             CheckXPose(m_contactManifold);
     }
    else if (m_collisionImminent)
     {
@@ -376,6 +387,10 @@ else if (wasJustGrinding)
        _MESSAGE("WeaponGeometry: Triggering game %s hand unequip + HIGGS grab!", 
        offHandIsLeft ? "LEFT" : "RIGHT");
       EquipManager::GetSingleton()->ForceUnequipAndGrab(offHandIsLeft);
+
+      m_swapLatencyPending = true;
+      m_swapLatencyPredicted = m_geometryState.leftHand.hasPrediction && m_geometryState.rightHand.hasPrediction;
+      m_swapDetectTime = m_lastUpdateTime;
    }
                 }
           else if (!offHandOnCooldown && !inGracePeriod && !wasJustGrinding)
@@ -396,8 +411,8 @@ collision.closestDistance, m_collisionThreshold);
         
           if (m_wasGrinding)
      {
-     _MESSAGE("WeaponGeometry: *** GRINDING ENDED *** (total duration: %.2fs)",
-         m_grindDuration);
+     _MESSAGE("WeaponGeometry: *** GRINDING ENDED *** (total duration: %.2fs, slid L=%.1f R=%.1f)",
+         m_contactManifold.duration, m_contactManifold.leftTravel, m_contactManifold.rightTravel);
   }
      
      if (m_inXPose)
@@ -415,7 +430,8 @@ collision.closestDistance, m_collisionThreshold);
            
      m_lastCollision.Clear();
       }
-        }
+        
+        return true;
     }
 
     // Update geometry for a HIGGS-grabbed weapon
@@ -469,9 +485,8 @@ collision.closestDistance, m_collisionThreshold);
        return;
         }
 
-  // Calculate blade positions from the grabbed object's transform
-        float reach = weapon->gameData.reach;
-   float bladeLength = reach * 70.0f;
+  // Calculate blade positions from the grabbed object's transform - same length as when equipped
+        float bladeLength = GetBladeLength(weapon, objectNode);
    
         // Base position is the object's world position
         geometry.basePosition = objectNode->m_worldTransform.pos;
@@ -498,6 +513,10 @@ collision.closestDistance, m_collisionThreshold);
         geometry.tipPosition.x = geometry.basePosition.x + bladeDirection.x * bladeLength;
         geometry.tipPosition.y = geometry.basePosition.y + bladeDirection.y * bladeLength;
         geometry.tipPosition.z = geometry.basePosition.z + bladeDirection.z * bladeLength;
+        geometry.edgeAxis = NiPoint3(rot.data[0][0], rot.data[1][0], rot.data[2][0]);
+        geometry.weaponType = EquipManager::GetWeaponType(weapon);
+        geometry.formID = weapon->formID;
+        geometry.nodeTransform = objectNode->m_worldTransform;
     
    // Calculate blade length
         NiPoint3 bladeVector;
@@ -521,9 +540,12 @@ bladeVector.y * bladeVector.y +
    geometry.baseVelocity.y = (geometry.basePosition.y - geometry.prevBasePosition.y) / deltaTime;
          geometry.baseVelocity.z = (geometry.basePosition.z - geometry.prevBasePosition.z) / deltaTime;
     }
-      
+
+        ApplyVelocitySource(geometry, isLeftHand, true);
+        UpdatePredictedGeometry(geometry, isLeftHand);
+
         geometry.isValid = true;
-        
+
         // Log periodically to confirm tracking is working
         static int logCounter = 0;
 logCounter++;
@@ -565,8 +587,7 @@ if (isLeftHand && !loggedLeftFail)
         }
         
         // Get the equipped weapon form
-        PlayerCharacter* player = *g_thePlayer;
- TESForm* equippedForm = player->GetEquippedObject(isLeftHand);
+        TESForm* equippedForm = EquipManager::GetSingleton()->GetEquippedObject(isLeftHand);
       TESObjectWEAP* weapon = DYNAMIC_CAST(equippedForm, TESForm, TESObjectWEAP);
       
         if (!weapon)
@@ -608,6 +629,13 @@ _MESSAGE("WeaponGeometryTracker: LEFT hand - Got weapon node and form! Reach: %.
         // Calculate blade positions
         geometry.basePosition = CalculateBladeBase(weaponNode, isLeftHand);
         geometry.tipPosition = CalculateBladeTip(weaponNode, weapon, isLeftHand);
+        geometry.edgeAxis = NiPoint3(
+            weaponNode->m_worldTransform.rot.data[0][0],
+            weaponNode->m_worldTransform.rot.data[1][0],
+            weaponNode->m_worldTransform.rot.data[2][0]);
+        geometry.weaponType = EquipManager::GetWeaponType(weapon);
+        geometry.formID = weapon->formID;
+        geometry.nodeTransform = weaponNode->m_worldTransform;
       
         // Calculate blade length
         NiPoint3 bladeVector;
@@ -631,7 +659,10 @@ _MESSAGE("WeaponGeometryTracker: LEFT hand - Got weapon node and form! Reach: %.
   geometry.baseVelocity.y = (geometry.basePosition.y - geometry.prevBasePosition.y) / deltaTime;
          geometry.baseVelocity.z = (geometry.basePosition.z - geometry.prevBasePosition.z) / deltaTime;
         }
-      
+
+        ApplyVelocitySource(geometry, isLeftHand, false);
+        UpdatePredictedGeometry(geometry, isLeftHand);
+
         geometry.isValid = true;
     }
 
@@ -731,8 +762,7 @@ return "SHIELD";
         if (!weaponNode || !weapon)
          return NiPoint3(0, 0, 0);
 
-        float reach = weapon->gameData.reach;
-        float bladeLength = reach * 70.0f;
+        float bladeLength = GetBladeLength(weapon, weaponNode);
         
         NiMatrix33& rot = weaponNode->m_worldTransform.rot;
         
@@ -761,11 +791,346 @@ return "SHIELD";
   );
     }
 
+    float WeaponGeometryTracker::GetBladeLength(TESObjectWEAP* weapon, NiAVObject* weaponNode)
+    {
+        if (useBladeProfiles)
+        {
+            const BladeProfileRecord* profile = WeaponProfileDB::GetSingleton()->Find(weapon->formID);
+            if (profile && profile->length > 0.0f)
+                return profile->length * weaponNode->m_worldTransform.scale;
+        }
+        return weapon->gameData.reach * 70.0f;
+    }
+
+    void WeaponGeometryTracker::ResetGeometry()
+    {
+        // Cleared previous positions also keep the first update from computing a velocity across the gap
+        m_geometryState.leftHand.Clear();
+        m_geometryState.rightHand.Clear();
+        m_hasControllerLocalBlade[0] = false;
+        m_hasControllerLocalBlade[1] = false;
+        m_bladesInContact = false;
+        m_wasInContact = false;
+        m_collisionImminent = false;
+        m_wasImminent = false;
+        m_bladesGrinding = false;
+        m_wasGrinding = false;
+        m_contactManifold.Clear();
+        for (GjkCache& cache : m_gjkCaches)
+        {
+            cache.Clear();
+        }
+    }
+
     const BladeGeometry& WeaponGeometryTracker::GetBladeGeometry(bool isLeftHand) const
     {
         return isLeftHand ? m_geometryState.leftHand : m_geometryState.rightHand;
     }
 
+    // ============================================
+    // Velocity Sources
+    // ============================================
+
+    // Havok layout for reading HIGGS rigid bodies (bhkRigidBody -> hkpRigidBody -> hkpMotion)
+    static const UInt32 kBhkRefObjectHavokObjectOffset = 0x10;   // bhkRefObject::hkObject
+    static const UInt32 kHkpEntityMotionOffset = 0x150;          // hkpEntity::m_motion
+    static const UInt32 kHkpMotionCenterOfMassOffset = 0x70;     // hkpMotion::m_motionState.m_sweptTransform.m_centerOfMass1
+    static const UInt32 kHkpMotionLinearVelocityOffset = 0xE0;   // hkpMotion::m_linearVelocity
+    static const UInt32 kHkpMotionAngularVelocityOffset = 0xF0;  // hkpMotion::m_angularVelocity
+    static const float kHavokWorldScale = 0.0142875f;            // Game units -> havok meters
+    static const float kOpenVRMetersToGameUnits = 70.0f;         // OpenVR meters -> game units (70 = ~1 meter)
+    static const float kLocalBladeCaptureMaxSpeed = 0.05f;       // Controller still enough (m/s) to capture the blade in controller space
+    static const float kLocalBladeCaptureMaxAngular = 0.3f;      // ... and rad/s
+
+    // Rotate an OpenVR tracking-space vector (Y up, -Z forward) into game world space via the room node
+    static NiPoint3 TrackingToWorldDirection(const NiMatrix33& roomRot, float x, float y, float z)
+    {
+        // OpenVR (x, y, z) -> Skyrim room space (x, -z, y)
+        NiPoint3 local(x, -z, y);
+        return NiPoint3(
+            roomRot.data[0][0] * local.x + roomRot.data[0][1] * local.y + roomRot.data[0][2] * local.z,
+            roomRot.data[1][0] * local.x + roomRot.data[1][1] * local.y + roomRot.data[1][2] * local.z,
+            roomRot.data[2][0] * local.x + roomRot.data[2][1] * local.y + roomRot.data[2][2] * local.z
+        );
+    }
+
+    // Get the room node that maps OpenVR tracking space into the game world
+    static NiNode* GetRoomNode()
+    {
+        PlayerCharacter* player = *g_thePlayer;
+        if (!player)
+            return nullptr;
+
+        return player->unk3F0[PlayerCharacter::Node::kRoomNode];
+    }
+
+    // Fetch a controller pose from OpenVR, predicted predictSeconds ahead (0 = current)
+    static bool GetControllerTrackingPose(bool isLeftVRController, float predictSeconds, vr_1_0_12::TrackedDevicePose_t& outPose)
+    {
+        BSOpenVR* openVR = (*g_openVR);
+        if (!openVR || !openVR->vrSystem)
+            return false;
+
+        vr_1_0_12::IVRSystem* vrSystem = openVR->vrSystem;
+        vr_1_0_12::TrackedDeviceIndex_t controller = vrSystem->GetTrackedDeviceIndexForControllerRole(
+            isLeftVRController ?
+            vr_1_0_12::ETrackedControllerRole::TrackedControllerRole_LeftHand :
+            vr_1_0_12::ETrackedControllerRole::TrackedControllerRole_RightHand);
+        if (controller >= vr_1_0_12::k_unMaxTrackedDeviceCount)
+            return false;
+
+        static vr_1_0_12::TrackedDevicePose_t poses[vr_1_0_12::k_unMaxTrackedDeviceCount];
+        vrSystem->GetDeviceToAbsoluteTrackingPose(vr_1_0_12::ETrackingUniverseOrigin::TrackingUniverseStanding, predictSeconds,
+            poses, vr_1_0_12::k_unMaxTrackedDeviceCount);
+
+        outPose = poses[controller];
+        return outPose.bPoseIsValid;
+    }
+
+    // Convert an OpenVR tracking pose into a game world transform
+    static void TrackingPoseToWorld(const NiTransform& room, const vr_1_0_12::TrackedDevicePose_t& pose, NiTransform& outWorld)
+    {
+        const vr_1_0_12::HmdMatrix34_t& m = pose.mDeviceToAbsoluteTracking;
+
+        NiPoint3 offset = TrackingToWorldDirection(room.rot, m.m[0][3], m.m[1][3], m.m[2][3]);
+        outWorld.pos.x = room.pos.x + offset.x * kOpenVRMetersToGameUnits;
+        outWorld.pos.y = room.pos.y + offset.y * kOpenVRMetersToGameUnits;
+        outWorld.pos.z = room.pos.z + offset.z * kOpenVRMetersToGameUnits;
+
+        // Skyrim local axes in OpenVR terms: X = X, Y = -Z, Z = Y
+        NiPoint3 axisX = TrackingToWorldDirection(room.rot, m.m[0][0], m.m[1][0], m.m[2][0]);
+        NiPoint3 axisY = TrackingToWorldDirection(room.rot, -m.m[0][2], -m.m[1][2], -m.m[2][2]);
+        NiPoint3 axisZ = TrackingToWorldDirection(room.rot, m.m[0][1], m.m[1][1], m.m[2][1]);
+        outWorld.rot.data[0][0] = axisX.x; outWorld.rot.data[0][1] = axisY.x; outWorld.rot.data[0][2] = axisZ.x;
+        outWorld.rot.data[1][0] = axisX.y; outWorld.rot.data[1][1] = axisY.y; outWorld.rot.data[1][2] = axisZ.y;
+        outWorld.rot.data[2][0] = axisX.z; outWorld.rot.data[2][1] = axisY.z; outWorld.rot.data[2][2] = axisZ.z;
+        outWorld.scale = 1.0f;
+    }
+
+    // transpose(rot) * v - world direction into the frame described by rot
+    static NiPoint3 InverseRotate(const NiMatrix33& rot, const NiPoint3& v)
+    {
+        return NiPoint3(
+            rot.data[0][0] * v.x + rot.data[1][0] * v.y + rot.data[2][0] * v.z,
+            rot.data[0][1] * v.x + rot.data[1][1] * v.y + rot.data[2][1] * v.z,
+            rot.data[0][2] * v.x + rot.data[1][2] * v.y + rot.data[2][2] * v.z);
+    }
+
+    // pos + rot * v - frame-local point into world space
+    static NiPoint3 TransformPoint(const NiTransform& frame, const NiPoint3& v)
+    {
+        const NiMatrix33& rot = frame.rot;
+        return NiPoint3(
+            frame.pos.x + rot.data[0][0] * v.x + rot.data[0][1] * v.y + rot.data[0][2] * v.z,
+            frame.pos.y + rot.data[1][0] * v.x + rot.data[1][1] * v.y + rot.data[1][2] * v.z,
+            frame.pos.z + rot.data[2][0] * v.x + rot.data[2][1] * v.y + rot.data[2][2] * v.z);
+    }
+
+    bool WeaponGeometryTracker::GetControllerVelocity(bool isLeftHand, RigidBodyVelocity& outVelocity)
+    {
+        NiNode* roomNode = GetRoomNode();
+        if (!roomNode)
+            return false;
+
+        vr_1_0_12::TrackedDevicePose_t pose;
+        if (!GetControllerTrackingPose(GameHandToVRController(isLeftHand), 0.0f, pose))
+            return false;
+
+        const NiTransform& room = roomNode->m_worldTransform;
+        const vr_1_0_12::HmdMatrix34_t& m = pose.mDeviceToAbsoluteTracking;
+
+        NiPoint3 controllerOffset = TrackingToWorldDirection(room.rot, m.m[0][3], m.m[1][3], m.m[2][3]);
+        outVelocity.origin.x = room.pos.x + controllerOffset.x * kOpenVRMetersToGameUnits;
+        outVelocity.origin.y = room.pos.y + controllerOffset.y * kOpenVRMetersToGameUnits;
+        outVelocity.origin.z = room.pos.z + controllerOffset.z * kOpenVRMetersToGameUnits;
+
+        NiPoint3 linear = TrackingToWorldDirection(room.rot, pose.vVelocity.v[0], pose.vVelocity.v[1], pose.vVelocity.v[2]);
+        outVelocity.linearVelocity.x = linear.x * kOpenVRMetersToGameUnits;
+        outVelocity.linearVelocity.y = linear.y * kOpenVRMetersToGameUnits;
+        outVelocity.linearVelocity.z = linear.z * kOpenVRMetersToGameUnits;
+
+        outVelocity.angularVelocity = TrackingToWorldDirection(room.rot,
+            pose.vAngularVelocity.v[0], pose.vAngularVelocity.v[1], pose.vAngularVelocity.v[2]);
+        return true;
+    }
+
+    bool WeaponGeometryTracker::GetRigidBodyVelocity(bool isLeftHand, bool isHiggsGrabbed, RigidBodyVelocity& outVelocity)
+    {
+        if (!higgsInterface)
+            return false;
+
+        bool isLeftVRController = GameHandToVRController(isLeftHand);
+        NiObject* rigidBody = isHiggsGrabbed ?
+            higgsInterface->GetGrabbedRigidBody(isLeftVRController) :
+            higgsInterface->GetWeaponRigidBody(isLeftVRController);
+        if (!rigidBody)
+            return false;
+
+        UInt8* havokBody = *reinterpret_cast<UInt8**>(reinterpret_cast<UInt8*>(rigidBody) + kBhkRefObjectHavokObjectOffset);
+        if (!havokBody)
+            return false;
+
+        const float* centerOfMass = reinterpret_cast<const float*>(havokBody + kHkpEntityMotionOffset + kHkpMotionCenterOfMassOffset);
+        const float* linear = reinterpret_cast<const float*>(havokBody + kHkpEntityMotionOffset + kHkpMotionLinearVelocityOffset);
+        const float* angular = reinterpret_cast<const float*>(havokBody + kHkpEntityMotionOffset + kHkpMotionAngularVelocityOffset);
+
+        // Havok works in meters - convert back to game units (angular velocity is scale independent)
+        float invScale = 1.0f / kHavokWorldScale;
+        outVelocity.origin = NiPoint3(centerOfMass[0] * invScale, centerOfMass[1] * invScale, centerOfMass[2] * invScale);
+        outVelocity.linearVelocity = NiPoint3(linear[0] * invScale, linear[1] * invScale, linear[2] * invScale);
+        outVelocity.angularVelocity = NiPoint3(angular[0], angular[1], angular[2]);
+        return true;
+    }
+
+    void WeaponGeometryTracker::ApplyVelocitySource(BladeGeometry& geometry, bool isLeftHand, bool isHiggsGrabbed)
+    {
+        if (bladeVelocitySource == (int)BladeVelocitySource::FiniteDifference)
+            return;
+
+        RigidBodyVelocity body;
+        bool haveBody = false;
+        if (bladeVelocitySource == (int)BladeVelocitySource::OpenVRController)
+        {
+            haveBody = GetControllerVelocity(isLeftHand, body);
+        }
+        else if (bladeVelocitySource == (int)BladeVelocitySource::HiggsRigidBody)
+        {
+            haveBody = GetRigidBodyVelocity(isLeftHand, isHiggsGrabbed, body);
+        }
+
+        if (!haveBody)
+        {
+            // Source unavailable this frame - keep the finite-difference velocities
+            m_velocityFallbackCount++;
+            return;
+        }
+
+        NiPoint3 tipVelocity = body.PointVelocity(geometry.tipPosition);
+        NiPoint3 baseVelocity = body.PointVelocity(geometry.basePosition);
+
+        // Compare against the finite-difference result computed this frame
+        NiPoint3 tipDelta(tipVelocity.x - geometry.tipVelocity.x,
+            tipVelocity.y - geometry.tipVelocity.y,
+            tipVelocity.z - geometry.tipVelocity.z);
+        m_velocityTipDeltaSum += Length(tipDelta);
+        m_velocitySampleCount++;
+
+        geometry.tipVelocity = tipVelocity;
+        geometry.baseVelocity = baseVelocity;
+
+        if (m_velocitySampleCount >= 500)
+        {
+            _MESSAGE("WeaponGeometry: Velocity source %s vs finite difference - mean tip delta %.1f u/s over %d samples, %d fallbacks",
+                bladeVelocitySource == (int)BladeVelocitySource::OpenVRController ? "OpenVR" : "HIGGS",
+                m_velocityTipDeltaSum / (float)m_velocitySampleCount, m_velocitySampleCount, m_velocityFallbackCount);
+            m_velocitySampleCount = 0;
+            m_velocityFallbackCount = 0;
+            m_velocityTipDeltaSum = 0.0f;
+        }
+    }
+
+    // ============================================
+    // Predicted Poses
+    // ============================================
+
+    void WeaponGeometryTracker::UpdatePredictedGeometry(BladeGeometry& geometry, bool isLeftHand)
+    {
+        geometry.hasPrediction = false;
+
+        if (bladePredictionTime <= 0.0f)
+            return;
+
+        NiNode* roomNode = GetRoomNode();
+        if (!roomNode)
+            return;
+
+        int handIndex = isLeftHand ? 0 : 1;
+        bool isLeftVRController = GameHandToVRController(isLeftHand);
+        const NiTransform& room = roomNode->m_worldTransform;
+
+        // Cache the blade in controller space once per equip/grab. The weapon node is last game frame's pose
+        // while OpenVR returns this frame's, so only capture while the controller is still - the two agree then
+        vr_1_0_12::TrackedDevicePose_t currentPose;
+        if (!m_hasControllerLocalBlade[handIndex] && GetControllerTrackingPose(isLeftVRController, 0.0f, currentPose) &&
+            Length(NiPoint3(currentPose.vVelocity.v[0], currentPose.vVelocity.v[1], currentPose.vVelocity.v[2])) < kLocalBladeCaptureMaxSpeed &&
+            Length(NiPoint3(currentPose.vAngularVelocity.v[0], currentPose.vAngularVelocity.v[1], currentPose.vAngularVelocity.v[2])) < kLocalBladeCaptureMaxAngular)
+        {
+            NiTransform controllerWorld;
+            TrackingPoseToWorld(room, currentPose, controllerWorld);
+
+            m_controllerLocalBase[handIndex] = InverseRotate(controllerWorld.rot, geometry.basePosition - controllerWorld.pos);
+            m_controllerLocalTip[handIndex] = InverseRotate(controllerWorld.rot, geometry.tipPosition - controllerWorld.pos);
+            m_hasControllerLocalBlade[handIndex] = true;
+        }
+
+        if (!m_hasControllerLocalBlade[handIndex])
+            return;
+
+        vr_1_0_12::TrackedDevicePose_t predictedPose;
+        if (!GetControllerTrackingPose(isLeftVRController, bladePredictionTime, predictedPose))
+            return;
+
+        NiTransform predictedController;
+        TrackingPoseToWorld(room, predictedPose, predictedController);
+
+        geometry.predictedBasePosition = TransformPoint(predictedController, m_controllerLocalBase[handIndex]);
+        geometry.predictedTipPosition = TransformPoint(predictedController, m_controllerLocalTip[handIndex]);
+        geometry.hasPrediction = true;
+    }
+
+    // Detection-to-swap latency histogram, one per mode (current pose / predicted pose)
+    struct SwapLatencyHistogram
+    {
+        static const int BUCKET_COUNT = 6;
+        int buckets[BUCKET_COUNT] = {};
+        int count = 0;
+        float sum = 0.0f;
+        float maxLatency = 0.0f;
+    };
+    static const float kSwapLatencyBucketLimits[SwapLatencyHistogram::BUCKET_COUNT - 1] = { 0.011f, 0.022f, 0.033f, 0.050f, 0.100f };
+    static SwapLatencyHistogram s_swapLatency[2];  // [0] = current pose, [1] = predicted pose
+
+    void WeaponGeometryTracker::TrackSwapLatency(bool offHandHiggsGrabbed)
+    {
+        if (!m_swapLatencyPending)
+            return;
+
+        float latency = m_lastUpdateTime - m_swapDetectTime;
+
+        // Swap never completed (trigger held, drop, menu...) - discard the sample
+        if (latency > 2.0f)
+        {
+            m_swapLatencyPending = false;
+            return;
+        }
+
+        if (!offHandHiggsGrabbed)
+            return;
+
+        m_swapLatencyPending = false;
+
+        SwapLatencyHistogram& histogram = s_swapLatency[m_swapLatencyPredicted ? 1 : 0];
+        int bucket = 0;
+        while (bucket < SwapLatencyHistogram::BUCKET_COUNT - 1 && latency >= kSwapLatencyBucketLimits[bucket])
+        {
+            bucket++;
+        }
+        histogram.buckets[bucket]++;
+        histogram.count++;
+        histogram.sum += latency;
+        if (latency > histogram.maxLatency)
+            histogram.maxLatency = latency;
+
+        if (histogram.count % 10 == 0)
+        {
+            _MESSAGE("WeaponGeometry: Detection-to-swap latency (%s pose): n=%d mean=%.1fms max=%.1fms [<11ms:%d <22ms:%d <33ms:%d <50ms:%d <100ms:%d >=100ms:%d]",
+                m_swapLatencyPredicted ? "predicted" : "current",
+                histogram.count, histogram.sum / (float)histogram.count * 1000.0f, histogram.maxLatency * 1000.0f,
+                histogram.buckets[0], histogram.buckets[1], histogram.buckets[2],
+                histogram.buckets[3], histogram.buckets[4], histogram.buckets[5]);
+        }
+    }
+
     void WeaponGeometryTracker::LogGeometryState()
     {
         if (m_geometryState.leftHand.isValid)
@@ -797,12 +1162,175 @@ return "SHIELD";
     // Blade Collision Detection
     // ============================================
 
+    // ============================================
+    // COLLISION KERNELS
+    // Everything that depends only on the weapon types is decided at compile time:
+    // one CheckBladeCollisionKernel per (left, right) type pair, picked from a table
+    // when a hand's weapon type changes (equip, HIGGS grab) instead of re-deciding
+    // dagger scaling and which tests to run on every check.
+    // ============================================
+    template <WeaponType Left, WeaponType Right>
+    struct CollisionKernelPolicy
+    {
+        static constexpr bool kBothDaggers = Left == WeaponType::Dagger && Right == WeaponType::Dagger;
+        static constexpr bool kEitherDagger = Left == WeaponType::Dagger || Right == WeaponType::Dagger;
+        
+        // Short blades need tighter thresholds: quarter for two daggers, half for one
+        static constexpr float kThresholdScale = kBothDaggers ? 0.25f : (kEitherDagger ? 0.5f : 1.0f);
+        
+        // Time-to-collision imminence only for longer weapons
+        static constexpr bool kFastApproach = !kBothDaggers;
+        
+        // Only mace heads and axe bits make the convex shape differ from the blade segment
+        static constexpr bool kConvexShapes = Left == WeaponType::Mace || Left == WeaponType::Axe ||
+            Right == WeaponType::Mace || Right == WeaponType::Axe;
+    };
+
+    void WeaponGeometryTracker::SelectCollisionKernel(WeaponType leftType, WeaponType rightType)
+    {
+#define FALSEEDGE_KERNEL_ROW(L) { \
+            &WeaponGeometryTracker::CheckBladeCollisionKernel<L, WeaponType::None>, \
+            &WeaponGeometryTracker::CheckBladeCollisionKernel<L, WeaponType::Sword>, \
+            &WeaponGeometryTracker::CheckBladeCollisionKernel<L, WeaponType::Dagger>, \
+            &WeaponGeometryTracker::CheckBladeCollisionKernel<L, WeaponType::Mace>, \
+            &WeaponGeometryTracker::CheckBladeCollisionKernel<L, WeaponType::Axe> }
+        
+        // Indexed by WeaponType (None..Axe) - blades are never shields
+        static const CollisionKernel kKernels[5][5] = {
+            FALSEEDGE_KERNEL_ROW(WeaponType::None),
+            FALSEEDGE_KERNEL_ROW(WeaponType::Sword),
+            FALSEEDGE_KERNEL_ROW(WeaponType::Dagger),
+            FALSEEDGE_KERNEL_ROW(WeaponType::Mace),
+            FALSEEDGE_KERNEL_ROW(WeaponType::Axe)
+        };
+#undef FALSEEDGE_KERNEL_ROW
+        
+        int left = (int)leftType <= (int)WeaponType::Axe ? (int)leftType : 0;
+        int right = (int)rightType <= (int)WeaponType::Axe ? (int)rightType : 0;
+        m_collisionKernel = kKernels[left][right];
+        m_kernelTypes[0] = leftType;
+        m_kernelTypes[1] = rightType;
+        m_kernelCallCount = 0;
+        m_kernelNs = 0.0;
+        
+        _MESSAGE("WeaponGeometry: Collision kernel %s vs %s",
+            EquipManager::GetWeaponTypeName(leftType), EquipManager::GetWeaponTypeName(rightType));
+    }
+
+    void WeaponGeometryTracker::ResetGrindState(BladeCollisionResult& outResult)
+    {
+        m_grindDuration = 0.0f;
+        m_bladesGrinding = false;
+        outResult.isGrinding = false;
+        // Keep the last contact's values for the end-of-contact logs
+        m_contactManifold.active = false;
+    }
+
+    void WeaponGeometryTracker::UpdateContactManifold(const BladeCollisionResult& result, const NiPoint3& normal, const NiPoint3& relativeVelocity)
+    {
+        // Slide speeds come from per-frame parameter deltas, which jitter with the segment solve
+        const float SLIDE_SMOOTHING = 0.5f;
+
+        const BladeGeometry& left = m_geometryState.leftHand;
+        const BladeGeometry& right = m_geometryState.rightHand;
+        BladeContactManifold& contact = m_contactManifold;
+
+        if (!contact.active)
+        {
+            contact.Clear();
+            contact.active = true;
+            contact.startTime = m_lastUpdateTime;
+        }
+        else
+        {
+            float leftDelta = (result.leftBladeParameter - contact.leftParameter) * left.bladeLength;
+            float rightDelta = (result.rightBladeParameter - contact.rightParameter) * right.bladeLength;
+            contact.leftTravel += fabs(leftDelta);
+            contact.rightTravel += fabs(rightDelta);
+
+            float dt = m_lastUpdateTime - contact.lastUpdateTime;
+            if (dt > 0.0001f)
+            {
+                contact.leftSlideSpeed += (leftDelta / dt - contact.leftSlideSpeed) * SLIDE_SMOOTHING;
+                contact.rightSlideSpeed += (rightDelta / dt - contact.rightSlideSpeed) * SLIDE_SMOOTHING;
+            }
+        }
+
+        contact.leftParameter = result.leftBladeParameter;
+        contact.rightParameter = result.rightBladeParameter;
+        contact.point = result.collisionPoint;
+
+        // Overlapping segments have no separation direction - keep the last normal
+        if (Length(normal) > 0.5f)
+            contact.normal = normal;
+
+        contact.leftAxis = Normalize(NiPoint3(left.tipPosition.x - left.basePosition.x,
+            left.tipPosition.y - left.basePosition.y, left.tipPosition.z - left.basePosition.z));
+        contact.rightAxis = Normalize(NiPoint3(right.tipPosition.x - right.basePosition.x,
+            right.tipPosition.y - right.basePosition.y, right.tipPosition.z - right.basePosition.z));
+        contact.crossingAngle = acos(Clamp(Dot(contact.leftAxis, contact.rightAxis), -1.0f, 1.0f)) * (180.0f / 3.14159f);
+
+        contact.relativeSpeed = result.relativeVelocity;
+        contact.normalSpeed = -Dot(relativeVelocity, contact.normal);
+        contact.duration = m_lastUpdateTime - contact.startTime;
+        contact.lastUpdateTime = m_lastUpdateTime;
+        contact.frames++;
+    }
+
     bool WeaponGeometryTracker::CheckBladeCollision(BladeCollisionResult& outResult)
     {
       outResult.Clear();
         
         if (!m_geometryState.leftHand.isValid || !m_geometryState.rightHand.isValid)
+        {
+            m_contactManifold.active = false;
             return false;
+        }
+        
+        WeaponType leftType = m_geometryState.leftHand.weaponType;
+        WeaponType rightType = m_geometryState.rightHand.weaponType;
+        if (!m_collisionKernel || leftType != m_kernelTypes[0] || rightType != m_kernelTypes[1])
+            SelectCollisionKernel(leftType, rightType);
+        
+        std::chrono::high_resolution_clock::time_point kernelStart;
+        if (collisionProfiling)
+            kernelStart = std::chrono::high_resolution_clock::now();
+        bool detected = (this->*m_collisionKernel)(outResult);
+        if (collisionProfiling)
+            m_kernelNs += std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - kernelStart).count();
+        
+        // Kernel cost and tier rates every 900 checks (~10s at 90Hz)
+        if (++m_kernelCallCount >= 900)
+        {
+            if (collisionProfiling)
+            {
+                _MESSAGE("WeaponGeometry: Kernel %s vs %s - avg %.0fns over %d checks",
+                    EquipManager::GetWeaponTypeName(m_kernelTypes[0]), EquipManager::GetWeaponTypeName(m_kernelTypes[1]),
+                    m_kernelNs / m_kernelCallCount, m_kernelCallCount);
+            }
+            else
+            {
+                _MESSAGE("WeaponGeometry: Kernel %s vs %s - %d checks",
+                    EquipManager::GetWeaponTypeName(m_kernelTypes[0]), EquipManager::GetWeaponTypeName(m_kernelTypes[1]),
+                    m_kernelCallCount);
+            }
+            _MESSAGE("WeaponGeometry:   Tiers - %d sphere rejects (%.0f%%), %d segment rejects (%.0f%%), %d detailed",
+                m_tierSphereRejects, 100.0f * m_tierSphereRejects / m_kernelCallCount,
+                m_tierSegmentRejects, 100.0f * m_tierSegmentRejects / m_kernelCallCount, m_tierDetailedChecks);
+            m_kernelCallCount = 0;
+            m_kernelNs = 0.0;
+            m_tierSphereRejects = 0;
+            m_tierSegmentRejects = 0;
+            m_tierDetailedChecks = 0;
+        }
+        
+        return detected;
+    }
+
+    template <WeaponType Left, WeaponType Right>
+    bool WeaponGeometryTracker::CheckBladeCollisionKernel(BladeCollisionResult& outResult)
+    {
+        typedef CollisionKernelPolicy<Left, Right> Policy;
         
    const BladeGeometry& leftBlade = m_geometryState.leftHand;
 const BladeGeometry& rightBlade = m_geometryState.rightHand;
@@ -812,13 +1340,195 @@ const BladeGeometry& rightBlade = m_geometryState.rightHand;
    const NiPoint3& rightBase = rightBlade.basePosition;
 const NiPoint3& rightTip = rightBlade.tipPosition;
     
+        // ============================================
+        // THRESHOLD SCALING - fixed per weapon type pair (CollisionKernelPolicy)
+        // ============================================
+        const float scaleFactor = Policy::kThresholdScale;
+        
+        float scaledCollisionThreshold = m_collisionThreshold * scaleFactor;
+        float scaledImminentThreshold = m_imminentThreshold * scaleFactor;
+  float scaledBackupThreshold = bladeImminentThresholdBackup * scaleFactor;
+        
+        // ============================================
+        // TIER 0 - BOUNDING SPHERES
+        // Each blade fits in a sphere around its midpoint; farther apart than
+        // the widest threshold (plus room for heads, ray capsules and the real
+        // meshes) means nothing below can report contact or imminence
+        // ============================================
+        float reachRange = scaledCollisionThreshold;
+        if (scaledImminentThreshold > reachRange) reachRange = scaledImminentThreshold;
+        if (scaledBackupThreshold > reachRange) reachRange = scaledBackupThreshold;
+        reachRange += TIER_REACH_MARGIN;
+        
+        auto sphereGap = [](const NiPoint3& baseA, const NiPoint3& tipA, const NiPoint3& baseB, const NiPoint3& tipB) {
+            NiPoint3 centerA = PointAlongSegment(baseA, tipA, 0.5f);
+            NiPoint3 centerB = PointAlongSegment(baseB, tipB, 0.5f);
+            NiPoint3 between(centerB.x - centerA.x, centerB.y - centerA.y, centerB.z - centerA.z);
+            NiPoint3 halfA(tipA.x - centerA.x, tipA.y - centerA.y, tipA.z - centerA.z);
+            NiPoint3 halfB(tipB.x - centerB.x, tipB.y - centerB.y, tipB.z - centerB.z);
+            return Length(between) - Length(halfA) - Length(halfB);
+        };
+        bool hasPrediction = leftBlade.hasPrediction && rightBlade.hasPrediction;
+        float sphereDistance = sphereGap(leftBase, leftTip, rightBase, rightTip);
+        if (hasPrediction)
+        {
+            float predictedGap = sphereGap(leftBlade.predictedBasePosition, leftBlade.predictedTipPosition,
+                rightBlade.predictedBasePosition, rightBlade.predictedTipPosition);
+            if (predictedGap < sphereDistance)
+                sphereDistance = predictedGap;
+        }
+        if (sphereDistance > reachRange)
+        {
+            m_tierSphereRejects++;
+            outResult.closestDistance = sphereDistance;
+            ResetGrindState(outResult);
+            ThresholdCalibration::GetSingleton()->ObserveApart();
+            return false;
+        }
+        
+      // ============================================
+        // ALSO CALCULATE SEGMENT DISTANCE (as backup/comparison)
+        // ============================================
+     float leftParam, rightParam;
+   NiPoint3 closestLeft, closestRight;
+      
+        std::chrono::high_resolution_clock::time_point segmentStart, segmentEnd;
+        if (collisionProfiling)
+            segmentStart = std::chrono::high_resolution_clock::now();
+        float segmentDistance = ClosestDistanceBetweenSegments(
+      leftBase, leftTip,
+   rightBase, rightTip,
+  leftParam, rightParam,
+            closestLeft, closestRight
+        );
+        if (collisionProfiling)
+            segmentEnd = std::chrono::high_resolution_clock::now();
+        
+        // ============================================
+        // CONVEX SHAPES
+        // Mace heads and axe bits reach past the blade line - take the shape distance when it's closer
+        // ============================================
+        if (Policy::kConvexShapes && bladeConvexShapes)
+        {
+            BuildWeaponShape(leftBlade.weaponType, leftBase, leftTip, leftBlade.edgeAxis, m_weaponShapes[0]);
+            BuildWeaponShape(rightBlade.weaponType, rightBase, rightTip, rightBlade.edgeAxis, m_weaponShapes[1]);
+            GjkResult shapeResult = CompoundDistance(m_weaponShapes[0], m_weaponShapes[1], m_gjkCaches);
+            
+            m_shapeTestCount++;
+            if (collisionProfiling)
+            {
+                auto shapeEnd = std::chrono::high_resolution_clock::now();
+                m_segmentTestUs += std::chrono::duration<double, std::micro>(segmentEnd - segmentStart).count();
+                m_shapeTestUs += std::chrono::duration<double, std::micro>(shapeEnd - segmentEnd).count();
+            }
+            m_gjkIterations += shapeResult.iterations;
+            
+            if (shapeResult.distance < segmentDistance - 0.01f)
+            {
+                m_shapeCloserCount++;
+                m_shapeCloserSum += segmentDistance - shapeResult.distance;
+                
+                segmentDistance = shapeResult.distance;
+                if (!shapeResult.overlapping)
+                {
+                    closestLeft = shapeResult.pointA;
+                    closestRight = shapeResult.pointB;
+                    
+                    // Where along each blade the contact sits, for the velocity blend below
+                    leftParam = SegmentParameter(leftBase, leftTip, closestLeft);
+                    rightParam = SegmentParameter(rightBase, rightTip, closestRight);
+                }
+            }
+            
+            // Cost/accuracy stats every 900 tests (~10s at 90Hz)
+            if (m_shapeTestCount >= 900)
+            {
+                if (collisionProfiling)
+                {
+                    _MESSAGE("WeaponGeometry: Shape test - segment avg %.2fus, convex avg %.2fus (%.1fx), %.2f GJK iterations/test",
+                        m_segmentTestUs / m_shapeTestCount, m_shapeTestUs / m_shapeTestCount,
+                        m_segmentTestUs > 0.0 ? m_shapeTestUs / m_segmentTestUs : 0.0, (float)m_gjkIterations / m_shapeTestCount);
+                }
+                else
+                {
+                    _MESSAGE("WeaponGeometry: Shape test - %.2f GJK iterations/test", (float)m_gjkIterations / m_shapeTestCount);
+                }
+                _MESSAGE("WeaponGeometry:   Convex closer than segment in %d/%d tests (avg %.1f units) - %s vs %s",
+                    m_shapeCloserCount, m_shapeTestCount, m_shapeCloserCount > 0 ? m_shapeCloserSum / m_shapeCloserCount : 0.0f,
+                    EquipManager::GetWeaponTypeName(leftBlade.weaponType), EquipManager::GetWeaponTypeName(rightBlade.weaponType));
+                m_shapeTestCount = 0;
+                m_segmentTestUs = 0.0;
+                m_shapeTestUs = 0.0;
+                m_gjkIterations = 0;
+                m_shapeCloserCount = 0;
+                m_shapeCloserSum = 0.0f;
+            }
+        }
+
+        // ============================================
+        // PREDICTED DISTANCE
+        // Imminent detection also runs against where the blades will be once the swap completes
+        // ============================================
+        float imminentDistance = segmentDistance;
+        if (hasPrediction)
+        {
+            float predLeftParam, predRightParam;
+            NiPoint3 predClosestLeft, predClosestRight;
+            float predictedDistance = ClosestDistanceBetweenSegments(
+                leftBlade.predictedBasePosition, leftBlade.predictedTipPosition,
+                rightBlade.predictedBasePosition, rightBlade.predictedTipPosition,
+                predLeftParam, predRightParam,
+                predClosestLeft, predClosestRight
+            );
+            if (predictedDistance < imminentDistance)
+                imminentDistance = predictedDistance;
+        }
+        
+        // ============================================
+        // TIER 1 - SEGMENT / SHAPE DISTANCE
+        // Still out of reach once the real closest points are known - skip the
+        // raycasts, mesh and velocity work
+        // ============================================
+        if (segmentDistance > reachRange && imminentDistance > reachRange)
+        {
+            m_tierSegmentRejects++;
+            outResult.closestDistance = segmentDistance;
+            outResult.leftBladeParameter = leftParam;
+            outResult.rightBladeParameter = rightParam;
+            outResult.leftBladeContactPoint = closestLeft;
+            outResult.rightBladeContactPoint = closestRight;
+            ResetGrindState(outResult);
+            ThresholdCalibration::GetSingleton()->ObserveApart();
+            return false;
+        }
+        
+        // ============================================
+        // TIER 2 - DETAILED CONTACT
+        // ============================================
+        m_tierDetailedChecks++;
+        
    // ============================================
         // RAYCASTING COLLISION DETECTION
-        // Cast rays along both blades to detect intersection
+        // Cast rays along both blades to detect intersection - more of them when the
+        // blades are close or moving fast, packed around the closest points
         // ============================================
       
-        BladeRaycastHit leftHits[RAYCAST_SAMPLES];
-        BladeRaycastHit rightHits[RAYCAST_SAMPLES];
+        BladeRaycastHit leftHits[RAYCAST_MAX_SAMPLES];
+        BladeRaycastHit rightHits[RAYCAST_MAX_SAMPLES];
+        float leftRayParams[RAYCAST_MAX_SAMPLES];
+        float rightRayParams[RAYCAST_MAX_SAMPLES];
+        
+        // Contact-point speed from the segment result (the full velocity pass comes later)
+        NiPoint3 rayRelVel(
+            (leftBlade.baseVelocity.x + leftParam * (leftBlade.tipVelocity.x - leftBlade.baseVelocity.x)) -
+            (rightBlade.baseVelocity.x + rightParam * (rightBlade.tipVelocity.x - rightBlade.baseVelocity.x)),
+            (leftBlade.baseVelocity.y + leftParam * (leftBlade.tipVelocity.y - leftBlade.baseVelocity.y)) -
+            (rightBlade.baseVelocity.y + rightParam * (rightBlade.tipVelocity.y - rightBlade.baseVelocity.y)),
+            (leftBlade.baseVelocity.z + leftParam * (leftBlade.tipVelocity.z - leftBlade.baseVelocity.z)) -
+            (rightBlade.baseVelocity.z + rightParam * (rightBlade.tipVelocity.z - rightBlade.baseVelocity.z)));
+        float longerBlade = leftBlade.bladeLength > rightBlade.bladeLength ? leftBlade.bladeLength : rightBlade.bladeLength;
+        int raySamples = ChooseRaySamples(segmentDistance, Length(rayRelVel), longerBlade, reachRange,
+            leftParam, rightParam, leftRayParams, rightRayParams);
    
         // Calculate blade radii based on blade length (daggers are thinner)
   float leftRadius = BLADE_RADIUS * (leftBlade.bladeLength / 70.0f);
@@ -827,27 +1537,85 @@ const NiPoint3& rightTip = rightBlade.tipPosition;
         if (avgRadius < 1.0f) avgRadius = 1.0f;  // Minimum radius
      if (avgRadius > 3.0f) avgRadius = 3.0f;  // Maximum radius
     
+        std::chrono::high_resolution_clock::time_point rayStart;
+        if (collisionProfiling)
+            rayStart = std::chrono::high_resolution_clock::now();
+        
         // Cast rays from left blade toward right blade
-        int leftHitCount = RaycastBladeIntersection(leftBlade, rightBlade, avgRadius, leftHits, RAYCAST_SAMPLES);
+        int leftHitCount = RaycastBladeIntersection(leftBlade, rightBlade, avgRadius, leftRayParams, rightRayParams, raySamples, leftHits);
      
         // Cast rays from right blade toward left blade
-        int rightHitCount = RaycastBladeIntersection(rightBlade, leftBlade, avgRadius, rightHits, RAYCAST_SAMPLES);
+        int rightHitCount = RaycastBladeIntersection(rightBlade, leftBlade, avgRadius, rightRayParams, leftRayParams, raySamples, rightHits);
         
         int totalHitCount = leftHitCount + rightHitCount;
         outResult.raycastHitCount = totalHitCount;
         
-      // ============================================
-        // ALSO CALCULATE SEGMENT DISTANCE (as backup/comparison)
+        if (collisionProfiling)
+            m_rayAdaptiveNs += std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - rayStart).count();
+        m_raySampleTotal += raySamples;
+        m_rayCheckCount++;
+        
+        // With [General] Profiling, every 8th check also runs the old fixed scheme (evenly spaced, same t on both blades)
+        if (collisionProfiling && m_rayCheckCount % 8 == 0)
+        {
+            float fixedParams[RAYCAST_FIXED_SAMPLES];
+            for (int i = 0; i < RAYCAST_FIXED_SAMPLES; i++)
+                fixedParams[i] = (float)i / (float)(RAYCAST_FIXED_SAMPLES - 1);
+            BladeRaycastHit fixedHits[RAYCAST_FIXED_SAMPLES];
+            
+            auto fixedStart = std::chrono::high_resolution_clock::now();
+            int fixedHitCount = RaycastBladeIntersection(leftBlade, rightBlade, avgRadius, fixedParams, fixedParams, RAYCAST_FIXED_SAMPLES, fixedHits) +
+                RaycastBladeIntersection(rightBlade, leftBlade, avgRadius, fixedParams, fixedParams, RAYCAST_FIXED_SAMPLES, fixedHits);
+            m_rayFixedNs += std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - fixedStart).count();
+            
+            m_rayCompareCount++;
+            if ((fixedHitCount >= 2) == (totalHitCount >= 2))
+                m_rayAgreeCount++;
+        }
+        
+        if (m_rayCheckCount >= 900)
+        {
+            if (collisionProfiling)
+            {
+                _MESSAGE("WeaponGeometry: Rays - avg %.1f per blade, adaptive avg %.0fns vs fixed %d avg %.0fns, same verdict in %d/%d compared checks",
+                    (float)m_raySampleTotal / m_rayCheckCount, m_rayAdaptiveNs / m_rayCheckCount, RAYCAST_FIXED_SAMPLES,
+                    m_rayCompareCount > 0 ? m_rayFixedNs / m_rayCompareCount : 0.0, m_rayAgreeCount, m_rayCompareCount);
+            }
+            else
+            {
+                _MESSAGE("WeaponGeometry: Rays - avg %.1f per blade", (float)m_raySampleTotal / m_rayCheckCount);
+            }
+            m_rayCheckCount = 0;
+            m_raySampleTotal = 0;
+            m_rayCompareCount = 0;
+            m_rayAgreeCount = 0;
+            m_rayAdaptiveNs = 0.0;
+            m_rayFixedNs = 0.0;
+        }
+        
         // ============================================
-     float leftParam, rightParam;
-   NiPoint3 closestLeft, closestRight;
-      
-        float segmentDistance = ClosestDistanceBetweenSegments(
-      leftBase, leftTip,
-   rightBase, rightTip,
-  leftParam, rightParam,
-            closestLeft, closestRight
-        );
+        // MESH NARROWPHASE
+        // Close enough to matter - measure the real triangle meshes instead of the blade lines
+        // (crossguards no longer count as blade, curved blades are where they really are)
+        // ============================================
+        bool meshDistance = false;
+        if (bladeMeshNarrowphase && segmentDistance < scaledImminentThreshold && leftBlade.formID != 0 && rightBlade.formID != 0)
+        {
+            MeshContact contact;
+            if (MeshNarrowphase::GetSingleton()->Query(leftBlade.formID, leftBlade.nodeTransform,
+                rightBlade.formID, rightBlade.nodeTransform, scaledImminentThreshold, contact))
+            {
+                meshDistance = true;
+                segmentDistance = contact.distance;
+                if (contact.inRange)
+                {
+                    closestLeft = contact.pointA;
+                    closestRight = contact.pointB;
+                    leftParam = SegmentParameter(leftBase, leftTip, closestLeft);
+                    rightParam = SegmentParameter(rightBase, rightTip, closestRight);
+                }
+            }
+        }
 
         outResult.closestDistance = segmentDistance;
         outResult.leftBladeParameter = leftParam;
@@ -859,8 +1627,8 @@ const NiPoint3& rightTip = rightBlade.tipPosition;
         outResult.collisionPoint.y = (closestLeft.y + closestRight.y) * 0.5f;
         outResult.collisionPoint.z = (closestLeft.z + closestRight.z) * 0.5f;
         
- // If raycast detected hits, use the closest hit point
-        if (totalHitCount > 0)
+ // If raycast detected hits, use the closest hit point (the mesh distance already beats the ray capsules)
+        if (totalHitCount > 0 && !meshDistance)
       {
   // Find the closest hit among all rays
    float closestHitDist = FLT_MAX;
@@ -890,33 +1658,6 @@ if (rightHits[i].hit && rightHits[i].hitDistance < closestHitDist)
        }
         }
      
-        // ============================================
-        // DYNAMIC THRESHOLD SCALING based on blade length
-        // ============================================
-        const float DAGGER_MAX_BLADE_LENGTH = 55.0f;
-        
- float leftBladeLen = leftBlade.bladeLength;
-        float rightBladeLen = rightBlade.bladeLength;
-        
-        bool leftIsDagger = (leftBladeLen > 0.1f && leftBladeLen <= DAGGER_MAX_BLADE_LENGTH);
-        bool rightIsDagger = (rightBladeLen > 0.1f && rightBladeLen <= DAGGER_MAX_BLADE_LENGTH);
-        bool bothDaggers = leftIsDagger && rightIsDagger;
-        bool eitherDagger = leftIsDagger || rightIsDagger;
-     
-        float scaleFactor = 1.0f;
-        if (bothDaggers)
-        {
-            scaleFactor = 0.25f;
-        }
-        else if (eitherDagger)
-        {
-       scaleFactor = 0.5f;
-    }
-        
-        float scaledCollisionThreshold = m_collisionThreshold * scaleFactor;
-        float scaledImminentThreshold = m_imminentThreshold * scaleFactor;
-  float scaledBackupThreshold = bladeImminentThresholdBackup * scaleFactor;
-        
         // ============================================
         // VELOCITY CALCULATIONS
         // ============================================
@@ -983,20 +1724,12 @@ NiPoint3 leftVel, rightVel;
  
         if (outResult.isColliding)
         {
-       // Update grind duration
-            if (!m_wasInContact)
-          {
-    // Just started contact
-   m_grindStartTime = m_lastUpdateTime;
-              m_grindDuration = 0.0f;
-            }
-            else
-  {
-        m_grindDuration = m_lastUpdateTime - m_grindStartTime;
-            }
+            // Contact duration and speeds come from the manifold, carried over from last frame
+            UpdateContactManifold(outResult, separationDir, relVel);
+            m_grindDuration = m_contactManifold.duration;
    
          // Check if this is grinding vs impact
-        bool lowVelocity = (outResult.relativeVelocity < GRIND_VELOCITY_THRESHOLD);
+        bool lowVelocity = (m_contactManifold.relativeSpeed < GRIND_VELOCITY_THRESHOLD);
      bool sustainedContact = (m_grindDuration >= GRIND_MIN_DURATION);
   
          outResult.isGrinding = lowVelocity && sustainedContact;
@@ -1005,9 +1738,7 @@ NiPoint3 leftVel, rightVel;
         }
         else
         {
-            m_grindDuration = 0.0f;
-            m_bladesGrinding = false;
-            outResult.isGrinding = false;
+            ResetGrindState(outResult);
         }
         
         // ============================================
@@ -1016,16 +1747,16 @@ NiPoint3 leftVel, rightVel;
  // ============================================
      const float MIN_CLOSING_VELOCITY = 50.0f;
         
-      bool withinPrimaryThreshold = (segmentDistance <= scaledImminentThreshold) && (closingVelocity >= MIN_CLOSING_VELOCITY);
-        bool withinBackupThreshold = (segmentDistance <= scaledBackupThreshold) && (closingVelocity >= MIN_CLOSING_VELOCITY);
+      bool withinPrimaryThreshold = (imminentDistance <= scaledImminentThreshold) && (closingVelocity >= MIN_CLOSING_VELOCITY);
+        bool withinBackupThreshold = (imminentDistance <= scaledBackupThreshold) && (closingVelocity >= MIN_CLOSING_VELOCITY);
         
         // Fast approach only for longer weapons
         bool fastApproaching = false;
-   if (!bothDaggers)
+   if (Policy::kFastApproach)
         {
      fastApproaching = (outResult.timeToCollision > 0.0f) && 
              (outResult.timeToCollision < bladeTimeToCollisionThreshold) &&
-                (segmentDistance <= scaledBackupThreshold);
+                (imminentDistance <= scaledBackupThreshold);
         }
       
         // IMPORTANT: Don't mark as imminent if we're already grinding
@@ -1038,8 +1769,8 @@ NiPoint3 leftVel, rightVel;
         logCounter++;
         if (logCounter % 300 == 1)
         {
-_MESSAGE("WeaponGeometry: Raycast hits: L=%d, R=%d, Total=%d, SegDist=%.2f",
-   leftHitCount, rightHitCount, totalHitCount, segmentDistance);
+_MESSAGE("WeaponGeometry: Raycast hits: L=%d, R=%d, Total=%d, SegDist=%.2f, ImminentDist=%.2f",
+   leftHitCount, rightHitCount, totalHitCount, segmentDistance, imminentDistance);
             if (m_bladesGrinding)
             {
      _MESSAGE("WeaponGeometry: GRINDING detected (duration: %.2fs, velocity: %.1f)",
@@ -1052,6 +1783,11 @@ _MESSAGE("WeaponGeometry: Raycast hits: L=%d, R=%d, Total=%d, SegDist=%.2f",
   _MESSAGE("WeaponGeometry: IMMINENT - dist=%.2f, rayHits=%d, closing=%.1f, grinding=%s",
       segmentDistance, totalHitCount, closingVelocity, m_bladesGrinding ? "YES" : "NO");
       }
+        
+        // Auto-calibration works in unscaled (sword) units. It counts geometric contact only -
+        // isColliding also takes ray hits, which the thresholds being learned don't control
+        ThresholdCalibration::GetSingleton()->Observe(m_lastUpdateTime, imminentDistance / scaleFactor,
+            closingVelocity / scaleFactor, segmentCollision, outResult.isImminent);
   
         return outResult.isColliding || outResult.isImminent;
     }
@@ -1064,23 +1800,24 @@ _MESSAGE("WeaponGeometry: Raycast hits: L=%d, R=%d, Total=%d, SegDist=%.2f",
         const BladeGeometry& sourceBlade,
         const BladeGeometry& targetBlade,
         float bladeRadius,
-  BladeRaycastHit* outHits,
-        int maxHits)
+        const float* sourceParams,
+        const float* targetParams,
+        int sampleCount,
+  BladeRaycastHit* outHits)
     {
   int hitCount = 0;
         
         // Cast rays at multiple points along the source blade
-      for (int i = 0; i < RAYCAST_SAMPLES && hitCount < maxHits; i++)
+      for (int i = 0; i < sampleCount; i++)
     {
             // Parameter along the blade (0 = base, 1 = tip)
-    float t = (float)i / (float)(RAYCAST_SAMPLES - 1);
+    float t = sourceParams[i];
   
             // Calculate ray origin point on source blade
             NiPoint3 rayOrigin = PointAlongSegment(sourceBlade.basePosition, sourceBlade.tipPosition, t);
      
-        // Calculate direction toward the closest point on target blade
-            // First find the closest point on target blade to this ray origin
-            NiPoint3 targetPoint = PointAlongSegment(targetBlade.basePosition, targetBlade.tipPosition, t);
+        // Aim at the matching point on the target blade
+            NiPoint3 targetPoint = PointAlongSegment(targetBlade.basePosition, targetBlade.tipPosition, targetParams[i]);
        
             NiPoint3 rayDir;
           rayDir.x = targetPoint.x - rayOrigin.x;
@@ -1095,7 +1832,7 @@ _MESSAGE("WeaponGeometry: Raycast hits: L=%d, R=%d, Total=%d, SegDist=%.2f",
   outHits[hitCount].hitPoint = rayOrigin;
           outHits[hitCount].hitDistance = 0.0f;
     outHits[hitCount].rayParameter = t;
-         outHits[hitCount].bladeParameter = t;
+         outHits[hitCount].bladeParameter = targetParams[i];
  hitCount++;
                 continue;
             }
@@ -1115,6 +1852,40 @@ _MESSAGE("WeaponGeometry: Raycast hits: L=%d, R=%d, Total=%d, SegDist=%.2f",
         return hitCount;
     }
     
+    int WeaponGeometryTracker::ChooseRaySamples(float distance, float relativeSpeed, float bladeLength, float reachRange,
+        float leftCenter, float rightCenter, float* outLeftParams, float* outRightParams)
+    {
+        const float RAY_FAST_SPEED = 400.0f;    // Relative speed (units/s) that gets the full density
+        
+        // Density: closer and faster both add rays; longer blades spread them over more length
+        float proximity = 1.0f - Clamp(distance / (reachRange > 0.001f ? reachRange : 0.001f), 0.0f, 1.0f);
+        float speed = Clamp(relativeSpeed / RAY_FAST_SPEED, 0.0f, 1.0f);
+        float lengthScale = Clamp(bladeLength / 70.0f, 0.5f, 1.5f);
+        float density = Clamp(0.2f + 0.5f * proximity + 0.5f * speed, 0.0f, 1.0f) * lengthScale;
+        
+        int count = RAYCAST_MIN_SAMPLES + (int)(density * (RAYCAST_MAX_SAMPLES - RAYCAST_MIN_SAMPLES) + 0.5f);
+        if (count > RAYCAST_MAX_SAMPLES) count = RAYCAST_MAX_SAMPLES;
+        
+        // Close contact packs the rays around the closest points; far away they stay evenly spread
+        float focus = 0.8f * proximity;
+        for (int i = 0; i < count; i++)
+        {
+            float u = (float)i / (float)(count - 1);
+            outLeftParams[i] = FocusedRayParameter(u, leftCenter, focus);
+            outRightParams[i] = FocusedRayParameter(u, rightCenter, focus);
+        }
+        return count;
+    }
+    
+    float WeaponGeometryTracker::FocusedRayParameter(float u, float center, float focus)
+    {
+        // Quadratic around center: stays in 0-1, monotonic, spacing shrinks toward center
+        float offset = u - center;
+        float span = center > 1.0f - center ? center : 1.0f - center;
+        float focused = center + offset * fabs(offset) / (span > 0.001f ? span : 0.001f);
+        return u + focus * (focused - u);
+    }
+    
     bool WeaponGeometryTracker::RaycastTowardBlade(
     const NiPoint3& rayOrigin,
         const NiPoint3& rayDirection,
@@ -1434,50 +2205,31 @@ r.z = p1.z - p2.z;
         return result;
     }
 
-    void WeaponGeometryTracker::CheckXPose(const BladeGeometry& leftBlade, const BladeGeometry& rightBlade)
+    float WeaponGeometryTracker::SegmentParameter(const NiPoint3& start, const NiPoint3& end, const NiPoint3& point)
+    {
+        NiPoint3 axis(end.x - start.x, end.y - start.y, end.z - start.z);
+        NiPoint3 offset(point.x - start.x, point.y - start.y, point.z - start.z);
+        float lengthSq = Dot(axis, axis);
+        return lengthSq > 0.0001f ? Clamp(Dot(offset, axis) / lengthSq, 0.0f, 1.0f) : 0.0f;
+    }
+
+    void WeaponGeometryTracker::CheckXPose(const BladeContactManifold& contact)
     {
         m_wasInXPose = m_inXPose;
         
-        if (!leftBlade.isValid || !rightBlade.isValid)
+        // Blade axes and crossing angle come from this frame's contact manifold
+        if (!contact.active)
    {
             m_inXPose = false;
           if (m_wasInXPose)
             {
-  _MESSAGE("WeaponGeometry: *** X-POSE ENDED *** (blade geometry invalid)");
+  _MESSAGE("WeaponGeometry: *** X-POSE ENDED *** (no blade contact)");
  }
   return;
   }
 
-        NiPoint3 leftDir;
-        leftDir.x = leftBlade.tipPosition.x - leftBlade.basePosition.x;
-    leftDir.y = leftBlade.tipPosition.y - leftBlade.basePosition.y;
-        leftDir.z = leftBlade.tipPosition.z - leftBlade.basePosition.z;
-
-   NiPoint3 rightDir;
-        rightDir.x = rightBlade.tipPosition.x - rightBlade.basePosition.x;
-        rightDir.y = rightBlade.tipPosition.y - rightBlade.basePosition.y;
- rightDir.z = rightBlade.tipPosition.z - rightBlade.basePosition.z;
-
-        float leftLen = sqrt(leftDir.x * leftDir.x + leftDir.y * leftDir.y + leftDir.z * leftDir.z);
-        float rightLen = sqrt(rightDir.x * rightDir.x + rightDir.y * rightDir.y + rightDir.z * rightDir.z);
-
-      if (leftLen < 0.001f || rightLen < 0.001f)
-{
-            m_inXPose = false;
-       if (m_wasInXPose)
- {
-     _MESSAGE("WeaponGeometry: *** X-POSE ENDED *** (blade length too short)");
-            }
-            return;
-        }
-
-        leftDir.x /= leftLen;
-        leftDir.y /= leftLen;
-     leftDir.z /= leftLen;
-
-        rightDir.x /= rightLen;
-     rightDir.y /= rightLen;
-        rightDir.z /= rightLen;
+        const NiPoint3& leftDir = contact.leftAxis;
+        const NiPoint3& rightDir = contact.rightAxis;
 
         PlayerCharacter* player = *g_thePlayer;
         if (!player)
@@ -1496,8 +2248,7 @@ r.z = p1.z - p2.z;
         playerForward.y = cos(heading);
       playerForward.z = 0.0f;
 
-        float bladeDot = leftDir.x * rightDir.x + leftDir.y * rightDir.y + leftDir.z * rightDir.z;
-        float bladeAngle = acos(Clamp(bladeDot, -1.0f, 1.0f)) * (180.0f / 3.14159f);
+        float bladeAngle = contact.crossingAngle;
  float leftForwardDot = leftDir.x * playerForward.x + leftDir.y * playerForward.y;
         float rightForwardDot = rightDir.x * playerForward.x + rightDir.y * playerForward.y;
 
@@ -1530,10 +2281,5 @@ r.z = p1.z - p2.z;
     {
         WeaponGeometryTracker::GetSingleton()->Initialize();
     }
-
-    void UpdateWeaponGeometry(float deltaTime)
-  {
-        WeaponGeometryTracker::GetSingleton()->Update(deltaTime);
-    }
 }
 
@@ -7,6 +7,8 @@
 #include "skse64/GameObjects.h"
 #include "config.h"
 #include "EquipManager.h"
+#include "ConvexShapes.h"
+#include "CollisionWorld.h"
 
 namespace FalseEdgeVR
 {
@@ -23,6 +25,19 @@ namespace FalseEdgeVR
       // Previous frame positions for velocity calculation
   NiPoint3 prevTipPosition;
         NiPoint3 prevBasePosition;
+        
+        // Blade pose predicted from the OpenVR controller (INI: [BladeCollision] PredictionTime)
+        NiPoint3 predictedTipPosition;
+        NiPoint3 predictedBasePosition;
+        bool hasPrediction;
+        
+        // Weapon node X axis (orients the per-type shape around the blade) and the weapon's type
+        NiPoint3 edgeAxis;
+        WeaponType weaponType;
+        
+        // Weapon form and node world transform - places the weapon's mesh for the narrowphase
+        UInt32 formID;
+        NiTransform nodeTransform;
 
      void Clear()
         {
@@ -32,6 +47,12 @@ namespace FalseEdgeVR
       baseVelocity = NiPoint3(0, 0, 0);
       prevTipPosition = NiPoint3(0, 0, 0);
  prevBasePosition = NiPoint3(0, 0, 0);
+            predictedTipPosition = NiPoint3(0, 0, 0);
+            predictedBasePosition = NiPoint3(0, 0, 0);
+            hasPrediction = false;
+            edgeAxis = NiPoint3(1, 0, 0);
+            weaponType = WeaponType::None;
+            formID = 0;
          bladeLength = 0.0f;
     isValid = false;
         }
@@ -42,6 +63,33 @@ namespace FalseEdgeVR
      }
     };
     
+    // Where blade tip/base velocities come from (INI: [BladeCollision] VelocitySource)
+    enum class BladeVelocitySource
+    {
+        FiniteDifference = 0,   // Position delta between frames
+        OpenVRController,       // Controller vVelocity/vAngularVelocity reported by OpenVR
+        HiggsRigidBody          // Linear/angular velocity of the HIGGS weapon or grabbed rigid body
+    };
+
+    // Rigid motion of a body in world space (game units): linear velocity at origin plus angular velocity
+    struct RigidBodyVelocity
+    {
+        NiPoint3 origin;            // Point the linear velocity is measured at
+        NiPoint3 linearVelocity;    // Units per second
+        NiPoint3 angularVelocity;   // Radians per second
+        
+        // Velocity of any point on the body: v + w x r
+        NiPoint3 PointVelocity(const NiPoint3& point) const
+        {
+            NiPoint3 r(point.x - origin.x, point.y - origin.y, point.z - origin.z);
+            return NiPoint3(
+                linearVelocity.x + angularVelocity.y * r.z - angularVelocity.z * r.y,
+                linearVelocity.y + angularVelocity.z * r.x - angularVelocity.x * r.z,
+                linearVelocity.z + angularVelocity.x * r.y - angularVelocity.y * r.x
+            );
+        }
+    };
+    
     // Raycast hit result for blade intersection
     struct BladeRaycastHit
     {
@@ -106,6 +154,58 @@ int raycastHitCount;            // Number of rays that detected collision
         }
     };
     
+    // Contact between the two blades, kept across frames while they stay touching.
+    // Updated in place from each colliding check - slide speeds are how fast the
+    // contact point travels along each blade (+ towards the tip).
+    struct BladeContactManifold
+    {
+        bool active;                // Blades touched on the last check
+        float leftParameter;        // Contact parameter (0-1) along each blade
+        float rightParameter;
+        NiPoint3 point;             // World contact point
+        NiPoint3 normal;            // Unit, left blade -> right blade
+        NiPoint3 leftAxis;          // Unit blade directions (base -> tip)
+        NiPoint3 rightAxis;
+        float crossingAngle;        // Degrees between the blade axes
+        float leftSlideSpeed;       // Units/s along the left blade, smoothed
+        float rightSlideSpeed;
+        float relativeSpeed;        // Relative velocity at the contact
+        float normalSpeed;          // Part of it along the normal (+ = separating)
+        float leftTravel;           // Distance the contact has slid along each blade
+        float rightTravel;
+        float startTime;
+        float lastUpdateTime;
+        float duration;             // Seconds of continuous contact
+        int frames;
+
+        void Clear()
+        {
+            active = false;
+            leftParameter = 0.0f;
+            rightParameter = 0.0f;
+            point = NiPoint3(0, 0, 0);
+            normal = NiPoint3(0, 0, 0);
+            leftAxis = NiPoint3(0, 0, 0);
+            rightAxis = NiPoint3(0, 0, 0);
+            crossingAngle = 0.0f;
+            leftSlideSpeed = 0.0f;
+            rightSlideSpeed = 0.0f;
+            relativeSpeed = 0.0f;
+            normalSpeed = 0.0f;
+            leftTravel = 0.0f;
+            rightTravel = 0.0f;
+            startTime = 0.0f;
+            lastUpdateTime = 0.0f;
+            duration = 0.0f;
+            frames = 0;
+        }
+
+        BladeContactManifold()
+        {
+            Clear();
+        }
+    };
+    
     // Weapon geometry data for both hands
     struct WeaponGeometryState
     {
@@ -128,8 +228,16 @@ int raycastHitCount;            // Number of rays that detected collision
      // Initialize the tracker
         void Initialize();
   
-        // Update weapon geometry - call this each frame
-    void Update(float deltaTime);
+        // Geometry phase of the CollisionWorld step - both blades from the hands it resolved
+    void UpdateGeometry(float deltaTime, const CollisionHand* hands);
+        
+        // Pair phase: blade-vs-blade check and its reactions (contact logs, X-pose, avoidance)
+        // False if the colliders aren't this step's left and right blades with usable geometry
+        bool ProcessBladePair(const Collider& bladeA, const Collider& bladeB, BladeCollisionResult& outResult);
+        
+        
+        // Forget blade positions and contact state (tracking went dormant - next update starts fresh)
+        void ResetGeometry();
         
       // Get current geometry state
         const WeaponGeometryState& GetGeometryState() const { return m_geometryState; }
@@ -142,6 +250,9 @@ int raycastHitCount;            // Number of rays that detected collision
         
    // Calculate blade tip position based on weapon type and reach
         NiPoint3 CalculateBladeTip(NiAVObject* weaponNode, TESObjectWEAP* weapon, bool isLeftHand);
+
+        // Measured mesh length when the weapon has a profile, otherwise estimated from reach (equipped and grabbed alike)
+        static float GetBladeLength(TESObjectWEAP* weapon, NiAVObject* weaponNode);
         
         // Calculate blade base position (handle/hilt)
    NiPoint3 CalculateBladeBase(NiAVObject* weaponNode, bool isLeftHand);
@@ -165,6 +276,9 @@ int raycastHitCount;            // Number of rays that detected collision
         // Check if blades are grinding (sustained contact)
       bool AreBladesGrinding() const { return m_bladesGrinding; }
         
+        // Contact manifold of the current (or last) blade contact - check active
+        const BladeContactManifold& GetContactManifold() const { return m_contactManifold; }
+        
    // Set collision threshold distance (default ~5 units)
         void SetCollisionThreshold(float threshold) { m_collisionThreshold = threshold; }
         float GetCollisionThreshold() const { return m_collisionThreshold; }
@@ -192,11 +306,30 @@ WeaponGeometryTracker(const WeaponGeometryTracker&) = delete;
       void UpdateHiggsGrabbedGeometry(bool isLeftHand, TESObjectREFR* grabbedRef, float deltaTime);
    
         // Check for X-pose (crossed blades facing forward)
-    void CheckXPose(const BladeGeometry& leftBlade, const BladeGeometry& rightBlade);
+    void CheckXPose(const BladeContactManifold& contact);
         
         // Get the appropriate weapon offset node name
         const char* GetWeaponOffsetNodeName(bool isLeftHand);
         
+        // ============================================
+        // Velocity Sources
+        // ============================================
+        
+        // Replace finite-difference velocities with the configured source (keeps them if unavailable)
+        void ApplyVelocitySource(BladeGeometry& geometry, bool isLeftHand, bool isHiggsGrabbed);
+        
+        // Read rigid motion of the VR controller holding this game hand's weapon
+        bool GetControllerVelocity(bool isLeftHand, RigidBodyVelocity& outVelocity);
+        
+        // Read rigid motion of the HIGGS weapon body (or grabbed body) for this game hand
+        bool GetRigidBodyVelocity(bool isLeftHand, bool isHiggsGrabbed, RigidBodyVelocity& outVelocity);
+        
+        // Fill predicted blade pose from the predicted controller pose and the cached controller-space blade
+        void UpdatePredictedGeometry(BladeGeometry& geometry, bool isLeftHand);
+        
+        // Record detection-to-swap latency once HIGGS holds the dropped weapon
+        void TrackSwapLatency(bool offHandHiggsGrabbed);
+        
         // Log geometry state for debugging
      void LogGeometryState();
         
@@ -204,15 +337,25 @@ WeaponGeometryTracker(const WeaponGeometryTracker&) = delete;
         // Raycasting Collision Detection
         // ============================================
         
-        // Cast multiple rays along a blade to detect intersection with another blade
-        // Returns the number of rays that hit
+        // Cast rays from the given source blade parameters toward the matching target parameters
+        // Returns the number of rays that hit (outHits needs sampleCount entries)
      int RaycastBladeIntersection(
         const BladeGeometry& sourceBlade,
             const BladeGeometry& targetBlade,
       float bladeRadius,      // Thickness/radius of blade for hit detection
- BladeRaycastHit* outHits,    // Array to store hit results
-  int maxHits// Maximum number of hits to return
+        const float* sourceParams,      // Ray origins along the source blade (0 = base, 1 = tip)
+        const float* targetParams,      // Ray aim points along the target blade
+        int sampleCount,
+ BladeRaycastHit* outHits    // Array to store hit results
         );
+        
+        // Rays per blade for this check (RAYCAST_MIN..RAYCAST_MAX_SAMPLES) from distance, relative speed
+        // and blade length, with parameters packed around each blade's closest point
+        int ChooseRaySamples(float distance, float relativeSpeed, float bladeLength, float reachRange,
+            float leftCenter, float rightCenter, float* outLeftParams, float* outRightParams);
+        
+        // Parameter for evenly spaced u (0-1), pulled toward center by focus (0 = even, 1 = quadratic)
+        static float FocusedRayParameter(float u, float center, float focus);
  
         // Cast a single ray from a point on one blade toward the other blade
         bool RaycastTowardBlade(
@@ -252,6 +395,21 @@ bool RayIntersectsCylinder(
     
         // Estimate time to collision with scaled threshold (for dynamic blade length scaling)
         float EstimateTimeToCollisionScaled(float distance, float closingVelocity, float scaledCollisionThreshold);
+        
+        // Blade collision specialized for one weapon type pair (thresholds and tests from CollisionKernelPolicy)
+        template <WeaponType Left, WeaponType Right>
+        bool CheckBladeCollisionKernel(BladeCollisionResult& outResult);
+        
+        typedef bool (WeaponGeometryTracker::*CollisionKernel)(BladeCollisionResult& outResult);
+        
+        // Point m_collisionKernel at the specialization for this type pair
+        void SelectCollisionKernel(WeaponType leftType, WeaponType rightType);
+        
+        // Blades not in contact this check - grinding stops
+        void ResetGrindState(BladeCollisionResult& outResult);
+        
+        // Carry the contact manifold forward with this check's contact
+        void UpdateContactManifold(const BladeCollisionResult& result, const NiPoint3& normal, const NiPoint3& relativeVelocity);
       
         // Helper: dot product
         static float Dot(const NiPoint3& a, const NiPoint3& b);
@@ -271,6 +429,9 @@ bool RayIntersectsCylinder(
         // Helper: point along segment
         static NiPoint3 PointAlongSegment(const NiPoint3& start, const NiPoint3& end, float t);
         
+        // Helper: parameter (0-1) of a point projected onto a segment
+        static float SegmentParameter(const NiPoint3& start, const NiPoint3& end, const NiPoint3& point);
+        
     WeaponGeometryState m_geometryState;
         BladeCollisionResult m_lastCollision;
         BladeCollisionCallback m_collisionCallback = nullptr;
@@ -283,7 +444,7 @@ bool RayIntersectsCylinder(
         bool m_wasImminent = false;
   bool m_bladesGrinding = false;   // Blades are in sustained contact (grinding)
         bool m_wasGrinding = false;
-    float m_grindStartTime = 0.0f;      // When grinding started
+        BladeContactManifold m_contactManifold;
         float m_grindDuration = 0.0f;       // How long blades have been grinding
         bool m_inXPose = false;             // Currently in X-pose
         bool m_wasInXPose = false;          // Was in X-pose last frame
@@ -294,18 +455,68 @@ bool RayIntersectsCylinder(
         float m_imminentThreshold = 15.0f;      // Will be updated from config
         
         // Raycast configuration
-        static const int RAYCAST_SAMPLES = 5;   // Number of rays to cast along each blade
+        static const int RAYCAST_MIN_SAMPLES = 3;       // Rays per blade at the edge of reach
+        static const int RAYCAST_MAX_SAMPLES = 12;      // Rays per blade for close, fast contact (stack buffer size)
+        static const int RAYCAST_FIXED_SAMPLES = 5;     // Old fixed scheme, still run now and then for comparison
         static const float BLADE_RADIUS;        // Approximated blade thickness for raycast
+        static const float TIER_REACH_MARGIN;   // Added to the widest threshold for the tier 0/1 rejects
+        
+        // Collision kernel for the current weapon type pair (index 0 = left), reselected when a type changes
+        CollisionKernel m_collisionKernel = nullptr;
+        WeaponType m_kernelTypes[2] = { WeaponType::None, WeaponType::None };
+        int m_kernelCallCount = 0;
+        double m_kernelNs = 0.0;
+        
+        // Adaptive ray stats; with [General] Profiling the fixed scheme runs on every 8th check for comparison
+        int m_rayCheckCount = 0;
+        int m_raySampleTotal = 0;
+        int m_rayCompareCount = 0;
+        int m_rayAgreeCount = 0;                // Same raycast collision verdict as the fixed scheme
+        int m_rayFixedSamples = 0;
+        double m_rayAdaptiveNs = 0.0;
+        double m_rayFixedNs = 0.0;
+        
+        // Tiered pipeline counters: checks rejected by bounding spheres, by segment distance, or run in full
+        int m_tierSphereRejects = 0;
+        int m_tierSegmentRejects = 0;
+        int m_tierDetailedChecks = 0;
+        
+        // Per-type weapon shapes (index 0 = left) and GJK warm start per part pair
+        CompoundShape m_weaponShapes[2];
+        GjkCache m_gjkCaches[CompoundShape::kMaxParts * CompoundShape::kMaxParts];
+        
+        // Convex shape test vs segment test cost/accuracy stats
+        int m_shapeTestCount = 0;
+        double m_segmentTestUs = 0.0;
+        double m_shapeTestUs = 0.0;
+        int m_gjkIterations = 0;
+        int m_shapeCloserCount = 0;
+        float m_shapeCloserSum = 0.0f;
+        
+        // Velocity source comparison stats (measured source vs finite difference)
+        int m_velocitySampleCount = 0;
+        int m_velocityFallbackCount = 0;
+        float m_velocityTipDeltaSum = 0.0f;
+        
+        // Blade base/tip in controller space per game hand (index 0 = left), captured once per equip/grab
+        NiPoint3 m_controllerLocalBase[2];
+        NiPoint3 m_controllerLocalTip[2];
+        bool m_hasControllerLocalBlade[2] = { false, false };
+        
+        // Detection-to-swap latency tracking
+        bool m_swapLatencyPending = false;
+        bool m_swapLatencyPredicted = false;
+        float m_swapDetectTime = 0.0f;
         
         // Grace period tracking - don't trigger collision right after equipping
       int m_framesSinceEquipChange = 0;
         UInt32 m_lastLeftWeaponFormID = 0;
    UInt32 m_lastRightWeaponFormID = 0;
+        
+        // Geometry phase results the pair phase reads
+        bool m_bladePairValid = false;
     };
     
   // Convenience function to initialize weapon geometry tracking
     void InitializeWeaponGeometryTracker();
-    
-    // Convenience function to update weapon geometry (call each frame)
-    void UpdateWeaponGeometry(float deltaTime);
 }
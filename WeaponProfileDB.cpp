@@ -0,0 +1,268 @@
+#include "WeaponProfileDB.h"
+#include "config.h"
+#include "SkyrimVRESLAPI.h"
+#include "common/IDebugLog.h"
+#include "skse64/GameObjects.h"
+#include "skse64/GameRTTI.h"
+#include <windows.h>
+#include <chrono>
+
+namespace FalseEdgeVR
+{
+    WeaponProfileDB* WeaponProfileDB::GetSingleton()
+    {
+        static WeaponProfileDB instance;
+        return &instance;
+    }
+
+    WeaponProfileDB::~WeaponProfileDB()
+    {
+        Unmap();
+    }
+
+    void WeaponProfileDB::Unmap()
+    {
+        if (m_view)
+            UnmapViewOfFile(m_view);
+        if (m_mapping)
+            CloseHandle((HANDLE)m_mapping);
+        if (m_file && m_file != INVALID_HANDLE_VALUE)
+            CloseHandle((HANDLE)m_file);
+
+        m_view = nullptr;
+        m_mapping = nullptr;
+        m_file = nullptr;
+        m_seeds = nullptr;
+        m_records = nullptr;
+        m_meshes = nullptr;
+        m_vertices = nullptr;
+        m_triangles = nullptr;
+        m_fields = nullptr;
+        m_samples = nullptr;
+        m_recordCount = 0;
+        m_bucketCount = 0;
+        m_meshCount = 0;
+        m_vertexCount = 0;
+        m_triangleCount = 0;
+        m_fieldCount = 0;
+        m_sampleCount = 0;
+    }
+
+    bool WeaponProfileDB::Load()
+    {
+        Unmap();
+
+        if (!useBladeProfiles)
+        {
+            _MESSAGE("WeaponProfileDB: Disabled ([BladeCollision] BladeProfiles=0)");
+            return false;
+        }
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        std::string path = GetRuntimeDirectory() + "Data\\SKSE\\Plugins\\FalseEdgeVR_BladeProfiles.bin";
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            _MESSAGE("WeaponProfileDB: No profile database at %s - using reach and ShieldRadius", path.c_str());
+            return false;
+        }
+        m_file = file;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < (LONGLONG)sizeof(BladeProfileHeader))
+        {
+            _MESSAGE("WeaponProfileDB: %s is too small", path.c_str());
+            Unmap();
+            return false;
+        }
+
+        m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        m_view = m_mapping ? MapViewOfFile((HANDLE)m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!m_view)
+        {
+            _MESSAGE("WeaponProfileDB: Could not map %s (error %u)", path.c_str(), GetLastError());
+            Unmap();
+            return false;
+        }
+
+        // Header and section sizes only - the records themselves stay on disk until touched
+        const BladeProfileHeader* header = (const BladeProfileHeader*)m_view;
+        UInt64 expectedSize = sizeof(BladeProfileHeader) + (UInt64)header->bucketCount * sizeof(UInt32) +
+            (UInt64)header->recordCount * sizeof(BladeProfileRecord) + (UInt64)header->meshCount * sizeof(BladeProfileMesh) +
+            (UInt64)header->vertexCount * 3 * sizeof(float) + BladeProfileAlign4((UInt64)header->triangleCount * 3 * sizeof(UInt16)) +
+            (UInt64)header->sdfCount * sizeof(BladeProfileSdf) + (UInt64)header->sampleCount * sizeof(SInt16);
+        if (header->magic != kBladeProfileMagic || header->version != kBladeProfileVersion)
+        {
+            _MESSAGE("WeaponProfileDB: %s has version %u, expected %u - regenerate it with NifProfiler",
+                path.c_str(), header->magic == kBladeProfileMagic ? header->version : 0, kBladeProfileVersion);
+            Unmap();
+            return false;
+        }
+        if ((UInt64)fileSize.QuadPart != expectedSize || (header->recordCount > 0 && header->bucketCount == 0))
+        {
+            _MESSAGE("WeaponProfileDB: %s is truncated or corrupt (%lld bytes, expected %llu)",
+                path.c_str(), fileSize.QuadPart, expectedSize);
+            Unmap();
+            return false;
+        }
+
+        m_recordCount = header->recordCount;
+        m_bucketCount = header->bucketCount;
+        m_seeds = (const UInt32*)(header + 1);
+        m_records = (const BladeProfileRecord*)(m_seeds + m_bucketCount);
+        m_meshCount = header->meshCount;
+        m_vertexCount = header->vertexCount;
+        m_triangleCount = header->triangleCount;
+        m_meshes = (const BladeProfileMesh*)(m_records + m_recordCount);
+        m_vertices = (const float*)(m_meshes + m_meshCount);
+        m_triangles = (const UInt16*)(m_vertices + (size_t)m_vertexCount * 3);
+        m_fieldCount = header->sdfCount;
+        m_sampleCount = header->sampleCount;
+        m_fields = (const BladeProfileSdf*)((const UInt8*)m_triangles + BladeProfileAlign4((UInt64)m_triangleCount * 3 * sizeof(UInt16)));
+        m_samples = (const SInt16*)(m_fields + m_fieldCount);
+
+        IndexPlugins();
+
+        double loadMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count();
+        _MESSAGE("WeaponProfileDB: Mapped %u profiles (%u hash buckets), %u collision meshes (%u triangles) in %.3fms",
+            m_recordCount, m_bucketCount, m_meshCount, m_triangleCount, loadMs);
+        // Fields are only paged in when a shield using one is equipped
+        _MESSAGE("WeaponProfileDB: %u distance fields, %.1f KB of samples (%.1f KB per field)",
+            m_fieldCount, m_sampleCount * sizeof(SInt16) / 1024.0f,
+            m_fieldCount > 0 ? m_sampleCount * sizeof(SInt16) / 1024.0f / m_fieldCount : 0.0f);
+        return true;
+    }
+
+    void WeaponProfileDB::IndexPlugins()
+    {
+        for (UInt32& hash : m_fullPluginHash)
+            hash = 0;
+        m_lightPluginHash.clear();
+
+        DataHandler* dataHandler = DataHandler::GetSingleton();
+        if (!dataHandler)
+            return;
+
+        const tArray<ModInfo*>& fullMods = dataHandler->modList.loadedMods;
+        for (UInt32 i = 0; i < fullMods.count; i++)
+        {
+            ModInfo* modInfo = nullptr;
+            fullMods.GetNthItem(i, modInfo);
+            if (modInfo && modInfo->modIndex < 0xFE)
+                m_fullPluginHash[modInfo->modIndex] = BladeProfilePluginHash(modInfo->name);
+        }
+
+        const SkyrimVRESLPluginAPI::TESFileCollection* fileCollection =
+            g_SkyrimVRESLInterface ? g_SkyrimVRESLInterface->GetCompiledFileCollection() : nullptr;
+        if (fileCollection)
+        {
+            for (UInt32 i = 0; i < fileCollection->smallFiles.count; i++)
+            {
+                ModInfo* modInfo = nullptr;
+                fileCollection->smallFiles.GetNthItem(i, modInfo);
+                if (!modInfo)
+                    continue;
+                if (modInfo->lightIndex >= m_lightPluginHash.size())
+                    m_lightPluginHash.resize(modInfo->lightIndex + 1, 0);
+                m_lightPluginHash[modInfo->lightIndex] = BladeProfilePluginHash(modInfo->name);
+            }
+        }
+    }
+
+    const BladeProfileRecord* WeaponProfileDB::Find(UInt32 formID) const
+    {
+        if (!m_records || m_recordCount == 0)
+            return nullptr;
+
+        // Runtime forms (player-made and tempered/enchanted copies) use the mesh of the
+        // form they were made from, so follow the template chain back to a plugin form
+        for (int depth = 0; (formID >> 24) == 0xFF && depth < 4; depth++)
+        {
+            TESForm* form = LookupFormByID(formID);
+            TESForm* templateForm = nullptr;
+            if (TESObjectWEAP* weapon = DYNAMIC_CAST(form, TESForm, TESObjectWEAP))
+                templateForm = weapon->templateForm;
+            else if (TESObjectARMO* armor = DYNAMIC_CAST(form, TESForm, TESObjectARMO))
+                templateForm = armor->templateArmor;
+            if (!templateForm)
+                return nullptr;
+            formID = templateForm->formID;
+        }
+
+        // Defining plugin + FormID without the load order index
+        UInt32 modIndex = formID >> 24;
+        UInt32 pluginHash = 0;
+        UInt32 localFormID = 0;
+        if (modIndex == 0xFE)
+        {
+            UInt32 lightIndex = (formID >> 12) & 0xFFF;
+            pluginHash = lightIndex < m_lightPluginHash.size() ? m_lightPluginHash[lightIndex] : 0;
+            localFormID = formID & 0xFFF;
+        }
+        else if (modIndex != 0xFF)
+        {
+            pluginHash = m_fullPluginHash[modIndex];
+            localFormID = formID & 0xFFFFFF;
+        }
+        if (pluginHash == 0)
+            return nullptr;
+
+        m_lookupCount++;
+
+        UInt64 key = BladeProfileKey(pluginHash, localFormID);
+        UInt32 bucket = BladeProfileHash(key, 0) % m_bucketCount;
+        const BladeProfileRecord* record = &m_records[BladeProfileHash(key, m_seeds[bucket]) % m_recordCount];
+        bool hit = record->pluginHash == pluginHash && record->localFormID == localFormID;
+        if (hit)
+            m_hitCount++;
+
+        if (m_lookupCount % 5000 == 0)
+        {
+            _MESSAGE("WeaponProfileDB: %u lookups, %u with a profile (%.1f%%)",
+                m_lookupCount, m_hitCount, 100.0f * m_hitCount / m_lookupCount);
+        }
+
+        return hit ? record : nullptr;
+    }
+
+    bool WeaponProfileDB::GetMesh(const BladeProfileRecord* record, BladeProfileMeshView& outMesh) const
+    {
+        if (!record || record->meshIndex >= m_meshCount)
+            return false;
+
+        // Ranges come from the file - check them before handing out pointers
+        const BladeProfileMesh& mesh = m_meshes[record->meshIndex];
+        if ((UInt64)mesh.firstVertex + mesh.vertexCount > m_vertexCount ||
+            (UInt64)mesh.firstTriangle + mesh.triangleCount > m_triangleCount ||
+            mesh.vertexCount == 0 || mesh.triangleCount == 0)
+            return false;
+
+        outMesh.vertices = m_vertices + (size_t)mesh.firstVertex * 3;
+        outMesh.triangles = m_triangles + (size_t)mesh.firstTriangle * 3;
+        outMesh.vertexCount = mesh.vertexCount;
+        outMesh.triangleCount = mesh.triangleCount;
+        return true;
+    }
+
+    bool WeaponProfileDB::GetDistanceField(const BladeProfileRecord* record, BladeProfileFieldView& outField) const
+    {
+        if (!record || record->sdfIndex >= m_fieldCount)
+            return false;
+
+        const BladeProfileSdf& field = m_fields[record->sdfIndex];
+        UInt64 sampleCount = (UInt64)field.resolution * field.resolution * field.resolution;
+        if (field.resolution < 2 || field.firstSample + sampleCount > m_sampleCount ||
+            !(field.voxelSize > 0.0f) || !(field.distanceScale > 0.0f))
+            return false;
+
+        outField.samples = m_samples + field.firstSample;
+        outField.origin[0] = field.origin[0];
+        outField.origin[1] = field.origin[1];
+        outField.origin[2] = field.origin[2];
+        outField.voxelSize = field.voxelSize;
+        outField.distanceScale = field.distanceScale;
+        outField.resolution = field.resolution;
+        return true;
+    }
+}
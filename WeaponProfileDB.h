@@ -0,0 +1,98 @@
+#pragma once
+
+#include "BladeProfileFormat.h"
+#include "skse64/GameForms.h"
+#include <vector>
+
+namespace FalseEdgeVR
+{
+    // A record's collision mesh, pointing into the mapped file
+    struct BladeProfileMeshView
+    {
+        const float* vertices = nullptr;        // xyz per vertex
+        const UInt16* triangles = nullptr;      // 3 per triangle, indices into vertices
+        UInt32 vertexCount = 0;
+        UInt32 triangleCount = 0;
+    };
+
+    // A record's signed distance field, pointing into the mapped file
+    struct BladeProfileFieldView
+    {
+        const SInt16* samples = nullptr;        // resolution^3, x fastest
+        float origin[3] = {};
+        float voxelSize = 0.0f;
+        float distanceScale = 0.0f;             // Sample value -> distance
+        UInt32 resolution = 0;
+    };
+
+    // ============================================
+    // WeaponProfileDB
+    // ============================================
+    // Per-weapon profiles measured offline from the meshes (tools/NifProfiler),
+    // read from Data\SKSE\Plugins\FalseEdgeVR_BladeProfiles.bin.
+    // The file is memory-mapped read-only at kMessage_DataLoaded and never parsed:
+    // records are looked up in place through the file's minimal perfect hash, so
+    // startup only checks the header and indexes the loaded plugin names, however
+    // many records the file holds.
+    // Plugins are identified by name hash, so the database doesn't depend on the
+    // load order. A missing or mismatched file just disables the lookups - callers
+    // fall back to reach / [ShieldCollision] ShieldRadius.
+    // ============================================
+
+    class WeaponProfileDB
+    {
+    public:
+        static WeaponProfileDB* GetSingleton();
+
+        // Map the database and index the loaded plugins (kMessage_DataLoaded)
+        bool Load();
+
+        // Profile of a WEAP (or shield ARMO) form, nullptr if it has none
+        const BladeProfileRecord* Find(UInt32 formID) const;
+
+        // Collision mesh of a record - false if the record has none
+        bool GetMesh(const BladeProfileRecord* record, BladeProfileMeshView& outMesh) const;
+
+        // Signed distance field of a record (shields) - false if the record has none
+        bool GetDistanceField(const BladeProfileRecord* record, BladeProfileFieldView& outField) const;
+
+        bool IsLoaded() const { return m_records != nullptr; }
+
+    private:
+        WeaponProfileDB() = default;
+        ~WeaponProfileDB();
+        WeaponProfileDB(const WeaponProfileDB&) = delete;
+        WeaponProfileDB& operator=(const WeaponProfileDB&) = delete;
+
+        void Unmap();
+
+        // Name hash per load order slot - full plugins by mod index, light plugins by light index
+        void IndexPlugins();
+
+        void* m_file = nullptr;
+        void* m_mapping = nullptr;
+        const void* m_view = nullptr;
+
+        const UInt32* m_seeds = nullptr;
+        const BladeProfileRecord* m_records = nullptr;
+        const BladeProfileMesh* m_meshes = nullptr;
+        const float* m_vertices = nullptr;
+        const UInt16* m_triangles = nullptr;
+        const BladeProfileSdf* m_fields = nullptr;
+        const SInt16* m_samples = nullptr;
+        UInt32 m_recordCount = 0;
+        UInt32 m_bucketCount = 0;
+        UInt32 m_meshCount = 0;
+        UInt32 m_vertexCount = 0;
+        UInt32 m_triangleCount = 0;
+        UInt32 m_fieldCount = 0;
+        UInt32 m_sampleCount = 0;
+
+        UInt32 m_fullPluginHash[256] = {};
+        std::vector<UInt32> m_lightPluginHash;
+
+        // Stats
+        mutable UInt32 m_lookupCount = 0;
+        mutable UInt32 m_hitCount = 0;
+    };
+}
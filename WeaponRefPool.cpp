@@ -0,0 +1,341 @@
+#include "WeaponRefPool.h"
+#include "Engine.h"
+#include "skse64/GameForms.h"
+#include "skse64/GameRTTI.h"
+#include "skse64/GameExtraData.h"
+#include "skse64/NiNodes.h"
+#include "common/IDebugLog.h"
+#include <chrono>
+#include <cstring>
+
+namespace FalseEdgeVR
+{
+    WeaponRefPool* WeaponRefPool::GetSingleton()
+    {
+        static WeaponRefPool instance;
+        return &instance;
+    }
+
+    bool WeaponRefPool::IsEnabled() const
+    {
+        return weaponRefPoolSize > 0;
+    }
+
+    // Move a loaded reference - same approach used to snap dropped weapons back to the hand
+    static void TeleportRef(TESObjectREFR* ref, const NiPoint3& pos)
+    {
+        ref->pos = pos;
+
+        NiNode* node = ref->GetNiNode();
+        if (node)
+        {
+            node->m_worldTransform.pos = pos;
+        }
+    }
+
+    // Scene graph / Havok memory layout (Skyrim VR)
+    static const UInt32 kNiAVObjectFlagHidden = 0x1;                  // NiAVObject::m_flags - not drawn
+    static const UInt32 kNiAVObjectCollisionObjectOffset = 0x40;      // NiAVObject::m_collisionObject
+    static const UInt32 kBhkCollisionObjectBodyOffset = 0x20;         // bhkNiCollisionObject::body (bhkRigidBody)
+    static const UInt32 kBhkRefObjectHavokObjectOffset = 0x10;        // bhkRefObject::hkObject
+    static const UInt32 kHkpWorldObjectFilterInfoOffset = 0x4C;       // hkpWorldObject::m_collidable.m_broadPhaseHandle.m_collisionFilterInfo
+    static const UInt32 kHkpEntityMotionOffset = 0x150;               // hkpEntity::m_motion
+    static const UInt32 kHkpMotionLinearVelocityOffset = 0xE0;        // hkpMotion::m_linearVelocity
+    static const UInt32 kHkpMotionAngularVelocityOffset = 0xF0;       // hkpMotion::m_angularVelocity
+    static const UInt32 kHkpMotionGravityFactorOffset = 0x132;        // hkpMotion::m_gravityFactor (hkHalf)
+    static const UInt32 kCollisionLayerMask = 0x7F;
+    static const UInt32 kCollisionLayerNonCollidable = 15;            // L_NONCOLLIDABLE - skipped by contacts and ray casts (HIGGS grab, crosshair)
+
+    // hkpRigidBody behind the weapon's root node (or a direct child - some meshes put the collision there)
+    static UInt8* GetHavokBody(NiNode* node)
+    {
+        NiAVObject* candidates[2] = { node, nullptr };
+        for (UInt32 i = 0; i < node->m_children.m_emptyRunStart && !candidates[1]; i++)
+        {
+            NiAVObject* child = node->m_children.m_data[i];
+            if (child && *reinterpret_cast<UInt8**>(reinterpret_cast<UInt8*>(child) + kNiAVObjectCollisionObjectOffset))
+                candidates[1] = child;
+        }
+
+        for (NiAVObject* object : candidates)
+        {
+            if (!object)
+                continue;
+
+            UInt8* collisionObject = *reinterpret_cast<UInt8**>(reinterpret_cast<UInt8*>(object) + kNiAVObjectCollisionObjectOffset);
+            if (!collisionObject)
+                continue;
+
+            UInt8* rigidBody = *reinterpret_cast<UInt8**>(collisionObject + kBhkCollisionObjectBodyOffset);
+            if (!rigidBody)
+                continue;
+
+            UInt8* havokBody = *reinterpret_cast<UInt8**>(rigidBody + kBhkRefObjectHavokObjectOffset);
+            if (havokBody)
+                return havokBody;
+        }
+        return nullptr;
+    }
+
+    void WeaponRefPool::Park(TESObjectREFR* ref, PooledRef& entry)
+    {
+        NiNode* node = ref->GetNiNode();
+        if (!node)
+            return;
+
+        node->m_flags |= kNiAVObjectFlagHidden;
+
+        // Moving only ref->pos/the node leaves the body where HIGGS dropped it (the next physics sync puts
+        // the node back) - instead stop the body and take it out of every contact and ray cast
+        UInt8* havokBody = GetHavokBody(node);
+        if (havokBody)
+        {
+            UInt32* filterInfo = reinterpret_cast<UInt32*>(havokBody + kHkpWorldObjectFilterInfoOffset);
+            UInt8* motion = havokBody + kHkpEntityMotionOffset;
+            UInt16* gravityFactor = reinterpret_cast<UInt16*>(motion + kHkpMotionGravityFactorOffset);
+
+            entry.filterInfo = *filterInfo;
+            entry.gravityFactor = *gravityFactor;
+            entry.hasBody = true;
+
+            *filterInfo = (*filterInfo & ~kCollisionLayerMask) | kCollisionLayerNonCollidable;
+            *gravityFactor = 0;
+            memset(motion + kHkpMotionLinearVelocityOffset, 0, sizeof(float) * 4);
+            memset(motion + kHkpMotionAngularVelocityOffset, 0, sizeof(float) * 4);
+        }
+        else
+        {
+            _MESSAGE("WeaponRefPool: Ref %08X has no rigid body - parked hidden only", ref->formID);
+        }
+    }
+
+    void WeaponRefPool::Unpark(TESObjectREFR* ref, const PooledRef& entry)
+    {
+        NiNode* node = ref->GetNiNode();
+        if (!node)
+            return;
+
+        node->m_flags &= ~kNiAVObjectFlagHidden;
+
+        UInt8* havokBody = entry.hasBody ? GetHavokBody(node) : nullptr;
+        if (havokBody)
+        {
+            *reinterpret_cast<UInt32*>(havokBody + kHkpWorldObjectFilterInfoOffset) = entry.filterInfo;
+            *reinterpret_cast<UInt16*>(havokBody + kHkpEntityMotionOffset + kHkpMotionGravityFactorOffset) = entry.gravityFactor;
+        }
+    }
+
+    SInt32 WeaponRefPool::GetPlayerItemCount(TESForm* item)
+    {
+        PlayerCharacter* player = *g_thePlayer;
+        if (!player || !item)
+            return 0;
+
+        ExtraContainerChanges* containerChanges = static_cast<ExtraContainerChanges*>(
+            player->extraData.GetByType(kExtraData_ContainerChanges));
+        if (!containerChanges || !containerChanges->data)
+            return 0;
+
+        InventoryEntryData* entryData = containerChanges->data->FindItemEntry(item);
+        return entryData ? entryData->countDelta : 0;
+    }
+
+    TESObjectREFR* WeaponRefPool::ResolveRef(const PooledRef& entry)
+    {
+        TESForm* form = LookupFormByID(entry.refFormID);
+        if (!form)
+            return nullptr;
+
+        TESObjectREFR* ref = DYNAMIC_CAST(form, TESForm, TESObjectREFR);
+        if (!ref || !ref->baseForm || ref->baseForm->formID != entry.baseFormID)
+            return nullptr;
+
+        if (ref->flags & TESForm::kFlagIsDeleted)
+            return nullptr;
+
+        // Parked refs must still have 3D to be teleported and grabbed
+        if (!ref->GetNiNode())
+            return nullptr;
+
+        return ref;
+    }
+
+    TESObjectREFR* WeaponRefPool::Acquire(TESForm* item, const NiPoint3& spawnPos)
+    {
+        PlayerCharacter* player = *g_thePlayer;
+        if (!player || !item)
+            return nullptr;
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        m_acquireCount++;
+
+        // Reuse a parked ref of the same weapon - stale entries are left for Update to reconcile
+        for (size_t i = 0; i < m_refs.size(); i++)
+        {
+            PooledRef entry = m_refs[i];
+            if (!entry.parked || entry.baseFormID != item->formID)
+                continue;
+
+            TESObjectREFR* ref = ResolveRef(entry);
+            if (!ref)
+                continue;
+
+            m_refs.erase(m_refs.begin() + i);
+            Unpark(ref, entry);
+            TeleportRef(ref, spawnPos);
+
+            m_reuseCount++;
+            m_reuseTimeTotalMs += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count();
+            _MESSAGE("WeaponRefPool: Reusing parked ref %08X for weapon %08X", ref->formID, item->formID);
+
+            if (m_acquireCount % 10 == 0)
+                LogStats();
+            return ref;
+        }
+
+        TESObjectREFR* ref = PlaceAtMe_Native(nullptr, 0, player, item, 1, false, false);
+        if (ref)
+        {
+            ref->pos = spawnPos;
+            m_spawnCount++;
+            m_spawnTimeTotalMs += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count();
+            _MESSAGE("WeaponRefPool: Pool empty for weapon %08X - spawned ref %08X", item->formID, ref->formID);
+        }
+
+        if (m_acquireCount % 10 == 0)
+            LogStats();
+        return ref;
+    }
+
+    void WeaponRefPool::Release(TESObjectREFR* ref)
+    {
+        if (!ref)
+            return;
+
+        if (!IsEnabled() || !ref->baseForm)
+        {
+            DeleteWorldObject(ref);
+            return;
+        }
+
+        m_releaseCount++;
+
+        int countForWeapon = 0;
+        for (const PooledRef& entry : m_refs)
+        {
+            if (entry.baseFormID == ref->baseForm->formID)
+                countForWeapon++;
+        }
+
+        if (countForWeapon >= weaponRefPoolSize)
+        {
+            _MESSAGE("WeaponRefPool: Pool full for weapon %08X (%d) - deleting ref %08X",
+                ref->baseForm->formID, countForWeapon, ref->formID);
+            DeleteRef(ref);
+            return;
+        }
+
+        PooledRef entry;
+        entry.refFormID = ref->formID;
+        entry.baseFormID = ref->baseForm->formID;
+        entry.inventoryCount = GetPlayerItemCount(ref->baseForm);
+        m_refs.push_back(entry);
+        _MESSAGE("WeaponRefPool: Returned ref %08X (weapon %08X) - parking once HIGGS releases it",
+            ref->formID, ref->baseForm->formID);
+    }
+
+    void WeaponRefPool::DeleteRef(TESObjectREFR* ref)
+    {
+        DeleteWorldObject(ref);
+        m_deleteCount++;
+    }
+
+    void WeaponRefPool::Update(float deltaTime)
+    {
+        if (m_refs.empty())
+            return;
+
+        PlayerCharacter* player = *g_thePlayer;
+        if (!player)
+            return;
+
+        for (size_t i = 0; i < m_refs.size(); )
+        {
+            PooledRef& entry = m_refs[i];
+            entry.age += deltaTime;
+
+            TESObjectREFR* ref = ResolveRef(entry);
+            TESForm* baseForm = LookupFormByID(entry.baseFormID);
+            SInt32 inventoryCount = GetPlayerItemCount(baseForm);
+            if (!ref)
+            {
+                // The player already has this weapon (the proxy's inventory copy) - a ref that went into
+                // the inventory is a duplicate, take it back out. Otherwise it was unloaded with its cell
+                if (baseForm && inventoryCount > entry.inventoryCount)
+                {
+                    m_pickupCount++;
+                    _MESSAGE("WeaponRefPool: Ref %08X was picked up (count %d -> %d) - removing the duplicate %08X",
+                        entry.refFormID, entry.inventoryCount, inventoryCount, entry.baseFormID);
+                    RemoveItemFromInventory(player, baseForm, inventoryCount - entry.inventoryCount, true);
+                }
+                else
+                {
+                    _MESSAGE("WeaponRefPool: Ref %08X no longer available - dropping from pool", entry.refFormID);
+                }
+                m_refs.erase(m_refs.begin() + i);
+                continue;
+            }
+            entry.inventoryCount = inventoryCount;
+
+            if (entry.age >= weaponRefPoolTimeout)
+            {
+                _MESSAGE("WeaponRefPool: Ref %08X unused for %.1fs - deleting", entry.refFormID, entry.age);
+                DeleteRef(ref);
+                m_refs.erase(m_refs.begin() + i);
+                continue;
+            }
+
+            // HIGGS lets go of the ref once the hand has its weapon again - take it out of play
+            if (!entry.parked)
+            {
+                bool held = higgsInterface &&
+                    (higgsInterface->GetGrabbedObject(true) == ref || higgsInterface->GetGrabbedObject(false) == ref);
+                if (!held)
+                {
+                    Park(ref, entry);
+                    entry.parked = true;
+                }
+            }
+
+            i++;
+        }
+    }
+
+    bool WeaponRefPool::IsParked(TESObjectREFR* ref) const
+    {
+        if (!ref)
+            return false;
+
+        for (const PooledRef& entry : m_refs)
+        {
+            if (entry.parked && entry.refFormID == ref->formID)
+                return true;
+        }
+        return false;
+    }
+
+    void WeaponRefPool::Clear()
+    {
+        m_refs.clear();
+    }
+
+    void WeaponRefPool::LogStats()
+    {
+        _MESSAGE("WeaponRefPool: Stats - acquires=%d reused=%d (avg %.3fms) spawned=%d (avg %.3fms) released=%d deleted=%d picked-up=%d spawned-deleted=%d pooled=%d",
+            m_acquireCount,
+            m_reuseCount, m_reuseCount > 0 ? m_reuseTimeTotalMs / m_reuseCount : 0.0,
+            m_spawnCount, m_spawnCount > 0 ? m_spawnTimeTotalMs / m_spawnCount : 0.0,
+            m_releaseCount, m_deleteCount, m_pickupCount,
+            m_spawnCount - m_deleteCount, (int)m_refs.size());
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "skse64/GameReferences.h"
+#include "skse64/NiNodes.h"
+#include "EquipManager.h"
+#include <vector>
+
+namespace FalseEdgeVR
+{
+    // ============================================
+    // WeaponRefPool
+    // ============================================
+    // Recycles the world weapon references that collision avoidance hands to HIGGS.
+    // Pooled refs are proxies: the inventory item stays with the player while HIGGS
+    // holds the ref, so re-equip returns the ref here instead of picking it up.
+    // Returned refs are parked once HIGGS lets go of them - node hidden, rigid body
+    // made non-collidable and weightless so it can't be seen, grabbed or activated -
+    // and reused for the next avoidance with the same weapon FormID.
+    // A ref that still ends up in the player's inventory is reconciled (the extra copy removed).
+    // Parked refs expire after [WeaponSpawn] RefPoolTimeout seconds.
+    // Disabled when [WeaponSpawn] RefPoolSize = 0 (refs are spawned/deleted as before).
+    // ============================================
+
+    class WeaponRefPool
+    {
+    public:
+        static WeaponRefPool* GetSingleton();
+
+        // Whether avoidance should take its refs from the pool
+        bool IsEnabled() const;
+
+        // Get a world ref for this weapon at spawnPos - a parked ref when one exists, otherwise a new spawn
+        TESObjectREFR* Acquire(TESForm* item, const NiPoint3& spawnPos);
+
+        // Give a proxy ref back - parked for reuse when the pool has room, deleted otherwise
+        void Release(TESObjectREFR* ref);
+
+        // Park returned refs HIGGS has released, expire stale ones, log stats
+        void Update(float deltaTime);
+
+        // Whether this ref is one of ours waiting for reuse (activation is blocked)
+        bool IsParked(TESObjectREFR* ref) const;
+
+        // Forget all refs (game load - references from the old session are gone)
+        void Clear();
+
+    private:
+        WeaponRefPool() = default;
+        ~WeaponRefPool() = default;
+        WeaponRefPool(const WeaponRefPool&) = delete;
+        WeaponRefPool& operator=(const WeaponRefPool&) = delete;
+
+        struct PooledRef
+        {
+            UInt32 refFormID = 0;
+            UInt32 baseFormID = 0;
+            float age = 0.0f;          // Seconds since returned
+            bool parked = false;       // False until HIGGS has released it and it was hidden
+            bool hasBody = false;      // Parking changed the rigid body - restore filterInfo/gravityFactor on reuse
+            UInt32 filterInfo = 0;     // Rigid body collision filter info before parking
+            UInt16 gravityFactor = 0;  // Rigid body gravity factor (hkHalf) before parking
+            SInt32 inventoryCount = 0; // Player's count of the weapon last update - a rise when the ref vanishes is a pickup
+        };
+
+        // Resolve a pooled entry to a live reference (nullptr if deleted, unloaded or replaced)
+        static TESObjectREFR* ResolveRef(const PooledRef& entry);
+
+        // Hide the ref and take its rigid body out of play / undo that for reuse
+        static void Park(TESObjectREFR* ref, PooledRef& entry);
+        static void Unpark(TESObjectREFR* ref, const PooledRef& entry);
+
+        // How many of this item the player carries
+        static SInt32 GetPlayerItemCount(TESForm* item);
+
+        // Delete a ref we own and count it
+        void DeleteRef(TESObjectREFR* ref);
+
+        void LogStats();
+
+        std::vector<PooledRef> m_refs;
+
+        // Stats
+        int m_acquireCount = 0;
+        int m_reuseCount = 0;
+        int m_spawnCount = 0;
+        int m_releaseCount = 0;
+        int m_deleteCount = 0;
+        int m_pickupCount = 0;                  // Pooled refs that reached the inventory anyway
+        double m_reuseTimeTotalMs = 0.0;
+        double m_spawnTimeTotalMs = 0.0;
+    };
+}
@@ -15,6 +15,13 @@ namespace FalseEdgeVR {
 	float bladeReequipCooldown = 0.5f;          // Cooldown after re-equip (500ms)
 	float reequipDelay = 0.002f;      // Delay after activating weapon before equipping (2ms)
 	float swingVelocityThreshold = 150.0f;      // Swing velocity threshold (units per second)
+	int bladeVelocitySource = 0;                // 0 = finite difference, 1 = OpenVR controller, 2 = HIGGS rigid body
+	float bladePredictionTime = 0.0f;           // Seconds ahead to predict controller poses (0 = off, ~0.033 covers the swap)
+	bool bladeConvexShapes = true;              // Per-type weapon shapes (mace head, axe bit) on top of the blade segment
+	bool useBladeProfiles = true;               // Blade length / shield radius from FalseEdgeVR_BladeProfiles.bin when a weapon has a profile
+	bool bladeMeshNarrowphase = false;          // Triangle mesh distance once the blade segments are within ImminentThreshold
+	int bladeMeshBudget = 1000;                 // Triangle pair tests per frame for the mesh narrowphase
+	int bladeAutoCalibrate = 0;                 // 0 = off, 1 = log suggested thresholds, 2 = apply them (FalseEdgeVR_Calibration.ini)
 	
 	// Auto-equip grabbed weapon settings
 	bool autoEquipGrabbedWeaponEnabled = true;  // Enable/disable auto-equip feature
@@ -38,6 +45,8 @@ namespace FalseEdgeVR {
 	float spawnOffsetY = 0.0f;       // Y offset (forward/back adjustment) - usually 0
 	float spawnOffsetZ = -20.0f;     // Z offset (up/down) - negative = below player
 	float spawnDistance = 150.0f;    // Distance behind player (units, 70 = ~1 meter)
+	int weaponRefPoolSize = 0;       // Max pooled world refs per weapon FormID (0 = spawn/delete every time)
+	float weaponRefPoolTimeout = 5.0f; // Seconds an unused pooled ref is kept before deletion
 	
 	// Mounted: spawn elevated to avoid horse collision
 	float spawnOffsetMountedX = 0.0f;   // X offset when mounted
@@ -50,6 +59,9 @@ namespace FalseEdgeVR {
 	// Close combat settings
 	float closeCombatEnterDistance = 70.0f;     // Enter close combat mode at 70 units (~1 meter)
 	float closeCombatExitDistance = 90.0f;      // Exit close combat mode at 90 units (buffer to prevent rapid switching)
+	bool closeCombatEnabled = false;            // Track combat distance and enter close combat mode (disabled - trigger system handles collisions)
+	float closeCombatHostileScanRadius = 1000.0f; // Hostiles further than this are not tracked
+	int closeCombatHostileScanBudget = 256;     // Max refs examined per combat scan (cells are mostly statics)
 
 	// Shield collision settings - defaults same as blade collision
 	float shieldCollisionThreshold = 5.0f;       // Distance at which weapon is considered touching shield
@@ -62,6 +74,7 @@ namespace FalseEdgeVR {
 	float shieldReequipDelay = 0.002f;           // Delay after activating weapon before equipping (2ms)
 	float shieldSwingVelocityThreshold = 150.0f; // Swing velocity threshold (units per second)
 	float shieldRadius = 15.0f;                // Shield face detection radius (units)
+	bool shieldDistanceField = true;           // Use the shield mesh's distance field from the profile database instead of the disc
 
 	// Shield bash settings - defaults
 	bool shieldBashEnabled = true;   // Enable/disable shield bash tracking feature
@@ -72,6 +85,22 @@ namespace FalseEdgeVR {
 	// Equipment change grace period
 	int equipGraceFrames = 20;    // Frames to wait after equipment change before collision detection (~0.22 sec at 90fps)
 
+	// Collision profiling - per-check timers and the reference queries they are compared against
+	bool collisionProfiling = false;
+
+	// Rate-group scheduler - defaults (Hz, 0 = every physics step)
+	bool rateSchedulerEnabled = true;         // Run the groups below at their own rate instead of every physics step
+	float schedulerBodyZoneRate = 45.0f;      // Controller-to-body-zone tests
+	float schedulerAutoEquipRate = 45.0f;     // Grabbed weapon auto-equip delay
+	float schedulerShieldBashRate = 10.0f;    // Shield bash window/lockout timers
+	float schedulerEquipConsistencyRate = 10.0f; // Equipment changes without an equip event
+	float schedulerRefPoolRate = 10.0f;       // Avoidance weapon ref pool parking/expiry
+	float schedulerCombatScanRate = 10.0f;    // Combat target distance / close combat mode
+
+	// Body zones - Zone lines replace the default shoulder spheres (see BodyZones.h for the format)
+	std::vector<std::string> bodyZoneDefinitions;
+	float bodyZoneExitMargin = 3.0f;          // A controller leaves a zone this far outside its radius (hysteresis)
+
 	void loadConfig() 
 	{
 		std::string runtimeDirectory = GetRuntimeDirectory();
@@ -92,6 +121,9 @@ namespace FalseEdgeVR {
 				std::string line;
 				std::string currentSection;
 
+				// Zone lines accumulate - start from an empty list on every load
+				bodyZoneDefinitions.clear();
+
 				while (std::getline(file, line)) 
 				{
 					trim(line);
@@ -164,6 +196,34 @@ namespace FalseEdgeVR {
 						{
 							collisionAvoidanceHand = std::stoi(variableValueStr);
 						}
+						else if (variableName == "VelocitySource")
+						{
+							bladeVelocitySource = std::stoi(variableValueStr);
+						}
+						else if (variableName == "PredictionTime")
+						{
+							bladePredictionTime = std::stof(variableValueStr);
+						}
+						else if (variableName == "ConvexShapes")
+						{
+							bladeConvexShapes = (std::stoi(variableValueStr) != 0);
+						}
+						else if (variableName == "BladeProfiles")
+						{
+							useBladeProfiles = (std::stoi(variableValueStr) != 0);
+						}
+						else if (variableName == "MeshNarrowphase")
+						{
+							bladeMeshNarrowphase = (std::stoi(variableValueStr) != 0);
+						}
+						else if (variableName == "MeshBudget")
+						{
+							bladeMeshBudget = std::stoi(variableValueStr);
+						}
+						else if (variableName == "AutoCalibrate")
+						{
+							bladeAutoCalibrate = std::stoi(variableValueStr);
+						}
 					}
 					else if (currentSection == "AutoEquip")
 					{
@@ -242,6 +302,14 @@ namespace FalseEdgeVR {
 						{
 							spawnDistance = std::stof(variableValueStr);
 						}
+						else if (variableName == "RefPoolSize")
+						{
+							weaponRefPoolSize = std::stoi(variableValueStr);
+						}
+						else if (variableName == "RefPoolTimeout")
+						{
+							weaponRefPoolTimeout = std::stof(variableValueStr);
+						}
 					}
 					else if (currentSection == "WeaponSpawnMounted")
 					{
@@ -274,6 +342,18 @@ namespace FalseEdgeVR {
 						{
 							closeCombatExitDistance = std::stof(variableValueStr);
 						}
+						else if (variableName == "Enabled")
+						{
+							closeCombatEnabled = (std::stoi(variableValueStr) != 0);
+						}
+						else if (variableName == "HostileScanRadius")
+						{
+							closeCombatHostileScanRadius = std::stof(variableValueStr);
+						}
+						else if (variableName == "HostileScanBudget")
+						{
+							closeCombatHostileScanBudget = std::stoi(variableValueStr);
+						}
 					}
 					else if (currentSection == "ShieldCollision")
 					{
@@ -320,6 +400,10 @@ namespace FalseEdgeVR {
 						{
 							shieldRadius = std::stof(variableValueStr);
 						}
+						else if (variableName == "DistanceField")
+						{
+							shieldDistanceField = (std::stoi(variableValueStr) != 0);
+						}
 					}
 					else if (currentSection == "ShieldBash")
 					{
@@ -352,6 +436,58 @@ namespace FalseEdgeVR {
 						{
 							equipGraceFrames = std::stoi(variableValueStr);
 						}
+						else if (variableName == "Profiling")
+						{
+							collisionProfiling = (std::stoi(variableValueStr) != 0);
+						}
+					}
+					else if (currentSection == "Scheduler")
+					{
+						std::string variableName;
+						std::string variableValueStr = GetConfigSettingsStringValue(line, variableName);
+
+						if (variableName == "Enabled")
+						{
+							rateSchedulerEnabled = (std::stoi(variableValueStr) != 0);
+						}
+						else if (variableName == "BodyZoneRate")
+						{
+							schedulerBodyZoneRate = std::stof(variableValueStr);
+						}
+						else if (variableName == "AutoEquipRate")
+						{
+							schedulerAutoEquipRate = std::stof(variableValueStr);
+						}
+						else if (variableName == "ShieldBashRate")
+						{
+							schedulerShieldBashRate = std::stof(variableValueStr);
+						}
+						else if (variableName == "EquipConsistencyRate")
+						{
+							schedulerEquipConsistencyRate = std::stof(variableValueStr);
+						}
+						else if (variableName == "RefPoolRate")
+						{
+							schedulerRefPoolRate = std::stof(variableValueStr);
+						}
+						else if (variableName == "CombatScanRate")
+						{
+							schedulerCombatScanRate = std::stof(variableValueStr);
+						}
+					}
+					else if (currentSection == "BodyZones")
+					{
+						std::string variableName;
+						std::string variableValueStr = GetConfigSettingsStringValue(line, variableName);
+
+						if (variableName == "Zone")
+						{
+							bodyZoneDefinitions.push_back(variableValueStr);
+						}
+						else if (variableName == "ExitMargin")
+						{
+							bodyZoneExitMargin = std::stof(variableValueStr);
+						}
 					}
 				} 
 			}
@@ -365,6 +501,13 @@ namespace FalseEdgeVR {
 				bladeReequipCooldown, reequipDelay, swingVelocityThreshold);
 			_MESSAGE("  CollisionAvoidanceHand=%d (%s hand unequips during dual-wield collision)",
 				collisionAvoidanceHand, collisionAvoidanceHand == 0 ? "LEFT" : "RIGHT");
+			_MESSAGE("  VelocitySource=%d (%s)", bladeVelocitySource,
+				bladeVelocitySource == 1 ? "OpenVR controller" : (bladeVelocitySource == 2 ? "HIGGS rigid body" : "finite difference"));
+			_MESSAGE("  PredictionTime=%.3f%s", bladePredictionTime, bladePredictionTime > 0.0f ? "" : " (disabled)");
+			_MESSAGE("  ConvexShapes=%s, BladeProfiles=%s", bladeConvexShapes ? "true" : "false", useBladeProfiles ? "true" : "false");
+			_MESSAGE("  MeshNarrowphase=%s, MeshBudget=%d", bladeMeshNarrowphase ? "true" : "false", bladeMeshBudget);
+			_MESSAGE("  AutoCalibrate=%d (%s)", bladeAutoCalibrate,
+				bladeAutoCalibrate == 2 ? "apply" : (bladeAutoCalibrate == 1 ? "suggest" : "off"));
 			_MESSAGE("AutoEquip settings: Enabled=%s, Delay=%.2f",
 				autoEquipGrabbedWeaponEnabled ? "true" : "false", autoEquipGrabbedWeaponDelay);
 			_MESSAGE("TriggerHold settings: UnequipDelay=%.3f",
@@ -375,10 +518,13 @@ namespace FalseEdgeVR {
 				triggerSpamThreshold, triggerSpamWindow);
 			_MESSAGE("WeaponSpawn settings: Distance=%.1f, OffsetX=%.1f, OffsetY=%.1f, OffsetZ=%.1f",
 				spawnDistance, spawnOffsetX, spawnOffsetY, spawnOffsetZ);
+			_MESSAGE("  RefPoolSize=%d%s, RefPoolTimeout=%.1f",
+				weaponRefPoolSize, weaponRefPoolSize > 0 ? "" : " (disabled)", weaponRefPoolTimeout);
 			_MESSAGE("WeaponSpawnMounted settings: OffsetX=%.1f, OffsetY=%.1f, OffsetZ=%.1f",
 				spawnOffsetMountedX, spawnOffsetMountedY, spawnOffsetMountedZ);
-			_MESSAGE("CloseCombat settings: EnterDistance=%.1f, ExitDistance=%.1f",
-				closeCombatEnterDistance, closeCombatExitDistance);
+			_MESSAGE("CloseCombat settings: Enabled=%s, EnterDistance=%.1f, ExitDistance=%.1f",
+				closeCombatEnabled ? "true" : "false", closeCombatEnterDistance, closeCombatExitDistance);
+			_MESSAGE("  HostileScanRadius=%.0f, HostileScanBudget=%d", closeCombatHostileScanRadius, closeCombatHostileScanBudget);
 			_MESSAGE("ShieldCollision settings:");
 			_MESSAGE("  CollisionThreshold=%.2f, ImminentThreshold=%.2f, ImminentThresholdBackup=%.2f",
 				shieldCollisionThreshold, shieldImminentThreshold, shieldImminentThresholdBackup);
@@ -386,9 +532,16 @@ namespace FalseEdgeVR {
 				shieldReequipThreshold, shieldCollisionTimeout, shieldTimeToCollisionThreshold);
 			_MESSAGE("  ReequipCooldown=%.3f, ReequipDelay=%.4f, SwingVelocityThreshold=%.1f, ShieldRadius=%.1f",
 				shieldReequipCooldown, shieldReequipDelay, shieldSwingVelocityThreshold, shieldRadius);
+			_MESSAGE("  DistanceField=%s", shieldDistanceField ? "true" : "false");
 			_MESSAGE("ShieldBash settings: Enabled=%s, BashThreshold=%d, BashWindow=%.1f, LockoutDuration=%.0f",
 				shieldBashEnabled ? "true" : "false", shieldBashThreshold, shieldBashWindow, shieldBashLockoutDuration);
-			_MESSAGE("General settings: EquipGraceFrames=%d", equipGraceFrames);
+			_MESSAGE("General settings: EquipGraceFrames=%d, Profiling=%s", equipGraceFrames, collisionProfiling ? "true" : "false");
+			_MESSAGE("Scheduler settings: Enabled=%s, BodyZoneRate=%.0f, AutoEquipRate=%.0f, ShieldBashRate=%.0f",
+				rateSchedulerEnabled ? "true" : "false", schedulerBodyZoneRate, schedulerAutoEquipRate, schedulerShieldBashRate);
+			_MESSAGE("  EquipConsistencyRate=%.0f, RefPoolRate=%.0f, CombatScanRate=%.0f",
+				schedulerEquipConsistencyRate, schedulerRefPoolRate, schedulerCombatScanRate);
+			_MESSAGE("BodyZones settings: %d Zone line(s)%s, ExitMargin=%.1f",
+				(int)bodyZoneDefinitions.size(), bodyZoneDefinitions.empty() ? " (default shoulder zones)" : "", bodyZoneExitMargin);
 			return;
 		}
 		return;
@@ -35,6 +35,13 @@ namespace FalseEdgeVR {
 	extern float bladeReequipCooldown;          // Cooldown after re-equip before another unequip can trigger
 	extern float reequipDelay;                  // Delay after activating weapon before equipping
 	extern float swingVelocityThreshold;     // Swing velocity threshold
+	extern int bladeVelocitySource;             // 0 = finite difference, 1 = OpenVR controller, 2 = HIGGS rigid body
+	extern float bladePredictionTime;           // Seconds ahead to predict controller poses for imminent detection (0 = off)
+	extern bool bladeConvexShapes;              // Per-type weapon shapes (mace head, axe bit) on top of the blade segment
+	extern bool useBladeProfiles;               // Blade length / shield radius from FalseEdgeVR_BladeProfiles.bin (tools/NifProfiler)
+	extern bool bladeMeshNarrowphase;           // Triangle mesh distance once the blade segments are within ImminentThreshold
+	extern int bladeMeshBudget;                 // Triangle pair tests per frame for the mesh narrowphase
+	extern int bladeAutoCalibrate;              // 0 = off, 1 = log suggested thresholds, 2 = apply them (ThresholdCalibration)
 	
 	// Auto-equip grabbed weapon settings
 	extern bool autoEquipGrabbedWeaponEnabled;  // Enable/disable auto-equip feature
@@ -58,6 +65,8 @@ namespace FalseEdgeVR {
 	extern float spawnOffsetY;      // Y offset from player (negative = behind based on facing)
 	extern float spawnOffsetZ;           // Z offset from player (negative = below)
 	extern float spawnDistance; // Distance behind player (units, 70 = ~1 meter)
+	extern int weaponRefPoolSize;               // Max pooled world refs per weapon FormID (0 = spawn/delete every time)
+	extern float weaponRefPoolTimeout;          // Seconds an unused pooled ref is kept before deletion
 	
 	// Mounted: spawn elevated to avoid horse collision
 	extern float spawnOffsetMountedX;  // X offset when mounted
@@ -70,6 +79,9 @@ namespace FalseEdgeVR {
 	// Close combat settings
 	extern float closeCombatEnterDistance;      // Distance to enemy at which close combat mode activates
 	extern float closeCombatExitDistance;       // Distance to enemy at which close combat mode deactivates (buffer)
+	extern bool closeCombatEnabled;             // Track combat distance and enter close combat mode
+	extern float closeCombatHostileScanRadius;  // Hostiles further than this are not tracked
+	extern int closeCombatHostileScanBudget;    // Max refs examined per combat scan
 
 	// Shield collision settings
 	extern float shieldCollisionThreshold;       // Distance at which weapon is considered touching shield
@@ -82,6 +94,7 @@ namespace FalseEdgeVR {
 	extern float shieldReequipDelay;     // Delay after activating weapon before equipping
 	extern float shieldSwingVelocityThreshold;   // Swing velocity threshold for shield collision
 	extern float shieldRadius;     // Shield face detection radius
+	extern bool shieldDistanceField;           // Use the shield mesh's distance field instead of the disc
 
 	// Shield bash settings
 	extern bool shieldBashEnabled;
@@ -92,6 +105,22 @@ namespace FalseEdgeVR {
 	// Equipment change grace period
 	extern int equipGraceFrames;
 
+	// [General] Profiling - time collision queries and run the reference queries they are compared against (off by default)
+	extern bool collisionProfiling;
+
+	// Rate-group scheduler (Hz, 0 = every physics step)
+	extern bool rateSchedulerEnabled;            // Run the groups below at their own rate instead of every physics step
+	extern float schedulerBodyZoneRate;          // Controller-to-body-zone tests
+	extern float schedulerAutoEquipRate;         // Grabbed weapon auto-equip delay
+	extern float schedulerShieldBashRate;        // Shield bash window/lockout timers
+	extern float schedulerEquipConsistencyRate;  // Equipment changes without an equip event
+	extern float schedulerRefPoolRate;           // Avoidance weapon ref pool parking/expiry
+	extern float schedulerCombatScanRate;        // Combat target distance / close combat mode
+
+	// Body zones
+	extern std::vector<std::string> bodyZoneDefinitions; // [BodyZones] Zone lines, parsed by BodyZoneSystem::LoadZones
+	extern float bodyZoneExitMargin;             // A controller leaves a zone this far outside its radius (hysteresis)
+
 	// Load configuration from INI file
 	void loadConfig();
 	
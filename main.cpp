@@ -12,6 +12,10 @@
 #include "ShieldCollision.h"
 #include "DaggerFlipTracker.h"
 #include "ActivateHook.h"
+#include "TrackingDormancy.h"
+#include "BodyZones.h"
+#include "WeaponProfileDB.h"
+#include "ThresholdCalibration.h"
 #include "skse64/GameEvents.h"
 #include "skse64/GameMenus.h"
 #include "skse64/PapyrusEvents.h"
@@ -123,12 +127,19 @@ namespace FalseEdgeVR
 				}
 			}
 
+			// Calibration state is written here rather than from the collision step that learned it
+			if (evn->opening)
+			{
+				FalseEdgeVR::ThresholdCalibration::GetSingleton()->FlushSave();
+			}
+
 			// Maintain existing hot-reload behavior for Main Menu close
 			BSFixedString mainMenu("Main Menu");
 			if (evn->menuName == mainMenu && !evn->opening)
 			{
 				_MESSAGE("=== Main Menu Closed - Hot reloading config ===");
 				FalseEdgeVR::loadConfig();
+				FalseEdgeVR::ThresholdCalibration::GetSingleton()->OnConfigLoaded();
 				_MESSAGE("=== Config hot reload complete ===");
 			}
 
@@ -192,6 +203,13 @@ namespace FalseEdgeVR
 			if (!evn->actor || evn->actor != *g_thePlayer)
 				return kEvent_Continue;
 
+			// Drawing a weapon/shield wakes dormant collision tracking
+			if (evn->type == SKSEActionEvent::kType_BeginDraw)
+			{
+				TrackingDormancy::GetSingleton()->Wake("draw");
+				return kEvent_Continue;
+			}
+
 			// Only track weapon swing events
 			if (evn->type != SKSEActionEvent::kType_WeaponSwing)
 				return kEvent_Continue;
@@ -408,6 +426,18 @@ namespace FalseEdgeVR
 				{
 					FalseEdgeVR::loadConfig();
 
+					// All plugins (and the SkyrimVRESL light plugin collection) are loaded now
+					BuildModNameIndex();
+
+					// [BodyZones] from the config just loaded
+					FalseEdgeVR::BodyZoneSystem::GetSingleton()->LoadZones();
+
+					// Per-weapon profiles - needs the plugin list above
+					FalseEdgeVR::WeaponProfileDB::GetSingleton()->Load();
+
+					// Learned blade thresholds on top of the config just loaded
+					FalseEdgeVR::ThresholdCalibration::GetSingleton()->Load();
+
 					// NEW SKSEVR feature: trampoline interface object from QueryInterface() - Use SKSE existing process code memory pool - allow Skyrim to run without ASLR
 					if (FalseEdgeVR::g_trampolineInterface)
 					{
@@ -0,0 +1,1470 @@
+// ============================================
+// NifProfiler
+// ============================================
+// Offline blade profile generator for FalseEdgeVR. Reads the WEAP and shield
+// ARMO records of every plugin in a Skyrim Data directory, finds their loose
+// meshes under Data/meshes, fits a profile to each mesh (length, pommel offset,
+// guard, edge width/thickness, curvature, mace head/axe bit, shield face radius)
+// plus a welded triangle mesh for the precise narrowphase (and a signed
+// distance field for shields), and writes the profile database (BladeProfileFormat.h) keyed by plugin + FormID,
+// with a minimal perfect hash so the plugin can look records up in place.
+// Plugins and meshes are processed in parallel on all cores.
+//
+// Standalone - not part of the plugin project. Build on Linux with:
+//   g++ -O2 -std=c++17 -pthread NifProfiler.cpp -o NifProfiler
+//
+// Usage:
+//   NifProfiler <Data dir> [output] [--threads N] [--load-order plugins.txt]
+// The output defaults to <Data dir>/SKSE/Plugins/FalseEdgeVR_BladeProfiles.bin.
+//
+// Limits: loose meshes only (meshes packed in BSAs are counted as missing),
+// compressed records are skipped, one-handed weapons and shields only (the
+// plugin doesn't track anything else). NIF 20.2.0.7 only: Skyrim SE/VR BSTriShape
+// meshes and original Skyrim NiTriShape meshes.
+// ============================================
+
+#include "../../BladeProfileFormat.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace FalseEdgeVR;
+
+namespace
+{
+    // WeaponType values (EquipManager.h)
+    const uint8_t kWeaponType_None = 0;
+    const uint8_t kWeaponType_Sword = 1;
+    const uint8_t kWeaponType_Dagger = 2;
+    const uint8_t kWeaponType_Mace = 3;
+    const uint8_t kWeaponType_Axe = 4;
+    const uint8_t kWeaponType_Shield = 5;
+
+    std::string ToLower(std::string s)
+    {
+        std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+        return s;
+    }
+
+    bool ReadFileBytes(const fs::path& path, std::vector<uint8_t>& out)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+            return false;
+        std::streamsize size = file.tellg();
+        if (size < 0)
+            return false;
+        out.resize((size_t)size);
+        file.seekg(0);
+        return size == 0 || (bool)file.read((char*)out.data(), size);
+    }
+
+    // Bounds-checked little-endian reader - any overrun sets ok = false and reads zeros
+    struct Reader
+    {
+        const uint8_t* data;
+        size_t size;
+        size_t pos = 0;
+        bool ok = true;
+
+        Reader(const uint8_t* d, size_t s) : data(d), size(s) {}
+
+        bool Has(size_t n) const { return ok && pos + n <= size; }
+
+        template <typename T>
+        T Get()
+        {
+            T value{};
+            if (!Has(sizeof(T)))
+            {
+                ok = false;
+                return value;
+            }
+            std::memcpy(&value, data + pos, sizeof(T));
+            pos += sizeof(T);
+            return value;
+        }
+
+        void Skip(size_t n)
+        {
+            if (!Has(n))
+            {
+                ok = false;
+                return;
+            }
+            pos += n;
+        }
+
+        std::string Chars(size_t n)
+        {
+            if (!Has(n))
+            {
+                ok = false;
+                return std::string();
+            }
+            std::string s((const char*)data + pos, n);
+            pos += n;
+            return s;
+        }
+
+        // Zero-terminated string inside a fixed-size field
+        static std::string ZString(const uint8_t* d, size_t n)
+        {
+            size_t len = 0;
+            while (len < n && d[len] != 0)
+                len++;
+            return std::string((const char*)d, len);
+        }
+    };
+
+    template <typename Fn>
+    void ParallelFor(size_t count, unsigned threadCount, Fn fn)
+    {
+        std::atomic<size_t> next(0);
+        std::vector<std::thread> threads;
+        unsigned workers = (unsigned)std::min<size_t>(threadCount, count);
+        for (unsigned t = 0; t < workers; t++)
+        {
+            threads.emplace_back([&]() {
+                size_t i;
+                while ((i = next.fetch_add(1)) < count)
+                    fn(i);
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    // ============================================
+    // Plugins
+    // ============================================
+
+    struct WeaponForm
+    {
+        std::string owner;          // Plugin that defines the form
+        uint32_t formID = 0;        // As stored in the defining/overriding plugin
+        std::string modelPath;      // "meshes/weapons/iron/ironsword.nif"
+        std::string editorID;
+        float reach = 1.0f;
+        uint8_t weaponType = kWeaponType_None;
+    };
+
+    struct Plugin
+    {
+        std::string name;
+        fs::path path;
+        bool light = false;
+        bool parsed = false;
+        std::vector<std::string> masters;
+        std::vector<WeaponForm> weapons;
+        int compressedSkipped = 0;
+    };
+
+    uint8_t WeaponTypeFromAnimType(uint8_t animType)
+    {
+        switch (animType)
+        {
+        case 1: return kWeaponType_Sword;
+        case 2: return kWeaponType_Dagger;
+        case 3: return kWeaponType_Axe;
+        case 4: return kWeaponType_Mace;
+        default: return kWeaponType_None;     // Hand to hand, two-handed, bows, staves
+        }
+    }
+
+    std::string NormalizeModelPath(const std::string& model)
+    {
+        std::string path = ToLower(model);
+        std::replace(path.begin(), path.end(), '\\', '/');
+        while (!path.empty() && path[0] == '/')
+            path.erase(0, 1);
+        if (path.compare(0, 7, "meshes/") != 0)
+            path = "meshes/" + path;
+        return path;
+    }
+
+    // WEAP: MODL + DNAM animation type. ARMO: shields only (biped slot 39), world model MOD2
+    void ParseFormRecord(Plugin& plugin, bool isArmor, uint32_t formID, const uint8_t* data, size_t size)
+    {
+        WeaponForm form;
+        form.formID = formID;
+
+        uint8_t animType = 0xFF;
+        uint32_t bipedSlots = 0;
+        size_t pos = 0;
+        uint32_t bigSize = 0;
+        while (pos + 6 <= size)
+        {
+            char type[5] = {};
+            std::memcpy(type, data + pos, 4);
+            uint32_t fieldSize = *(const uint16_t*)(data + pos + 4);
+            pos += 6;
+            if (bigSize)
+            {
+                fieldSize = bigSize;
+                bigSize = 0;
+            }
+            if (pos + fieldSize > size)
+                break;
+
+            const uint8_t* field = data + pos;
+            if (std::strcmp(type, "XXXX") == 0 && fieldSize == 4)
+                bigSize = *(const uint32_t*)field;
+            else if (std::strcmp(type, "EDID") == 0)
+                form.editorID = Reader::ZString(field, fieldSize);
+            else if (std::strcmp(type, isArmor ? "MOD2" : "MODL") == 0)
+                form.modelPath = NormalizeModelPath(Reader::ZString(field, fieldSize));
+            else if (std::strcmp(type, "DNAM") == 0 && fieldSize >= 12)
+            {
+                animType = field[0];
+                std::memcpy(&form.reach, field + 8, sizeof(float));
+            }
+            else if ((std::strcmp(type, "BOD2") == 0 || std::strcmp(type, "BODT") == 0) && fieldSize >= 4)
+                std::memcpy(&bipedSlots, field, sizeof(uint32_t));
+            pos += fieldSize;
+        }
+
+        if (isArmor)
+            form.weaponType = (bipedSlots & (1u << 9)) ? kWeaponType_Shield : kWeaponType_None;
+        else
+            form.weaponType = WeaponTypeFromAnimType(animType);
+        if (form.modelPath.empty() || form.weaponType == kWeaponType_None)
+            return;
+
+        uint32_t masterIndex = formID >> 24;
+        form.owner = masterIndex < plugin.masters.size() ? plugin.masters[masterIndex] : plugin.name;
+        plugin.weapons.push_back(std::move(form));
+    }
+
+    bool ParsePlugin(Plugin& plugin)
+    {
+        std::vector<uint8_t> bytes;
+        if (!ReadFileBytes(plugin.path, bytes))
+            return false;
+
+        Reader r(bytes.data(), bytes.size());
+
+        // TES4 header record: masters and the light flag
+        std::string type = r.Chars(4);
+        uint32_t dataSize = r.Get<uint32_t>();
+        uint32_t flags = r.Get<uint32_t>();
+        r.Skip(12);
+        if (!r.ok || type != "TES4" || !r.Has(dataSize))
+            return false;
+
+        if ((flags & 0x200) != 0)
+            plugin.light = true;
+
+        size_t headerEnd = r.pos + dataSize;
+        while (r.pos + 6 <= headerEnd)
+        {
+            std::string fieldType = r.Chars(4);
+            uint16_t fieldSize = r.Get<uint16_t>();
+            if (!r.Has(fieldSize))
+                return false;
+            if (fieldType == "MAST")
+                plugin.masters.push_back(Reader::ZString(r.data + r.pos, fieldSize));
+            r.Skip(fieldSize);
+        }
+        r.pos = headerEnd;
+
+        // Top-level groups - only WEAP and ARMO are opened
+        while (r.Has(24))
+        {
+            size_t groupStart = r.pos;
+            std::string groupType = r.Chars(4);
+            uint32_t groupSize = r.Get<uint32_t>();
+            std::string label = r.Chars(4);
+            int32_t kind = r.Get<int32_t>();
+            r.Skip(8);
+            if (groupType != "GRUP" || groupSize < 24 || groupStart + groupSize > bytes.size())
+                return false;
+
+            size_t groupEnd = groupStart + groupSize;
+            if ((label == "WEAP" || label == "ARMO") && kind == 0)
+            {
+                while (r.pos + 24 <= groupEnd)
+                {
+                    std::string recordType = r.Chars(4);
+                    uint32_t recordSize = r.Get<uint32_t>();
+                    uint32_t recordFlags = r.Get<uint32_t>();
+                    uint32_t formID = r.Get<uint32_t>();
+                    r.Skip(8);
+                    if (!r.Has(recordSize))
+                        return false;
+
+                    if (recordType == label && (recordFlags & 0x20) == 0)
+                    {
+                        if (recordFlags & 0x40000)
+                            plugin.compressedSkipped++;
+                        else
+                            ParseFormRecord(plugin, label == "ARMO", formID, r.data + r.pos, recordSize);
+                    }
+                    r.Skip(recordSize);
+                }
+            }
+            r.pos = groupEnd;
+        }
+
+        plugin.parsed = true;
+        return true;
+    }
+
+    // Load order: plugins.txt if given, otherwise base game masters, .esm/.esl, then .esp by name
+    std::vector<Plugin> FindPlugins(const fs::path& dataDir, const std::string& loadOrderFile)
+    {
+        static const char* kBaseMasters[] = { "skyrim.esm", "update.esm", "dawnguard.esm", "hearthfires.esm", "dragonborn.esm", "skyrimvr.esm" };
+
+        std::unordered_map<std::string, fs::path> onDisk;
+        for (const auto& entry : fs::directory_iterator(dataDir))
+        {
+            if (!entry.is_regular_file())
+                continue;
+            std::string ext = ToLower(entry.path().extension().string());
+            if (ext == ".esm" || ext == ".esp" || ext == ".esl")
+                onDisk[ToLower(entry.path().filename().string())] = entry.path();
+        }
+
+        std::vector<std::string> order;
+        std::unordered_set<std::string> added;
+        auto add = [&](const std::string& name) {
+            std::string key = ToLower(name);
+            if (onDisk.count(key) && added.insert(key).second)
+                order.push_back(key);
+        };
+
+        for (const char* master : kBaseMasters)
+            add(master);
+
+        if (!loadOrderFile.empty())
+        {
+            std::ifstream file(loadOrderFile);
+            std::string line;
+            while (std::getline(file, line))
+            {
+                if (!line.empty() && line.back() == '\r')
+                    line.pop_back();
+                if (line.empty() || line[0] == '#')
+                    continue;
+                if (line[0] == '*')
+                    line.erase(0, 1);
+                add(line);
+            }
+        }
+        else
+        {
+            std::vector<std::string> masters, plugins;
+            for (const auto& entry : onDisk)
+            {
+                std::string ext = fs::path(entry.first).extension().string();
+                (ext == ".esp" ? plugins : masters).push_back(entry.first);
+            }
+            std::sort(masters.begin(), masters.end());
+            std::sort(plugins.begin(), plugins.end());
+            for (const auto& name : masters)
+                add(name);
+            for (const auto& name : plugins)
+                add(name);
+        }
+
+        std::vector<Plugin> result;
+        for (const auto& key : order)
+        {
+            Plugin plugin;
+            plugin.path = onDisk[key];
+            plugin.name = plugin.path.filename().string();
+            plugin.light = fs::path(key).extension() == ".esl";
+            result.push_back(std::move(plugin));
+        }
+        return result;
+    }
+
+    // ============================================
+    // NIF
+    // ============================================
+
+    struct Vec3
+    {
+        float x = 0.0f, y = 0.0f, z = 0.0f;
+    };
+
+    struct Transform
+    {
+        float rot[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+        Vec3 trans;
+        float scale = 1.0f;
+
+        Vec3 Apply(const Vec3& p) const
+        {
+            Vec3 out;
+            out.x = (rot[0][0] * p.x + rot[0][1] * p.y + rot[0][2] * p.z) * scale + trans.x;
+            out.y = (rot[1][0] * p.x + rot[1][1] * p.y + rot[1][2] * p.z) * scale + trans.y;
+            out.z = (rot[2][0] * p.x + rot[2][1] * p.y + rot[2][2] * p.z) * scale + trans.z;
+            return out;
+        }
+
+        // this * child
+        Transform Compose(const Transform& child) const
+        {
+            Transform out;
+            for (int i = 0; i < 3; i++)
+                for (int j = 0; j < 3; j++)
+                    out.rot[i][j] = rot[i][0] * child.rot[0][j] + rot[i][1] * child.rot[1][j] + rot[i][2] * child.rot[2][j];
+            out.scale = scale * child.scale;
+            out.trans = Apply(child.trans);
+            return out;
+        }
+    };
+
+    struct NifFile
+    {
+        uint32_t bsVersion = 0;
+        std::vector<std::string> blockTypes;
+        std::vector<uint16_t> blockTypeIndex;
+        std::vector<size_t> blockOffsets;
+        std::vector<uint32_t> blockSizes;
+        std::vector<std::string> strings;
+        std::vector<uint8_t> bytes;
+
+        const std::string& TypeOf(int block) const { return blockTypes[blockTypeIndex[block]]; }
+    };
+
+    struct MeshResult
+    {
+        std::vector<Vec3> points;
+        std::vector<uint32_t> triangles;    // Indices into points, 3 per triangle
+        bool legacy = false;
+        std::string error;
+    };
+
+    bool ReadNifHeader(NifFile& nif, std::string& error)
+    {
+        Reader r(nif.bytes.data(), nif.bytes.size());
+
+        std::string line;
+        while (r.Has(1) && line.size() < 128)
+        {
+            char c = (char)r.Get<uint8_t>();
+            if (c == '\n')
+                break;
+            line.push_back(c);
+        }
+        if (line.compare(0, 20, "Gamebryo File Format") != 0)
+        {
+            error = "not a NIF";
+            return false;
+        }
+
+        uint32_t version = r.Get<uint32_t>();
+        r.Skip(1);  // Endian
+        uint32_t userVersion = r.Get<uint32_t>();
+        uint32_t blockCount = r.Get<uint32_t>();
+        if (version != 0x14020007 || userVersion < 10)
+        {
+            error = "unsupported NIF version";
+            return false;
+        }
+
+        nif.bsVersion = r.Get<uint32_t>();
+        if (nif.bsVersion != 83 && nif.bsVersion != 100)
+        {
+            error = "not a Skyrim NIF";
+            return false;
+        }
+        for (int i = 0; i < 3; i++)         // Author, process script, export script
+            r.Skip(r.Get<uint8_t>());
+
+        uint16_t typeCount = r.Get<uint16_t>();
+        for (uint16_t i = 0; i < typeCount && r.ok; i++)
+            nif.blockTypes.push_back(r.Chars(r.Get<uint32_t>()));
+
+        nif.blockTypeIndex.resize(blockCount);
+        for (uint32_t i = 0; i < blockCount; i++)
+            nif.blockTypeIndex[i] = r.Get<uint16_t>() & 0x7FFF;
+
+        nif.blockSizes.resize(blockCount);
+        for (uint32_t i = 0; i < blockCount; i++)
+            nif.blockSizes[i] = r.Get<uint32_t>();
+
+        uint32_t stringCount = r.Get<uint32_t>();
+        r.Skip(4);  // Max string length
+        for (uint32_t i = 0; i < stringCount && r.ok; i++)
+            nif.strings.push_back(r.Chars(r.Get<uint32_t>()));
+
+        uint32_t groupCount = r.Get<uint32_t>();
+        r.Skip((size_t)groupCount * 4);
+
+        if (!r.ok)
+        {
+            error = "truncated header";
+            return false;
+        }
+
+        size_t offset = r.pos;
+        nif.blockOffsets.resize(blockCount);
+        for (uint32_t i = 0; i < blockCount; i++)
+        {
+            if (nif.blockTypeIndex[i] >= nif.blockTypes.size())
+            {
+                error = "bad block type index";
+                return false;
+            }
+            nif.blockOffsets[i] = offset;
+            offset += nif.blockSizes[i];
+        }
+        if (offset > nif.bytes.size())
+        {
+            error = "truncated blocks";
+            return false;
+        }
+        return true;
+    }
+
+    bool IsNodeType(const std::string& type)
+    {
+        static const std::unordered_set<std::string> kNodeTypes = {
+            "NiNode", "BSFadeNode", "BSLeafAnimNode", "BSMultiBoundNode", "BSOrderedNode", "BSValueNode",
+            "BSBlastNode", "BSDamageStage", "BSDebrisNode", "NiSwitchNode", "NiLODNode", "BSRangeNode", "NiBillboardNode"
+        };
+        return kNodeTypes.count(type) != 0;
+    }
+
+    bool IsTriShapeType(const std::string& type)
+    {
+        return type == "BSTriShape" || type == "BSSubIndexTriShape" || type == "BSMeshLODTriShape" || type == "BSLODTriShape";
+    }
+
+    // NiObjectNET + NiAVObject; returns the block's name
+    std::string ReadAVObject(Reader& r, const NifFile& nif, Transform& local)
+    {
+        int32_t nameIndex = r.Get<int32_t>();
+        r.Skip((size_t)r.Get<uint32_t>() * 4);    // Extra data refs
+        r.Skip(4);                                  // Controller
+        r.Skip(4);                                  // Flags (uint since BS version 26)
+        local.trans.x = r.Get<float>();
+        local.trans.y = r.Get<float>();
+        local.trans.z = r.Get<float>();
+        for (int i = 0; i < 3; i++)
+            for (int j = 0; j < 3; j++)
+                local.rot[i][j] = r.Get<float>();
+        local.scale = r.Get<float>();
+        r.Skip(4);                                  // Collision object
+        return (nameIndex >= 0 && (size_t)nameIndex < nif.strings.size()) ? nif.strings[nameIndex] : std::string();
+    }
+
+    bool IsScabbard(const std::string& name)
+    {
+        return ToLower(name).compare(0, 3, "scb") == 0;
+    }
+
+    void CollectBlock(const NifFile& nif, int block, const Transform& parent, int depth, std::vector<bool>& visited, MeshResult& out)
+    {
+        if (block < 0 || (size_t)block >= nif.blockOffsets.size() || visited[block] || depth > 64)
+            return;
+        visited[block] = true;
+
+        const std::string& type = nif.TypeOf(block);
+        Reader r(nif.bytes.data() + nif.blockOffsets[block], nif.blockSizes[block]);
+
+        if (IsNodeType(type))
+        {
+            Transform local;
+            std::string name = ReadAVObject(r, nif, local);
+            if (IsScabbard(name))
+                return;
+
+            Transform world = parent.Compose(local);
+            uint32_t childCount = r.Get<uint32_t>();
+            std::vector<int32_t> children;
+            for (uint32_t i = 0; i < childCount && r.ok; i++)
+                children.push_back(r.Get<int32_t>());
+            if (!r.ok)
+                return;
+            for (int32_t child : children)
+                CollectBlock(nif, child, world, depth + 1, visited, out);
+        }
+        else if (IsTriShapeType(type))
+        {
+            Transform local;
+            std::string name = ReadAVObject(r, nif, local);
+            if (IsScabbard(name))
+                return;
+
+            Transform world = parent.Compose(local);
+            r.Skip(16);                             // Bounding sphere
+            r.Skip(12);                             // Skin, shader property, alpha property
+            uint64_t vertexDesc = r.Get<uint64_t>();
+            uint16_t triangleCount = r.Get<uint16_t>();
+            uint16_t vertexCount = r.Get<uint16_t>();
+            uint32_t dataSize = r.Get<uint32_t>();
+
+            size_t stride = (size_t)(vertexDesc & 0xF) * 4;
+            uint32_t attributes = (uint32_t)(vertexDesc >> 44);
+            if (!r.ok || dataSize == 0 || stride < 12 || (attributes & 0x1) == 0)
+                return;
+
+            // SSE vertices always start with a full precision position
+            uint32_t firstVertex = (uint32_t)out.points.size();
+            for (uint16_t i = 0; i < vertexCount; i++)
+            {
+                size_t start = r.pos + (size_t)i * stride;
+                if (start + 12 > r.size)
+                    return;
+                Vec3 p;
+                std::memcpy(&p, r.data + start, 12);
+                out.points.push_back(world.Apply(p));
+            }
+
+            // Triangles follow the vertex data
+            r.Skip((size_t)vertexCount * stride);
+            for (uint16_t i = 0; i < triangleCount && r.Has(6); i++)
+            {
+                uint16_t v0 = r.Get<uint16_t>(), v1 = r.Get<uint16_t>(), v2 = r.Get<uint16_t>();
+                if (v0 < vertexCount && v1 < vertexCount && v2 < vertexCount)
+                {
+                    out.triangles.push_back(firstVertex + v0);
+                    out.triangles.push_back(firstVertex + v1);
+                    out.triangles.push_back(firstVertex + v2);
+                }
+            }
+        }
+        else if (type == "NiTriShape" || type == "NiTriStrips")
+        {
+            Transform local;
+            std::string name = ReadAVObject(r, nif, local);
+            if (IsScabbard(name))
+                return;
+
+            Transform world = parent.Compose(local);
+            int32_t dataBlock = r.Get<int32_t>();
+            if (!r.ok || dataBlock < 0 || (size_t)dataBlock >= nif.blockOffsets.size())
+                return;
+
+            const std::string& dataType = nif.TypeOf(dataBlock);
+            if (dataType != "NiTriShapeData" && dataType != "NiTriStripsData")
+                return;
+
+            Reader d(nif.bytes.data() + nif.blockOffsets[dataBlock], nif.blockSizes[dataBlock]);
+            d.Skip(4);                              // Group ID
+            uint16_t vertexCount = d.Get<uint16_t>();
+            d.Skip(2);                              // Keep/compress flags
+            uint8_t hasVertices = d.Get<uint8_t>();
+            if (!d.ok || !hasVertices)
+                return;
+
+            uint32_t firstVertex = (uint32_t)out.points.size();
+            for (uint16_t i = 0; i < vertexCount && d.ok; i++)
+            {
+                Vec3 p;
+                p.x = d.Get<float>();
+                p.y = d.Get<float>();
+                p.z = d.Get<float>();
+                if (d.ok)
+                    out.points.push_back(world.Apply(p));
+            }
+            out.legacy = true;
+            if (!d.ok || dataType != "NiTriShapeData")
+                return;
+
+            // NiGeometryData tail (Skyrim layout), then the triangle list
+            uint16_t vectorFlags = d.Get<uint16_t>();
+            if (d.Get<uint8_t>())                                           // Has normals
+                d.Skip((size_t)vertexCount * ((vectorFlags & 0x1000) ? 36 : 12));
+            d.Skip(16);                                                     // Bound center + radius
+            if (d.Get<uint8_t>())                                           // Has vertex colors
+                d.Skip((size_t)vertexCount * 16);
+            if (vectorFlags & 0x1)                                          // UV set
+                d.Skip((size_t)vertexCount * 8);
+            d.Skip(6);                                                      // Consistency flags, additional data
+            uint16_t triangleCount = d.Get<uint16_t>();
+            d.Skip(4);                                                      // Triangle point count
+            if (!d.Get<uint8_t>())                                          // Has triangles
+                return;
+            for (uint16_t i = 0; i < triangleCount && d.Has(6); i++)
+            {
+                uint16_t v0 = d.Get<uint16_t>(), v1 = d.Get<uint16_t>(), v2 = d.Get<uint16_t>();
+                if (v0 < vertexCount && v1 < vertexCount && v2 < vertexCount)
+                {
+                    out.triangles.push_back(firstVertex + v0);
+                    out.triangles.push_back(firstVertex + v1);
+                    out.triangles.push_back(firstVertex + v2);
+                }
+            }
+        }
+    }
+
+    MeshResult LoadMesh(const fs::path& path)
+    {
+        MeshResult result;
+        NifFile nif;
+        if (!ReadFileBytes(path, nif.bytes))
+        {
+            result.error = "unreadable";
+            return result;
+        }
+        if (!ReadNifHeader(nif, result.error))
+            return result;
+        if (nif.blockOffsets.empty() || !IsNodeType(nif.TypeOf(0)))
+        {
+            result.error = "no root node";
+            return result;
+        }
+
+        // The root's own transform places the mesh in the world - weapon space is the root's space
+        std::vector<bool> visited(nif.blockOffsets.size(), false);
+        Reader r(nif.bytes.data() + nif.blockOffsets[0], nif.blockSizes[0]);
+        Transform rootLocal;
+        ReadAVObject(r, nif, rootLocal);
+        uint32_t childCount = r.Get<uint32_t>();
+        std::vector<int32_t> children;
+        for (uint32_t i = 0; i < childCount && r.ok; i++)
+            children.push_back(r.Get<int32_t>());
+        visited[0] = true;
+        for (int32_t child : children)
+            CollectBlock(nif, child, Transform(), 1, visited, result);
+
+        if (result.points.empty())
+            result.error = "no geometry";
+        return result;
+    }
+
+    // ============================================
+    // Blade fit
+    // ============================================
+
+    float Median(std::vector<float>& values)
+    {
+        if (values.empty())
+            return 0.0f;
+        std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+        return values[values.size() / 2];
+    }
+
+    // Shields face -Z of the SHIELD node: the face radius is measured in the XY plane.
+    // 90th percentile rather than the rim so the odd spike or boss doesn't inflate it.
+    bool FitShieldProfile(const std::vector<Vec3>& points, BladeProfileRecord& rec)
+    {
+        std::vector<float> radial;
+        float minY = 1e30f, maxY = -1e30f, minZ = 1e30f, maxZ = -1e30f;
+        for (const Vec3& p : points)
+        {
+            radial.push_back(std::sqrt(p.x * p.x + p.y * p.y));
+            minY = std::min(minY, p.y);
+            maxY = std::max(maxY, p.y);
+            minZ = std::min(minZ, p.z);
+            maxZ = std::max(maxZ, p.z);
+        }
+        size_t index = radial.size() * 9 / 10;
+        std::nth_element(radial.begin(), radial.begin() + index, radial.end());
+
+        rec = BladeProfileRecord{};
+        rec.weaponType = kWeaponType_Shield;
+        rec.flags = kBladeProfile_HasHead;
+        rec.length = maxY;
+        rec.baseOffset = minY;
+        rec.halfThickness = (maxZ - minZ) * 0.5f;
+        rec.headRadius = radial[index];
+        return std::isfinite(rec.headRadius) && rec.headRadius > 1.0f;
+    }
+
+    bool FitProfile(const std::vector<Vec3>& points, uint8_t weaponType, BladeProfileRecord& rec)
+    {
+        static const int kSlices = 48;
+
+        if (weaponType == kWeaponType_Shield)
+            return FitShieldProfile(points, rec);
+
+        float minY = 1e30f, maxY = -1e30f;
+        for (const Vec3& p : points)
+        {
+            minY = std::min(minY, p.y);
+            maxY = std::max(maxY, p.y);
+        }
+        if (maxY < 1.0f)
+            return false;
+
+        struct Slice
+        {
+            float minX = 1e30f, maxX = -1e30f, minZ = 1e30f, maxZ = -1e30f, maxRadial = 0.0f;
+            int count = 0;
+        };
+        Slice slices[kSlices];
+        float sliceHeight = maxY / kSlices;
+
+        for (const Vec3& p : points)
+        {
+            if (p.y < 0.0f)
+                continue;
+            int s = std::min(kSlices - 1, (int)(p.y / sliceHeight));
+            Slice& slice = slices[s];
+            slice.minX = std::min(slice.minX, p.x);
+            slice.maxX = std::max(slice.maxX, p.x);
+            slice.minZ = std::min(slice.minZ, p.z);
+            slice.maxZ = std::max(slice.maxZ, p.z);
+            slice.maxRadial = std::max(slice.maxRadial, std::sqrt(p.x * p.x + p.z * p.z));
+            slice.count++;
+        }
+
+        auto sliceRange = [&](float from, float to, auto fn) {
+            for (int s = (int)(from * kSlices); s < (int)(to * kSlices) && s < kSlices; s++)
+            {
+                if (slices[s].count > 0)
+                    fn(s, slices[s]);
+            }
+        };
+
+        // Cross-section of the blade body: wider axis = edge, narrower = thickness
+        std::vector<float> halfX, halfZ;
+        sliceRange(0.3f, 0.95f, [&](int, const Slice& slice) {
+            halfX.push_back((slice.maxX - slice.minX) * 0.5f);
+            halfZ.push_back((slice.maxZ - slice.minZ) * 0.5f);
+        });
+        float medianX = Median(halfX);
+        float medianZ = Median(halfZ);
+
+        rec.weaponType = weaponType;
+        rec.flags = 0;
+        rec.length = maxY;
+        rec.baseOffset = minY;
+        rec.edgeHalfWidth = std::max(medianX, medianZ);
+        rec.halfThickness = std::min(medianX, medianZ);
+        rec.bladeStart = 0.0f;
+        rec.headRadius = 0.0f;
+        rec.headCenterY = 0.0f;
+        rec.curvature = 0.0f;
+
+        // Guard: a slice near the grip much wider than the blade
+        int guardSlice = -1;
+        float guardWidth = 0.0f;
+        sliceRange(0.0f, 0.35f, [&](int s, const Slice& slice) {
+            float width = std::max(slice.maxX - slice.minX, slice.maxZ - slice.minZ) * 0.5f;
+            if (width > guardWidth)
+            {
+                guardWidth = width;
+                guardSlice = s;
+            }
+        });
+        if (guardSlice >= 0 && rec.edgeHalfWidth > 0.0f && guardWidth > 2.0f * rec.edgeHalfWidth)
+        {
+            rec.flags |= kBladeProfile_HasGuard;
+            rec.bladeStart = (guardSlice + 1) * sliceHeight;
+        }
+
+        // Head: maces and axes are a thin handle with a wide top
+        if (weaponType == kWeaponType_Mace || weaponType == kWeaponType_Axe)
+        {
+            std::vector<float> handle;
+            sliceRange(0.2f, 0.55f, [&](int, const Slice& slice) { handle.push_back(slice.maxRadial); });
+            float handleRadius = Median(handle);
+
+            int headSlice = -1;
+            float headRadius = 0.0f;
+            sliceRange(0.55f, 1.0f, [&](int s, const Slice& slice) {
+                if (slice.maxRadial > headRadius)
+                {
+                    headRadius = slice.maxRadial;
+                    headSlice = s;
+                }
+            });
+            if (headSlice >= 0 && headRadius > 3.0f && headRadius > 2.5f * handleRadius)
+            {
+                rec.flags |= kBladeProfile_HasHead;
+                rec.headRadius = headRadius;
+                rec.headCenterY = (headSlice + 0.5f) * sliceHeight;
+            }
+        }
+
+        // Curvature: farthest slice centre from the line through the first and last blade slice centres
+        std::vector<Vec3> centres;
+        sliceRange(rec.bladeStart / maxY, 1.0f, [&](int s, const Slice& slice) {
+            Vec3 c;
+            c.x = (slice.minX + slice.maxX) * 0.5f;
+            c.y = (s + 0.5f) * sliceHeight;
+            c.z = (slice.minZ + slice.maxZ) * 0.5f;
+            centres.push_back(c);
+        });
+        if (centres.size() >= 3)
+        {
+            const Vec3& a = centres.front();
+            const Vec3& b = centres.back();
+            Vec3 ab{ b.x - a.x, b.y - a.y, b.z - a.z };
+            float abLenSq = ab.x * ab.x + ab.y * ab.y + ab.z * ab.z;
+            for (const Vec3& c : centres)
+            {
+                Vec3 ac{ c.x - a.x, c.y - a.y, c.z - a.z };
+                float t = abLenSq > 0.0f ? (ac.x * ab.x + ac.y * ab.y + ac.z * ab.z) / abLenSq : 0.0f;
+                Vec3 d{ ac.x - ab.x * t, ac.y - ab.y * t, ac.z - ab.z * t };
+                rec.curvature = std::max(rec.curvature, std::sqrt(d.x * d.x + d.y * d.y + d.z * d.z));
+            }
+        }
+
+        if (!std::isfinite(rec.length) || !std::isfinite(rec.edgeHalfWidth) || !std::isfinite(rec.curvature))
+            return false;
+        return true;
+    }
+
+    // ============================================
+    // Collision mesh
+    // ============================================
+    // Vertices are welded on a kWeldCell grid and degenerate triangles dropped:
+    // the plugin only needs the surface to a fraction of a unit, and welding
+    // merges the copies exporters make along UV seams and hard edges.
+    struct CollisionMesh
+    {
+        std::vector<float> vertices;        // xyz per vertex
+        std::vector<uint16_t> triangles;    // 3 per triangle
+    };
+
+    bool BuildCollisionMesh(const MeshResult& mesh, CollisionMesh& out)
+    {
+        static const float kWeldCell = 0.25f;
+
+        std::unordered_map<uint64_t, uint16_t> welded;
+        std::vector<uint16_t> remap(mesh.points.size());
+        for (size_t i = 0; i < mesh.points.size(); i++)
+        {
+            const Vec3& p = mesh.points[i];
+            uint64_t key = 0;
+            for (float c : { p.x, p.y, p.z })
+                key = (key << 21) | ((uint64_t)((int64_t)std::lround(c / kWeldCell) + (1 << 20)) & 0x1FFFFF);
+
+            auto it = welded.find(key);
+            if (it == welded.end())
+            {
+                if (welded.size() >= 0xFFFF)
+                    return false;
+                it = welded.insert({ key, (uint16_t)welded.size() }).first;
+                out.vertices.push_back(p.x);
+                out.vertices.push_back(p.y);
+                out.vertices.push_back(p.z);
+            }
+            remap[i] = it->second;
+        }
+
+        for (size_t i = 0; i + 2 < mesh.triangles.size(); i += 3)
+        {
+            uint16_t a = remap[mesh.triangles[i]], b = remap[mesh.triangles[i + 1]], c = remap[mesh.triangles[i + 2]];
+            if (a != b && b != c && a != c)
+            {
+                out.triangles.push_back(a);
+                out.triangles.push_back(b);
+                out.triangles.push_back(c);
+            }
+        }
+        return !out.triangles.empty();
+    }
+
+    // ============================================
+    // Signed distance field
+    // ============================================
+    // kSdfResolution^3 samples on a cube around the welded mesh, padded by
+    // kSdfPadding voxels so a blade approaching from outside the bounds still
+    // reads a distance. Shield meshes are small (a few thousand triangles), so
+    // each sample scans every triangle, skipping those whose bounding sphere is
+    // farther than the best hit so far. The sign is taken from the nearest
+    // face's normal - good on the closed shield shells, approximate next to
+    // sharp edges, where the magnitude is still right.
+    static const uint32_t kSdfResolution = 32;
+    static const int kSdfPadding = 2;
+
+    Vec3 Sub(const Vec3& a, const Vec3& b) { return Vec3{ a.x - b.x, a.y - b.y, a.z - b.z }; }
+    Vec3 Add(const Vec3& a, const Vec3& b) { return Vec3{ a.x + b.x, a.y + b.y, a.z + b.z }; }
+    Vec3 Scale(const Vec3& a, float s) { return Vec3{ a.x * s, a.y * s, a.z * s }; }
+    float Dot(const Vec3& a, const Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    Vec3 Cross(const Vec3& a, const Vec3& b) { return Vec3{ a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+
+    // Closest point on triangle abc to p (Ericson, Real-Time Collision Detection 5.1.5)
+    Vec3 ClosestPointOnTriangle(const Vec3& p, const Vec3& a, const Vec3& b, const Vec3& c)
+    {
+        Vec3 ab = Sub(b, a), ac = Sub(c, a), ap = Sub(p, a);
+        float d1 = Dot(ab, ap), d2 = Dot(ac, ap);
+        if (d1 <= 0.0f && d2 <= 0.0f)
+            return a;
+
+        Vec3 bp = Sub(p, b);
+        float d3 = Dot(ab, bp), d4 = Dot(ac, bp);
+        if (d3 >= 0.0f && d4 <= d3)
+            return b;
+
+        float vc = d1 * d4 - d3 * d2;
+        if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+            return Add(a, Scale(ab, d1 / (d1 - d3)));
+
+        Vec3 cp = Sub(p, c);
+        float d5 = Dot(ab, cp), d6 = Dot(ac, cp);
+        if (d6 >= 0.0f && d5 <= d6)
+            return c;
+
+        float vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+            return Add(a, Scale(ac, d2 / (d2 - d6)));
+
+        float va = d3 * d6 - d5 * d4;
+        if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+            return Add(b, Scale(Sub(c, b), (d4 - d3) / ((d4 - d3) + (d5 - d6))));
+
+        float denom = 1.0f / (va + vb + vc);
+        return Add(a, Add(Scale(ab, vb * denom), Scale(ac, vc * denom)));
+    }
+
+    struct DistanceField
+    {
+        BladeProfileSdf header{};
+        std::vector<int16_t> samples;
+    };
+
+    bool BuildDistanceField(const CollisionMesh& mesh, DistanceField& out)
+    {
+        struct Triangle
+        {
+            Vec3 a, b, c, normal, center;
+            float radius;
+        };
+        std::vector<Triangle> triangles;
+        Vec3 boundsMin{ 1e30f, 1e30f, 1e30f }, boundsMax{ -1e30f, -1e30f, -1e30f };
+        auto vertex = [&](uint16_t i) { return Vec3{ mesh.vertices[i * 3], mesh.vertices[i * 3 + 1], mesh.vertices[i * 3 + 2] }; };
+        for (size_t i = 0; i + 2 < mesh.triangles.size(); i += 3)
+        {
+            Triangle t;
+            t.a = vertex(mesh.triangles[i]);
+            t.b = vertex(mesh.triangles[i + 1]);
+            t.c = vertex(mesh.triangles[i + 2]);
+            Vec3 n = Cross(Sub(t.b, t.a), Sub(t.c, t.a));
+            float length = std::sqrt(Dot(n, n));
+            t.normal = length > 1e-12f ? Scale(n, 1.0f / length) : Vec3{};
+            t.center = Scale(Add(t.a, Add(t.b, t.c)), 1.0f / 3.0f);
+            t.radius = 0.0f;
+            for (const Vec3* v : { &t.a, &t.b, &t.c })
+            {
+                Vec3 d = Sub(*v, t.center);
+                t.radius = std::max(t.radius, std::sqrt(Dot(d, d)));
+                boundsMin = Vec3{ std::min(boundsMin.x, v->x), std::min(boundsMin.y, v->y), std::min(boundsMin.z, v->z) };
+                boundsMax = Vec3{ std::max(boundsMax.x, v->x), std::max(boundsMax.y, v->y), std::max(boundsMax.z, v->z) };
+            }
+            triangles.push_back(t);
+        }
+        if (triangles.empty())
+            return false;
+
+        // Cubic voxels: the longest side plus padding spans the grid
+        float extent = std::max(boundsMax.x - boundsMin.x, std::max(boundsMax.y - boundsMin.y, boundsMax.z - boundsMin.z));
+        float voxelSize = extent / (kSdfResolution - 1 - 2 * kSdfPadding);
+        if (!(voxelSize > 1e-4f))
+            return false;
+        Vec3 center = Scale(Add(boundsMin, boundsMax), 0.5f);
+        float halfSpan = voxelSize * (kSdfResolution - 1) * 0.5f;
+
+        out.header.origin[0] = center.x - halfSpan;
+        out.header.origin[1] = center.y - halfSpan;
+        out.header.origin[2] = center.z - halfSpan;
+        out.header.voxelSize = voxelSize;
+        // int16 covers +-128 voxels, well past the padded cube's diagonal
+        out.header.distanceScale = voxelSize / 256.0f;
+        out.header.resolution = kSdfResolution;
+        out.samples.resize((size_t)kSdfResolution * kSdfResolution * kSdfResolution);
+
+        size_t index = 0;
+        for (uint32_t k = 0; k < kSdfResolution; k++)
+        {
+            for (uint32_t j = 0; j < kSdfResolution; j++)
+            {
+                for (uint32_t i = 0; i < kSdfResolution; i++, index++)
+                {
+                    Vec3 p{ out.header.origin[0] + i * voxelSize, out.header.origin[1] + j * voxelSize, out.header.origin[2] + k * voxelSize };
+                    float bestSq = 1e30f, best = 1e15f;
+                    float sign = 1.0f;
+                    for (const Triangle& t : triangles)
+                    {
+                        Vec3 toCenter = Sub(p, t.center);
+                        float centerDistance = std::sqrt(Dot(toCenter, toCenter)) - t.radius;
+                        if (centerDistance > best)
+                            continue;
+                        Vec3 closest = ClosestPointOnTriangle(p, t.a, t.b, t.c);
+                        Vec3 d = Sub(p, closest);
+                        float distanceSq = Dot(d, d);
+                        if (distanceSq < bestSq)
+                        {
+                            bestSq = distanceSq;
+                            best = std::sqrt(distanceSq);
+                            sign = Dot(d, t.normal) < 0.0f ? -1.0f : 1.0f;
+                        }
+                    }
+                    float quantized = std::round(sign * best / out.header.distanceScale);
+                    out.samples[index] = (int16_t)std::max(-32767.0f, std::min(32767.0f, quantized));
+                }
+            }
+        }
+        return true;
+    }
+
+    // ============================================
+    // Minimal perfect hash (hash and displace)
+    // ============================================
+    // Keys are split into ~n/4 buckets; buckets are placed largest first, each
+    // searching for the first seed that sends all of its keys to free slots.
+    bool BuildPerfectHash(const std::vector<uint64_t>& keys, std::vector<uint32_t>& seeds, std::vector<uint32_t>& slotOfKey)
+    {
+        const uint32_t kMaxSeed = 1u << 24;
+
+        uint32_t n = (uint32_t)keys.size();
+        uint32_t bucketCount = std::max(1u, (n + 3) / 4);
+        seeds.assign(bucketCount, 0);
+        slotOfKey.assign(n, 0);
+        if (n == 0)
+            return true;
+
+        std::vector<std::vector<uint32_t>> buckets(bucketCount);
+        for (uint32_t i = 0; i < n; i++)
+            buckets[BladeProfileHash(keys[i], 0) % bucketCount].push_back(i);
+
+        std::vector<uint32_t> order(bucketCount);
+        for (uint32_t b = 0; b < bucketCount; b++)
+            order[b] = b;
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return buckets[a].size() > buckets[b].size(); });
+
+        std::vector<bool> taken(n, false);
+        std::vector<uint32_t> slots;
+        for (uint32_t b : order)
+        {
+            const std::vector<uint32_t>& bucket = buckets[b];
+            if (bucket.empty())
+                break;
+
+            bool placed = false;
+            for (uint32_t seed = 1; seed < kMaxSeed && !placed; seed++)
+            {
+                slots.clear();
+                placed = true;
+                for (uint32_t key : bucket)
+                {
+                    uint32_t slot = BladeProfileHash(keys[key], seed) % n;
+                    if (taken[slot] || std::find(slots.begin(), slots.end(), slot) != slots.end())
+                    {
+                        placed = false;
+                        break;
+                    }
+                    slots.push_back(slot);
+                }
+                if (placed)
+                {
+                    seeds[b] = seed;
+                    for (size_t i = 0; i < bucket.size(); i++)
+                    {
+                        taken[slots[i]] = true;
+                        slotOfKey[bucket[i]] = slots[i];
+                    }
+                }
+            }
+            if (!placed)
+                return false;
+        }
+        return true;
+    }
+
+    double Seconds(std::chrono::steady_clock::time_point since)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - since).count();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string dataArg, outputArg, loadOrderArg;
+    unsigned threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc)
+            threadCount = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--load-order" && i + 1 < argc)
+            loadOrderArg = argv[++i];
+        else if (dataArg.empty())
+            dataArg = arg;
+        else if (outputArg.empty())
+            outputArg = arg;
+        else
+        {
+            std::fprintf(stderr, "Unexpected argument: %s\n", arg.c_str());
+            return 1;
+        }
+    }
+
+    if (dataArg.empty())
+    {
+        std::fprintf(stderr, "Usage: NifProfiler <Data dir> [output] [--threads N] [--load-order plugins.txt]\n");
+        return 1;
+    }
+
+    fs::path dataDir(dataArg);
+    fs::path output = outputArg.empty() ? dataDir / "SKSE" / "Plugins" / "FalseEdgeVR_BladeProfiles.bin" : fs::path(outputArg);
+    if (!fs::is_directory(dataDir))
+    {
+        std::fprintf(stderr, "Not a directory: %s\n", dataArg.c_str());
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    // 1) Plugins -> WEAP forms
+    std::vector<Plugin> plugins = FindPlugins(dataDir, loadOrderArg);
+    ParallelFor(plugins.size(), threadCount, [&](size_t i) { ParsePlugin(plugins[i]); });
+
+    std::unordered_map<std::string, bool> lightByName;
+    size_t formCount = 0, failedPlugins = 0, compressedSkipped = 0;
+    for (const Plugin& plugin : plugins)
+    {
+        lightByName[ToLower(plugin.name)] = plugin.light;
+        formCount += plugin.weapons.size();
+        compressedSkipped += plugin.compressedSkipped;
+        if (!plugin.parsed)
+        {
+            failedPlugins++;
+            std::fprintf(stderr, "  Could not parse %s\n", plugin.name.c_str());
+        }
+    }
+    std::printf("Plugins: %zu (%zu failed), %zu weapon/shield records, %zu compressed skipped - %.2fs\n",
+        plugins.size(), failedPlugins, formCount, compressedSkipped, Seconds(start));
+
+    // Later plugins override earlier ones - keep the last record per form
+    struct FormKey
+    {
+        uint32_t pluginHash;
+        uint32_t localFormID;
+        bool operator==(const FormKey& o) const { return pluginHash == o.pluginHash && localFormID == o.localFormID; }
+    };
+    struct FormKeyHash
+    {
+        size_t operator()(const FormKey& k) const { return ((size_t)k.pluginHash << 32) ^ k.localFormID; }
+    };
+    std::unordered_map<FormKey, const WeaponForm*, FormKeyHash> forms;
+    size_t overrides = 0;
+    for (const Plugin& plugin : plugins)
+    {
+        for (const WeaponForm& form : plugin.weapons)
+        {
+            bool ownerLight = lightByName[ToLower(form.owner)];
+            FormKey key{ BladeProfilePluginHash(form.owner.c_str()), form.formID & (ownerLight ? 0xFFFu : 0xFFFFFFu) };
+            auto inserted = forms.insert({ key, &form });
+            if (!inserted.second)
+            {
+                inserted.first->second = &form;
+                overrides++;
+            }
+        }
+    }
+
+    // 2) Loose mesh index (paths are case-insensitive in the game)
+    auto indexStart = std::chrono::steady_clock::now();
+    std::unordered_map<std::string, fs::path> looseMeshes;
+    fs::path meshDir = dataDir / "meshes";
+    for (const auto& entry : fs::directory_iterator(dataDir))
+    {
+        if (entry.is_directory() && ToLower(entry.path().filename().string()) == "meshes")
+            meshDir = entry.path();
+    }
+    if (fs::is_directory(meshDir))
+    {
+        for (const auto& entry : fs::recursive_directory_iterator(meshDir, fs::directory_options::skip_permission_denied))
+        {
+            if (!entry.is_regular_file() || ToLower(entry.path().extension().string()) != ".nif")
+                continue;
+            std::string relative = ToLower(fs::relative(entry.path(), meshDir).generic_string());
+            looseMeshes["meshes/" + relative] = entry.path();
+        }
+    }
+    std::printf("Loose meshes: %zu NIF files indexed - %.2fs\n", looseMeshes.size(), Seconds(indexStart));
+
+    // 3) Unique (mesh, type) pairs -> profiles, in parallel
+    struct MeshJob
+    {
+        std::string path;
+        uint8_t weaponType;
+    };
+    std::vector<MeshJob> meshJobs;
+    std::unordered_map<std::string, size_t> meshIndex;
+    auto meshKey = [](const WeaponForm* form) { return form->modelPath + "|" + std::to_string(form->weaponType); };
+    for (const auto& entry : forms)
+    {
+        const WeaponForm* form = entry.second;
+        if (meshIndex.insert({ meshKey(form), meshJobs.size() }).second)
+            meshJobs.push_back({ form->modelPath, form->weaponType });
+    }
+
+    struct MeshProfile
+    {
+        bool found = false;
+        bool ok = false;
+        std::string error;
+        BladeProfileRecord rec{};
+        CollisionMesh collision;
+        bool hasCollision = false;
+        DistanceField field;
+        bool hasField = false;
+    };
+    std::vector<MeshProfile> profiles(meshJobs.size());
+    std::atomic<size_t> parsedCount(0);
+
+    auto meshStart = std::chrono::steady_clock::now();
+    ParallelFor(meshJobs.size(), threadCount, [&](size_t i) {
+        MeshProfile& profile = profiles[i];
+        auto it = looseMeshes.find(meshJobs[i].path);
+        if (it == looseMeshes.end())
+            return;
+
+        profile.found = true;
+        MeshResult mesh = LoadMesh(it->second);
+        parsedCount.fetch_add(1);
+        if (!mesh.error.empty())
+        {
+            profile.error = mesh.error;
+            return;
+        }
+        profile.ok = FitProfile(mesh.points, meshJobs[i].weaponType, profile.rec);
+        if (!profile.ok)
+            profile.error = "fit failed";
+        else
+        {
+            if (mesh.legacy)
+                profile.rec.flags |= kBladeProfile_LegacyMesh;
+            profile.hasCollision = BuildCollisionMesh(mesh, profile.collision);
+            if (profile.hasCollision && meshJobs[i].weaponType == kWeaponType_Shield)
+                profile.hasField = BuildDistanceField(profile.collision, profile.field);
+        }
+    });
+    double meshSeconds = Seconds(meshStart);
+
+    size_t found = 0, fitted = 0;
+    std::unordered_map<std::string, size_t> errors;
+    for (const MeshProfile& profile : profiles)
+    {
+        found += profile.found ? 1 : 0;
+        fitted += profile.ok ? 1 : 0;
+        if (profile.found && !profile.ok)
+            errors[profile.error]++;
+    }
+    std::printf("Meshes: %zu referenced, %zu loose, %zu missing (packed in a BSA?), %zu fitted - %.2fs, %.0f meshes/s on %u threads\n",
+        meshJobs.size(), found, meshJobs.size() - found, fitted, meshSeconds,
+        meshSeconds > 0.0 ? parsedCount.load() / meshSeconds : 0.0, threadCount);
+    for (const auto& error : errors)
+        std::printf("  %zu x %s\n", error.second, error.first.c_str());
+
+    // 4) Collision meshes, one per fitted mesh job
+    std::vector<BladeProfileMesh> meshes;
+    std::vector<uint32_t> meshOfJob(profiles.size(), kBladeProfileNoMesh);
+    uint32_t vertexTotal = 0, triangleTotal = 0;
+    for (size_t i = 0; i < profiles.size(); i++)
+    {
+        if (!profiles[i].ok || !profiles[i].hasCollision)
+            continue;
+        const CollisionMesh& collision = profiles[i].collision;
+        BladeProfileMesh mesh{ vertexTotal, (uint32_t)collision.vertices.size() / 3, triangleTotal, (uint32_t)collision.triangles.size() / 3 };
+        meshOfJob[i] = (uint32_t)meshes.size();
+        meshes.push_back(mesh);
+        vertexTotal += mesh.vertexCount;
+        triangleTotal += mesh.triangleCount;
+    }
+    std::printf("Collision meshes: %zu, %u vertices, %u triangles (%.1f MB)\n", meshes.size(), vertexTotal, triangleTotal,
+        (vertexTotal * 12.0 + triangleTotal * 6.0) / (1024.0 * 1024.0));
+
+    // 4b) Distance fields (shields)
+    std::vector<BladeProfileSdf> fields;
+    std::vector<uint32_t> fieldOfJob(profiles.size(), kBladeProfileNoMesh);
+    uint32_t sampleTotal = 0;
+    for (size_t i = 0; i < profiles.size(); i++)
+    {
+        if (!profiles[i].ok || !profiles[i].hasField)
+            continue;
+        BladeProfileSdf field = profiles[i].field.header;
+        field.firstSample = sampleTotal;
+        fieldOfJob[i] = (uint32_t)fields.size();
+        fields.push_back(field);
+        sampleTotal += (uint32_t)profiles[i].field.samples.size();
+    }
+    std::printf("Distance fields: %zu at %u^3 (%.1f KB each, %.1f MB)\n", fields.size(), kSdfResolution,
+        kSdfResolution * kSdfResolution * kSdfResolution * sizeof(int16_t) / 1024.0,
+        (fields.size() * sizeof(BladeProfileSdf) + sampleTotal * sizeof(int16_t)) / (1024.0 * 1024.0));
+
+    // 5) Records placed by the perfect hash
+    std::vector<BladeProfileRecord> records;
+    for (const auto& entry : forms)
+    {
+        size_t job = meshIndex[meshKey(entry.second)];
+        const MeshProfile& profile = profiles[job];
+        if (!profile.ok)
+            continue;
+        BladeProfileRecord rec = profile.rec;
+        rec.pluginHash = entry.first.pluginHash;
+        rec.localFormID = entry.first.localFormID;
+        rec.meshIndex = meshOfJob[job];
+        rec.sdfIndex = fieldOfJob[job];
+        records.push_back(rec);
+    }
+
+    auto hashStart = std::chrono::steady_clock::now();
+    std::vector<uint64_t> keys;
+    for (const BladeProfileRecord& rec : records)
+        keys.push_back(BladeProfileKey(rec.pluginHash, rec.localFormID));
+
+    std::vector<uint32_t> seeds, slotOfKey;
+    if (!BuildPerfectHash(keys, seeds, slotOfKey))
+    {
+        std::fprintf(stderr, "Could not build the perfect hash for %zu records\n", records.size());
+        return 1;
+    }
+    std::vector<BladeProfileRecord> placed(records.size());
+    for (size_t i = 0; i < records.size(); i++)
+        placed[slotOfKey[i]] = records[i];
+    std::printf("Perfect hash: %zu buckets for %zu records - %.2fs\n", seeds.size(), records.size(), Seconds(hashStart));
+
+    std::error_code ec;
+    fs::create_directories(output.parent_path(), ec);
+    std::ofstream out(output, std::ios::binary | std::ios::trunc);
+    BladeProfileHeader header{ kBladeProfileMagic, kBladeProfileVersion, (uint32_t)placed.size(), (uint32_t)seeds.size(),
+        (uint32_t)meshes.size(), vertexTotal, triangleTotal, (uint32_t)fields.size(), sampleTotal, 0 };
+    out.write((const char*)&header, sizeof(header));
+    out.write((const char*)seeds.data(), seeds.size() * sizeof(uint32_t));
+    out.write((const char*)placed.data(), placed.size() * sizeof(BladeProfileRecord));
+    out.write((const char*)meshes.data(), meshes.size() * sizeof(BladeProfileMesh));
+    for (size_t i = 0; i < profiles.size(); i++)
+    {
+        if (meshOfJob[i] != kBladeProfileNoMesh)
+            out.write((const char*)profiles[i].collision.vertices.data(), profiles[i].collision.vertices.size() * sizeof(float));
+    }
+    for (size_t i = 0; i < profiles.size(); i++)
+    {
+        if (meshOfJob[i] != kBladeProfileNoMesh)
+            out.write((const char*)profiles[i].collision.triangles.data(), profiles[i].collision.triangles.size() * sizeof(uint16_t));
+    }
+    static const char kPadding[4] = {};
+    uint64_t triangleBytes = (uint64_t)triangleTotal * 3 * sizeof(uint16_t);
+    out.write(kPadding, BladeProfileAlign4(triangleBytes) - triangleBytes);
+    out.write((const char*)fields.data(), fields.size() * sizeof(BladeProfileSdf));
+    for (size_t i = 0; i < profiles.size(); i++)
+    {
+        if (fieldOfJob[i] != kBladeProfileNoMesh)
+            out.write((const char*)profiles[i].field.samples.data(), profiles[i].field.samples.size() * sizeof(int16_t));
+    }
+    if (!out)
+    {
+        std::fprintf(stderr, "Could not write %s\n", output.string().c_str());
+        return 1;
+    }
+
+    std::printf("Wrote %zu profiles (%zu overridden records) to %s - %.2fs total\n",
+        records.size(), overrides, output.string().c_str(), Seconds(start));
+    return 0;
+}